@@ -0,0 +1,589 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: ContractionHierarchy.cpp                                                    *
+ *                                                                                     *
+ *   Desc: implementation file for a contraction hierarchy                             *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *   Functions:                                                                        *
+ *      build(int, int*, int*, int*, int*)  ..  contracts the graph                    *
+ *      clear()  ..............................  drops the hierarchy                   *
+ *      findWitnesses(int, int, int)  .........  searches around a vertex              *
+ *      clearWitnesses()  .....................  resets the witness search             *
+ *      contractVertex(int, bool)  ............  adds the shortcuts for a vertex       *
+ *      computeImportance(int, vector<int>)  ..  ranks a vertex for contraction        *
+ *      addShortcut(int, ContractionEdge)  ....  adds or lowers a shortcut             *
+ *      appendUnpackedEdge(int, int, vector)  .  expands a shortcut into its path      *
+ *      query(int, int, int, vector, int)  ....  finds a shortest path                 *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include "ContractionHierarchy.h"
+#include<algorithm>
+#include<queue>
+#include<utility>
+#include<functional>
+
+/*-------------------------------------------------------------------------------------*
+ *   constants                                                                         *
+ *-------------------------------------------------------------------------------------*/
+const int WITNESS_SETTLE_LIMIT = 200;          // a witness search gives up after settling this many vertices and keeps the shortcut
+const int SIMULATED_WITNESS_SETTLE_LIMIT = 30; // the same limit when only pricing a vertex, which needs an estimate and runs far more often
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function implementations                                                          *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: build(int, int*, int*, int*, int*)                                 *
+ *                                                                                     *
+ *   description: contracts every vertex, least important first (see                   *
+ *                computeImportance). contracting a vertex only bumps its neighbors'   *
+ *                importances for the contracted neighbor; the rest goes stale, so the *
+ *                vertex at the front is priced again before it is contracted and put  *
+ *                back if it is no longer the least important. once a vertex is        *
+ *                contracted its remaining edges all lead to vertices of higher rank   *
+ *                and become its part of the upward and downward graphs. parallel      *
+ *                edges keep only the cheapest and self loops are dropped, since       *
+ *                neither can be on a shortest path.                                   *
+ *                                                                                     *
+ *   returns: true if the hierarchy was built. false if the graph has no vertices or a *
+ *            negative cost                                                            *
+ *-------------------------------------------------------------------------------------*/
+bool ContractionHierarchy::build(int numVerticesValue, const int* edgeBegins, const int* edgeEnds, const int* edgeTargets,
+    const int* edgeCosts) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the vertices left to contract, keyed by (importance, vertex). entries whose importance
+    // no longer matches importances are stale and skipped
+    std::priority_queue< std::pair<int, int>, std::vector< std::pair<int, int> >, std::greater< std::pair<int, int> > > contractionQueue;
+
+    // the importance each vertex was last queued with
+    std::vector<int> importances;
+
+    // the number of neighbors of each vertex that are already contracted
+    std::vector<int> numContractedNeighbors;
+
+    // the edges each contracted vertex keeps in the upward and downward graphs
+    std::vector< std::vector<ContractionEdge> > upwardEdges;
+    std::vector< std::vector<ContractionEdge> > downwardEdges;
+
+    // the neighbors of the vertex just contracted
+    std::vector<int> neighbors;
+
+    // the rank the next vertex contracted gets
+    int nextRank = 0;
+
+    // the number of edges in the upward graph, which come before the downward edges in the edge numbering
+    int numUpwardEdges;
+
+    /*-------------------------------------------------------------------------------------*
+     *   copy the graph, one edge per pair of vertices                                     *
+     *-------------------------------------------------------------------------------------*/
+    clear();
+    for (int curIndex = 0; curIndex < numVerticesValue; curIndex++) {
+        for (int edge = edgeBegins[curIndex]; edge < edgeEnds[curIndex]; edge++) {
+            if (edgeCosts[edge] < 0) {
+                return false;
+            }
+        }
+    }
+    if (numVerticesValue == 0) {
+        return false;
+    }
+
+    remainingOutEdges.assign(numVerticesValue, std::vector<ContractionEdge>());
+    remainingInEdges.assign(numVerticesValue, std::vector<ContractionEdge>());
+    for (int curIndex = 0; curIndex < numVerticesValue; curIndex++) {
+        std::vector<ContractionEdge>& outEdges = remainingOutEdges[curIndex];
+        for (int edge = edgeBegins[curIndex]; edge < edgeEnds[curIndex]; edge++) {
+            if (edgeTargets[edge] != curIndex) {
+                outEdges.push_back(ContractionEdge(edgeTargets[edge], edgeCosts[edge]));
+            }
+        }
+
+        // sort by target and then cost so the cheapest of each group of parallel edges comes first
+        std::sort(outEdges.begin(), outEdges.end(), [](const ContractionEdge& lhs, const ContractionEdge& rhs) {
+            return (lhs.otherVertex != rhs.otherVertex) ? lhs.otherVertex < rhs.otherVertex : lhs.cost < rhs.cost;
+        });
+        outEdges.erase(std::unique(outEdges.begin(), outEdges.end(), [](const ContractionEdge& lhs, const ContractionEdge& rhs) {
+            return lhs.otherVertex == rhs.otherVertex;
+        }), outEdges.end());
+
+        for (const ContractionEdge& outEdge : outEdges) {
+            remainingInEdges[outEdge.otherVertex].push_back(ContractionEdge(curIndex, outEdge.cost));
+        }
+    }
+
+    witnessDistances.assign(numVerticesValue, INT_MAX);
+    witnessReached.clear();
+    witnessHeap.reset(numVerticesValue);
+
+    /*-------------------------------------------------------------------------------------*
+     *   contract the vertices, least important first                                      *
+     *-------------------------------------------------------------------------------------*/
+    ranks.assign(numVerticesValue, -1);
+    importances.assign(numVerticesValue, 0);
+    numContractedNeighbors.assign(numVerticesValue, 0);
+    upwardEdges.assign(numVerticesValue, std::vector<ContractionEdge>());
+    downwardEdges.assign(numVerticesValue, std::vector<ContractionEdge>());
+
+    for (int curIndex = 0; curIndex < numVerticesValue; curIndex++) {
+        importances[curIndex] = computeImportance(curIndex, numContractedNeighbors);
+        contractionQueue.push(std::make_pair(importances[curIndex], curIndex));
+    }
+
+    while (!contractionQueue.empty()) {
+
+        int vertex = contractionQueue.top().second;
+        int queuedImportance = contractionQueue.top().first;
+        contractionQueue.pop();
+        if (ranks[vertex] != -1 || queuedImportance != importances[vertex]) {
+            continue;
+        }
+
+        // put the vertex back if its importance has grown past the next one's
+        importances[vertex] = computeImportance(vertex, numContractedNeighbors);
+        if (!contractionQueue.empty() && importances[vertex] > contractionQueue.top().first) {
+            contractionQueue.push(std::make_pair(importances[vertex], vertex));
+            continue;
+        }
+
+        // contract it, keeping its edges as its part of the hierarchy
+        ranks[vertex] = nextRank++;
+        contractVertex(vertex, false);
+        upwardEdges[vertex].swap(remainingOutEdges[vertex]);
+        downwardEdges[vertex].swap(remainingInEdges[vertex]);
+
+        // take it out of its neighbors' edge lists
+        neighbors.clear();
+        for (const ContractionEdge& upwardEdge : upwardEdges[vertex]) {
+            std::vector<ContractionEdge>& inEdges = remainingInEdges[upwardEdge.otherVertex];
+            inEdges.erase(std::find_if(inEdges.begin(), inEdges.end(), [vertex](const ContractionEdge& inEdge) {
+                return inEdge.otherVertex == vertex;
+            }));
+            neighbors.push_back(upwardEdge.otherVertex);
+        }
+        for (const ContractionEdge& downwardEdge : downwardEdges[vertex]) {
+            std::vector<ContractionEdge>& outEdges = remainingOutEdges[downwardEdge.otherVertex];
+            outEdges.erase(std::find_if(outEdges.begin(), outEdges.end(), [vertex](const ContractionEdge& outEdge) {
+                return outEdge.otherVertex == vertex;
+            }));
+            neighbors.push_back(downwardEdge.otherVertex);
+        }
+
+        // each neighbor has one more contracted neighbor. requeue it so its stale entry is skipped
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        for (int neighbor : neighbors) {
+            numContractedNeighbors[neighbor]++;
+            importances[neighbor]++;
+            contractionQueue.push(std::make_pair(importances[neighbor], neighbor));
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   pack the upward and downward graphs into CSR arrays                               *
+     *-------------------------------------------------------------------------------------*/
+    upwardOffsets.assign(numVerticesValue + 1, 0);
+    downwardOffsets.assign(numVerticesValue + 1, 0);
+    for (int curIndex = 0; curIndex < numVerticesValue; curIndex++) {
+        upwardOffsets[curIndex + 1] = upwardOffsets[curIndex] + (int)upwardEdges[curIndex].size();
+        downwardOffsets[curIndex + 1] = downwardOffsets[curIndex] + (int)downwardEdges[curIndex].size();
+    }
+    numUpwardEdges = upwardOffsets[numVerticesValue];
+
+    // a shortcut's halves are numbered from where its middle vertex's edges start
+    for (int direction = 0; direction < 2; direction++) {
+        std::vector< std::vector<ContractionEdge> >& hierarchyEdges = (direction == 0) ? upwardEdges : downwardEdges;
+        std::vector<int>& otherVertices = (direction == 0) ? upwardTargets : downwardSources;
+        std::vector<int>& costs = (direction == 0) ? upwardCosts : downwardCosts;
+
+        for (int curIndex = 0; curIndex < numVerticesValue; curIndex++) {
+            for (const ContractionEdge& hierarchyEdge : hierarchyEdges[curIndex]) {
+                otherVertices.push_back(hierarchyEdge.otherVertex);
+                costs.push_back(hierarchyEdge.cost);
+                edgeMiddles.push_back(hierarchyEdge.middleVertex);
+                if (hierarchyEdge.middleVertex == -1) {
+                    edgeFirstHalves.push_back(-1);
+                    edgeSecondHalves.push_back(-1);
+                }
+                else {
+                    edgeFirstHalves.push_back(numUpwardEdges + downwardOffsets[hierarchyEdge.middleVertex] + hierarchyEdge.firstHalf);
+                    edgeSecondHalves.push_back(upwardOffsets[hierarchyEdge.middleVertex] + hierarchyEdge.secondHalf);
+                    numShortcuts++;
+                }
+            }
+        }
+    }
+
+    // free the working space of the build
+    std::vector< std::vector<ContractionEdge> >().swap(remainingOutEdges);
+    std::vector< std::vector<ContractionEdge> >().swap(remainingInEdges);
+    std::vector<int>().swap(witnessDistances);
+    witnessHeap.reset(0);
+
+    numVertices = numVerticesValue;
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: clear()                                                            *
+ *                                                                                     *
+ *   description: drops the hierarchy, which no longer matches a graph that changed    *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void ContractionHierarchy::clear() {
+
+    numVertices = 0;
+    numShortcuts = 0;
+    ranks.clear();
+    upwardOffsets.clear();
+    upwardTargets.clear();
+    upwardCosts.clear();
+    downwardOffsets.clear();
+    downwardSources.clear();
+    downwardCosts.clear();
+    edgeMiddles.clear();
+    edgeFirstHalves.clear();
+    edgeSecondHalves.clear();
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: findWitnesses(int, int, int, int)                                  *
+ *                                                                                     *
+ *   description: runs Dijkstra from sourceVertex over the vertices not contracted     *
+ *                yet, never passing through skippedVertex. it stops once the next     *
+ *                distance is past maxDistance or settleLimit vertices are settled,    *
+ *                and never queues a vertex past maxDistance. every distance it        *
+ *                leaves in witnessDistances is the length of a real path, so a        *
+ *                shortcut it rules out is never needed; giving up early only adds     *
+ *                shortcuts that were not needed.                                      *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void ContractionHierarchy::findWitnesses(int sourceVertex, int skippedVertex, int maxDistance, int settleLimit) {
+
+    // the number of vertices settled so far
+    int numSettled = 0;
+
+    witnessDistances[sourceVertex] = 0;
+    witnessReached.push_back(sourceVertex);
+    witnessHeap.pushOrDecrease(sourceVertex, 0, 0);
+
+    while (!witnessHeap.empty() && witnessHeap.topPriority() <= maxDistance && numSettled < settleLimit) {
+
+        int foundVertex = witnessHeap.pop();
+        numSettled++;
+
+        for (const ContractionEdge& outEdge : remainingOutEdges[foundVertex]) {
+            int newDistance = witnessDistances[foundVertex] + outEdge.cost;
+            if (outEdge.otherVertex != skippedVertex && newDistance <= maxDistance && newDistance < witnessDistances[outEdge.otherVertex]) {
+                if (witnessDistances[outEdge.otherVertex] == INT_MAX) {
+                    witnessReached.push_back(outEdge.otherVertex);
+                }
+                witnessDistances[outEdge.otherVertex] = newDistance;
+                witnessHeap.pushOrDecrease(outEdge.otherVertex, newDistance, 0);
+            }
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: clearWitnesses()                                                   *
+ *                                                                                     *
+ *   description: resets the vertices the last witness search reached                  *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void ContractionHierarchy::clearWitnesses() {
+
+    for (int vertex : witnessReached) {
+        witnessDistances[vertex] = INT_MAX;
+    }
+    witnessReached.clear();
+    witnessHeap.clear();
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: contractVertex(int, bool)                                          *
+ *                                                                                     *
+ *   description: for each edge u -> vertex, searches from u for paths that avoid      *
+ *                vertex. every u -> vertex -> w with no path from u to w at least as  *
+ *                short needs a shortcut u -> w. when simulate is true the shortcuts   *
+ *                are only counted, which is how computeImportance prices a vertex.    *
+ *                                                                                     *
+ *   returns: the number of shortcuts needed                                           *
+ *-------------------------------------------------------------------------------------*/
+int ContractionHierarchy::contractVertex(int vertex, bool simulate) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the edges into and out of the vertex. shortcuts never start or end at the vertex itself,
+    // so these lists do not change while the shortcuts are added
+    const std::vector<ContractionEdge>& inEdges = remainingInEdges[vertex];
+    const std::vector<ContractionEdge>& outEdges = remainingOutEdges[vertex];
+
+    // the number of shortcuts needed
+    int numNeededShortcuts = 0;
+
+    /*-------------------------------------------------------------------------------------*
+     *   look for a witness for every path through the vertex                              *
+     *-------------------------------------------------------------------------------------*/
+    for (int inPosition = 0; inPosition < (int)inEdges.size(); inPosition++) {
+        const ContractionEdge& inEdge = inEdges[inPosition];
+
+        // the longest path through the vertex a witness has to beat
+        int maxDistance = -1;
+        for (const ContractionEdge& outEdge : outEdges) {
+            if (outEdge.otherVertex != inEdge.otherVertex) {
+                maxDistance = std::max(maxDistance, inEdge.cost + outEdge.cost);
+            }
+        }
+        if (maxDistance == -1) {
+            continue;
+        }
+
+        findWitnesses(inEdge.otherVertex, vertex, maxDistance, simulate ? SIMULATED_WITNESS_SETTLE_LIMIT : WITNESS_SETTLE_LIMIT);
+        for (int outPosition = 0; outPosition < (int)outEdges.size(); outPosition++) {
+            const ContractionEdge& outEdge = outEdges[outPosition];
+            int pathCost = inEdge.cost + outEdge.cost;
+            if (outEdge.otherVertex != inEdge.otherVertex && witnessDistances[outEdge.otherVertex] > pathCost) {
+                numNeededShortcuts++;
+                if (!simulate) {
+                    addShortcut(inEdge.otherVertex, ContractionEdge(outEdge.otherVertex, pathCost, vertex, inPosition, outPosition));
+                }
+            }
+        }
+        clearWitnesses();
+    }
+
+    return numNeededShortcuts;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: computeImportance(int, vector<int>)                                *
+ *                                                                                     *
+ *   description: twice the edge difference of vertex, the shortcuts contracting it    *
+ *                would add minus the edges it would remove, plus its contracted       *
+ *                neighbors. a low edge difference keeps the hierarchy small, and      *
+ *                counting contracted neighbors keeps one region from being contracted *
+ *                all at once, which keeps the hierarchy shallow                       *
+ *                                                                                     *
+ *   returns: the importance of vertex                                                 *
+ *-------------------------------------------------------------------------------------*/
+int ContractionHierarchy::computeImportance(int vertex, const std::vector<int>& numContractedNeighbors) {
+
+    // the number of edges contracting the vertex would remove
+    int numRemovedEdges = (int)(remainingInEdges[vertex].size() + remainingOutEdges[vertex].size());
+
+    return 2 * (contractVertex(vertex, true) - numRemovedEdges) + numContractedNeighbors[vertex];
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: addShortcut(int, ContractionEdge)                                  *
+ *                                                                                     *
+ *   description: adds shortcut to fromVertex's out-edges and to its other end's       *
+ *                in-edges, or replaces the edge already between them if the shortcut  *
+ *                is cheaper                                                           *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void ContractionHierarchy::addShortcut(int fromVertex, const ContractionEdge& shortcut) {
+
+    // the same shortcut seen from the vertex it goes to
+    ContractionEdge reversedShortcut(fromVertex, shortcut.cost, shortcut.middleVertex, shortcut.firstHalf, shortcut.secondHalf);
+
+    std::vector<ContractionEdge>& outEdges = remainingOutEdges[fromVertex];
+    std::vector<ContractionEdge>& inEdges = remainingInEdges[shortcut.otherVertex];
+
+    for (ContractionEdge& outEdge : outEdges) {
+        if (outEdge.otherVertex == shortcut.otherVertex) {
+            if (shortcut.cost < outEdge.cost) {
+                outEdge = shortcut;
+                for (ContractionEdge& inEdge : inEdges) {
+                    if (inEdge.otherVertex == fromVertex) {
+                        inEdge = reversedShortcut;
+                        break;
+                    }
+                }
+            }
+            return;
+        }
+    }
+
+    outEdges.push_back(shortcut);
+    inEdges.push_back(reversedShortcut);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: appendUnpackedEdge(int, int, vector<int>)                          *
+ *                                                                                     *
+ *   description: replaces a shortcut with the two edges it was made from, over and    *
+ *                over, until only original edges are left. each edge knows its halves *
+ *                so this takes time in the length of the path alone. a stack of       *
+ *                edges still to expand keeps a deep hierarchy from running out of     *
+ *                call stack.                                                          *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void ContractionHierarchy::appendUnpackedEdge(int edge, int toVertex, std::vector<int>& path) const {
+
+    // the edges still to expand with the vertex each one goes to, the next one on top
+    std::vector< std::pair<int, int> > pendingEdges(1, std::make_pair(edge, toVertex));
+
+    while (!pendingEdges.empty()) {
+        std::pair<int, int> pendingEdge = pendingEdges.back();
+        pendingEdges.pop_back();
+
+        int middleVertex = edgeMiddles[pendingEdge.first];
+        if (middleVertex == -1) {
+            path.push_back(pendingEdge.second);
+        }
+        else {
+            pendingEdges.push_back(std::make_pair(edgeSecondHalves[pendingEdge.first], pendingEdge.second));
+            pendingEdges.push_back(std::make_pair(edgeFirstHalves[pendingEdge.first], middleVertex));
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: query(int, int, int, vector<int>, int)                             *
+ *                                                                                     *
+ *   description: runs Dijkstra upward from the source and, over the downward graph    *
+ *                backward, upward from the target, taking the next vertex from         *
+ *                whichever side's is closer. every shortest path climbs to a highest  *
+ *                vertex and comes back down, so the best vertex settled by both sides *
+ *                is where a shortest path meets. a side stops once its next distance  *
+ *                is no better than the best path found. a vertex reached more cheaply *
+ *                through a higher neighbor is stalled: its distance cannot be on a    *
+ *                shortest path, so its edges are not followed.                        *
+ *                                                                                     *
+ *   returns: true if there is a path. the path's cost and vertices are stored in      *
+ *            totalDistance and pathVertices                                           *
+ *-------------------------------------------------------------------------------------*/
+bool ContractionHierarchy::query(int sourceVertex, int targetVertex, int& totalDistance, std::vector<int>& pathVertices,
+    int& numSettledVertices) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the cost of the best path found and the vertex where its two halves meet
+    int bestDistance = INT_MAX;
+    int meetingVertex = -1;
+
+    // the hierarchy edges along the path, before unpacking, with the vertex each one goes to
+    std::vector< std::pair<int, int> > hierarchyPath;
+
+    // the number of edges in the upward graph, which come before the downward edges in the edge numbering
+    int numUpwardEdges = (int)upwardTargets.size();
+
+    /*-------------------------------------------------------------------------------------*
+     *   search upward from both ends                                                      *
+     *-------------------------------------------------------------------------------------*/
+    totalDistance = INT_MAX;
+    pathVertices.clear();
+    numSettledVertices = 0;
+
+    forwardQuery.prepare(numVertices);
+    backwardQuery.prepare(numVertices);
+    forwardQuery.label(sourceVertex, 0, -1, -1);
+    backwardQuery.label(targetVertex, 0, -1, -1);
+
+    while (true) {
+
+        bool forwardActive = !forwardQuery.heap.empty() && forwardQuery.heap.topPriority() < bestDistance;
+        bool backwardActive = !backwardQuery.heap.empty() && backwardQuery.heap.topPriority() < bestDistance;
+        if (!forwardActive && !backwardActive) {
+            break;
+        }
+
+        bool searchingForward = forwardActive && (!backwardActive || forwardQuery.heap.topPriority() <= backwardQuery.heap.topPriority());
+        QuerySpace& search = searchingForward ? forwardQuery : backwardQuery;
+        QuerySpace& otherSearch = searchingForward ? backwardQuery : forwardQuery;
+
+        int foundVertex = search.heap.pop();
+        int foundDistance = search.distances[foundVertex];
+        numSettledVertices++;
+
+        // a vertex both sides have reached joins a path
+        if (otherSearch.distances[foundVertex] != INT_MAX && foundDistance + otherSearch.distances[foundVertex] < bestDistance) {
+            bestDistance = foundDistance + otherSearch.distances[foundVertex];
+            meetingVertex = foundVertex;
+        }
+
+        // the edges a vertex is stalled by come from above on the side being searched, so they
+        // are the ones the other side follows
+        const std::vector<int>& searchOffsets = searchingForward ? upwardOffsets : downwardOffsets;
+        const std::vector<int>& searchVertices = searchingForward ? upwardTargets : downwardSources;
+        const std::vector<int>& searchCosts = searchingForward ? upwardCosts : downwardCosts;
+        const std::vector<int>& stallOffsets = searchingForward ? downwardOffsets : upwardOffsets;
+        const std::vector<int>& stallVertices = searchingForward ? downwardSources : upwardTargets;
+        const std::vector<int>& stallCosts = searchingForward ? downwardCosts : upwardCosts;
+
+        bool stalled = false;
+        for (int edge = stallOffsets[foundVertex]; edge < stallOffsets[foundVertex + 1] && !stalled; edge++) {
+            int higherVertex = stallVertices[edge];
+            stalled = search.distances[higherVertex] != INT_MAX && search.distances[higherVertex] + stallCosts[edge] < foundDistance;
+        }
+        if (stalled) {
+            continue;
+        }
+
+        for (int edge = searchOffsets[foundVertex]; edge < searchOffsets[foundVertex + 1]; edge++) {
+            int higherVertex = searchVertices[edge];
+            int newDistance = foundDistance + searchCosts[edge];
+            if (newDistance < search.distances[higherVertex]) {
+                search.label(higherVertex, newDistance, foundVertex, searchingForward ? edge : numUpwardEdges + edge);
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   join the two halves and unpack the shortcuts                                      *
+     *-------------------------------------------------------------------------------------*/
+    if (meetingVertex != -1) {
+        for (int vertex = meetingVertex; vertex != sourceVertex; vertex = forwardQuery.nextVertexIndices[vertex]) {
+            hierarchyPath.push_back(std::make_pair(forwardQuery.pathEdges[vertex], vertex));
+        }
+        std::reverse(hierarchyPath.begin(), hierarchyPath.end());
+        for (int vertex = meetingVertex; vertex != targetVertex; vertex = backwardQuery.nextVertexIndices[vertex]) {
+            hierarchyPath.push_back(std::make_pair(backwardQuery.pathEdges[vertex], backwardQuery.nextVertexIndices[vertex]));
+        }
+
+        pathVertices.push_back(sourceVertex);
+        for (const std::pair<int, int>& hierarchyEdge : hierarchyPath) {
+            appendUnpackedEdge(hierarchyEdge.first, hierarchyEdge.second, pathVertices);
+        }
+        totalDistance = bestDistance;
+    }
+
+    forwardQuery.clear();
+    backwardQuery.clear();
+    return meetingVertex != -1;
+}
@@ -0,0 +1,255 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: ContractionHierarchy.h                                                      *
+ *                                                                                     *
+ *   Desc: header file for a contraction hierarchy over a weighted directed graph with *
+ *         non-negative costs. preprocessing contracts the vertices one at a time in   *
+ *         order of importance, adding a shortcut edge wherever removing a vertex     *
+ *         would lengthen a shortest path. a query then only searches upward in the   *
+ *         hierarchy from both ends, which touches a few hundred vertices on           *
+ *         road-like graphs, and unpacks the shortcuts on the path it finds.           *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef CONTRACTION_HIERARCHY_H_
+#define CONTRACTION_HIERARCHY_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<vector>
+#include<climits>
+#include "IndexedHeap.h"
+
+/*-------------------------------------------------------------------------------------*
+ *   class: ContractionHierarchy                                                       *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        build                                                                        *
+ *        clear                                                                        *
+ *        isBuilt                                                                      *
+ *        getNumShortcuts                                                              *
+ *        query                                                                        *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private structs:                                                               *
+ *         ContractionEdge                                                             *
+ *         QuerySpace                                                                  *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         numVertices                                                                 *
+ *         numShortcuts                                                                *
+ *         ranks                                                                       *
+ *         upwardOffsets                                                               *
+ *         upwardTargets                                                               *
+ *         upwardCosts                                                                 *
+ *         downwardOffsets                                                             *
+ *         downwardSources                                                             *
+ *         downwardCosts                                                               *
+ *         edgeMiddles                                                                 *
+ *         edgeFirstHalves                                                             *
+ *         edgeSecondHalves                                                            *
+ *         forwardQuery                                                                *
+ *         backwardQuery                                                               *
+ *         remainingOutEdges                                                           *
+ *         remainingInEdges                                                            *
+ *         witnessDistances                                                            *
+ *         witnessReached                                                              *
+ *         witnessHeap                                                                 *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         findWitnesses                                                               *
+ *         clearWitnesses                                                              *
+ *         contractVertex                                                              *
+ *         computeImportance                                                           *
+ *         addShortcut                                                                 *
+ *         appendUnpackedEdge                                                          *
+ *-------------------------------------------------------------------------------------*/
+class ContractionHierarchy {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private structs                                                                   *
+         *-------------------------------------------------------------------------------------*/
+        /* an edge of the graph while it is being contracted, seen from one of its ends */
+        struct ContractionEdge {
+            public:
+                /* data members */
+                // the vertex at the other end of the edge
+                int otherVertex;
+
+                // the cost of the edge
+                int cost;
+
+                // the vertex a shortcut skips over, or -1 for an edge of the original graph
+                int middleVertex;
+
+                // where the two edges a shortcut replaces are in the middle vertex's edge lists: the
+                // edge into it in its in-edges and the edge out of it in its out-edges
+                int firstHalf;
+                int secondHalf;
+
+                /* constructor */
+                ContractionEdge(int otherVertexValue = -1, int costValue = 0, int middleVertexValue = -1, int firstHalfValue = -1,
+                    int secondHalfValue = -1)
+                    : otherVertex(otherVertexValue), cost(costValue), middleVertex(middleVertexValue), firstHalf(firstHalfValue),
+                      secondHalf(secondHalfValue) {}
+        };
+
+        /* the working space of one direction of a query, reset only where the last query reached */
+        struct QuerySpace {
+            public:
+                /* data members */
+                // the shortest distance found so far to each vertex, INT_MAX if it has not been reached
+                std::vector<int> distances;
+
+                // the vertex before each vertex on its path, or after it when searching backward
+                std::vector<int> nextVertexIndices;
+
+                // the hierarchy edge between each vertex and its nextVertexIndices entry
+                std::vector<int> pathEdges;
+
+                // the vertices reached by the current query, so they can be reset afterward
+                std::vector<int> reachedVertices;
+
+                // the vertices reached but not settled, keyed by (distance, nextVertexIndex)
+                IndexedHeap heap;
+
+                // sizes the space for numVertices vertices, dropping anything left from a hierarchy of another size
+                void prepare(int numVertices) {
+                    if ((int)distances.size() != numVertices) {
+                        distances.assign(numVertices, INT_MAX);
+                        nextVertexIndices.assign(numVertices, -1);
+                        pathEdges.assign(numVertices, -1);
+                        reachedVertices.clear();
+                        heap.reset(numVertices);
+                    }
+                }
+
+                // records a shorter path to vertexIndex over pathEdge and queues it
+                void label(int vertexIndex, int distance, int nextVertexIndex, int pathEdge) {
+                    if (distances[vertexIndex] == INT_MAX) {
+                        reachedVertices.push_back(vertexIndex);
+                    }
+                    distances[vertexIndex] = distance;
+                    nextVertexIndices[vertexIndex] = nextVertexIndex;
+                    pathEdges[vertexIndex] = pathEdge;
+                    heap.pushOrDecrease(vertexIndex, distance, nextVertexIndex);
+                }
+
+                // resets the vertices the last query reached
+                void clear() {
+                    for (int vertexIndex : reachedVertices) {
+                        distances[vertexIndex] = INT_MAX;
+                        nextVertexIndices[vertexIndex] = -1;
+                        pathEdges[vertexIndex] = -1;
+                    }
+                    reachedVertices.clear();
+                    heap.clear();
+                }
+        };
+
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // the number of vertices in the hierarchy, 0 while it is not built
+        int numVertices;
+
+        // the number of shortcuts preprocessing added
+        int numShortcuts;
+
+        // the order each vertex was contracted in. a higher rank is a more important vertex
+        std::vector<int> ranks;
+
+        /* the upward graph: the edges from each vertex to a vertex of higher rank. the edges leaving
+           vertex v are at positions upwardOffsets[v] through upwardOffsets[v + 1] - 1 */
+        std::vector<int> upwardOffsets;
+        std::vector<int> upwardTargets;
+        std::vector<int> upwardCosts;
+
+        /* the downward graph, stored backward: the edges into each vertex from a vertex of higher rank.
+           the edges reaching vertex v are at positions downwardOffsets[v] through downwardOffsets[v + 1] - 1 */
+        std::vector<int> downwardOffsets;
+        std::vector<int> downwardSources;
+        std::vector<int> downwardCosts;
+
+        /* how to unpack each edge of the hierarchy. upward edge e is edge e and downward edge e is edge
+           e + the number of upward edges. a shortcut from u to w through m replaces the downward edge
+           u -> m and the upward edge m -> w, both kept by m when it was contracted */
+        // the vertex each edge skips over, or -1 for an edge of the original graph
+        std::vector<int> edgeMiddles;
+
+        // the edge into the middle vertex and the edge out of it, or -1 for an edge of the original graph
+        std::vector<int> edgeFirstHalves;
+        std::vector<int> edgeSecondHalves;
+
+        // the working space of a query from the source and from the target
+        QuerySpace forwardQuery;
+        QuerySpace backwardQuery;
+
+        /* only used while building */
+        // the edges leaving and reaching each vertex that is not contracted yet, at most one per pair of vertices
+        std::vector< std::vector<ContractionEdge> > remainingOutEdges;
+        std::vector< std::vector<ContractionEdge> > remainingInEdges;
+
+        // the distances found by the last witness search, INT_MAX where it did not reach
+        std::vector<int> witnessDistances;
+
+        // the vertices the last witness search reached
+        std::vector<int> witnessReached;
+
+        // the vertices the witness search reached but did not settle
+        IndexedHeap witnessHeap;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // runs Dijkstra from sourceVertex avoiding skippedVertex, stopping past maxDistance or after settleLimit vertices
+        void findWitnesses(int sourceVertex, int skippedVertex, int maxDistance, int settleLimit);
+
+        // resets the distances the last witness search found
+        void clearWitnesses();
+
+        // returns the number of shortcuts contracting vertex would add, and adds them unless simulate is true
+        int contractVertex(int vertex, bool simulate);
+
+        // returns how much contracting vertex now would grow the graph, plus the number of its neighbors
+        // already contracted so the contraction spreads evenly. the vertex with the lowest goes next
+        int computeImportance(int vertex, const std::vector<int>& numContractedNeighbors);
+
+        // adds shortcut, seen from its from end, to both edge lists or lowers the cost of the edge already there
+        void addShortcut(int fromVertex, const ContractionEdge& shortcut);
+
+        // appends the original vertices along hierarchy edge to path, except the one it starts at
+        void appendUnpackedEdge(int edge, int toVertex, std::vector<int>& path) const;
+
+    public:
+        // constructor
+        ContractionHierarchy() : numVertices(0), numShortcuts(0) {}
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // contracts the graph given as CSR arrays: the edges leaving vertex v are at positions edgeBegins[v]
+        // through edgeEnds[v] - 1 of edgeTargets and edgeCosts. returns false if a cost is negative
+        bool build(int numVerticesValue, const int* edgeBegins, const int* edgeEnds, const int* edgeTargets, const int* edgeCosts);
+
+        // drops the hierarchy
+        void clear();
+
+        // returns true if the hierarchy is built
+        bool isBuilt() const { return numVertices > 0; }
+
+        // returns the number of shortcuts preprocessing added
+        int getNumShortcuts() const { return numShortcuts; }
+
+        // finds a shortest path from sourceVertex to targetVertex. returns false if there is none; otherwise
+        // fills in its cost and its vertices from the source to the target. numSettledVertices is set either way
+        bool query(int sourceVertex, int targetVertex, int& totalDistance, std::vector<int>& pathVertices, int& numSettledVertices);
+};
+
+
+#endif
@@ -0,0 +1,162 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: DialBucketQueue.cpp                                                         *
+ *                                                                                     *
+ *   Desc: implementation file for Dial's bucket queue                                 *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *   Functions:                                                                        *
+ *      reset(int, int)  ...............  empties the queue                            *
+ *      link(int, int)  ................  adds an item to a bucket                     *
+ *      unlink(int)  ...................  takes an item out of its bucket              *
+ *      pushOrDecrease(int, int)  ......  queues an item or changes its key            *
+ *      remove(int)  ...................  takes an item out of the queue               *
+ *      popMinimumLevel(vector<int>)  ..  removes the items with the smallest key      *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include "DialBucketQueue.h"
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function implementations                                                          *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: reset(int, int)                                                    *
+ *                                                                                     *
+ *   description: empties the queue. maxKeyStep + 1 buckets are enough because the     *
+ *                keys queued at any time span at most that many values.              *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DialBucketQueue::reset(int numItems, int maxKeyStep) {
+
+    bucketHeads.assign(maxKeyStep + 1, -1);
+    nextInBucket.assign(numItems, -1);
+    prevInBucket.assign(numItems, -1);
+    bucketOf.assign(numItems, -1);
+    numQueuedItems = 0;
+    currentBucket = 0;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: link(int, int)                                                     *
+ *                                                                                     *
+ *   description: adds item to the front of bucket's list                              *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DialBucketQueue::link(int item, int bucket) {
+
+    prevInBucket[item] = -1;
+    nextInBucket[item] = bucketHeads[bucket];
+    if (bucketHeads[bucket] != -1) {
+        prevInBucket[bucketHeads[bucket]] = item;
+    }
+    bucketHeads[bucket] = item;
+    bucketOf[item] = bucket;
+    numQueuedItems++;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: unlink(int)                                                        *
+ *                                                                                     *
+ *   description: takes a queued item out of its bucket's list                         *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DialBucketQueue::unlink(int item) {
+
+    if (prevInBucket[item] != -1) {
+        nextInBucket[prevInBucket[item]] = nextInBucket[item];
+    }
+    else {
+        bucketHeads[bucketOf[item]] = nextInBucket[item];
+    }
+    if (nextInBucket[item] != -1) {
+        prevInBucket[nextInBucket[item]] = prevInBucket[item];
+    }
+    bucketOf[item] = -1;
+    numQueuedItems--;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: pushOrDecrease(int, int)                                           *
+ *                                                                                     *
+ *   description: queues item with key. an item already queued is moved to the        *
+ *                bucket of its new key.                                               *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DialBucketQueue::pushOrDecrease(int item, int key) {
+
+    // the bucket the key belongs in
+    int bucket = key % (int)bucketHeads.size();
+
+    if (bucketOf[item] == bucket) {
+        return;
+    }
+    if (bucketOf[item] != -1) {
+        unlink(item);
+    }
+    link(item, bucket);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: remove(int)                                                        *
+ *                                                                                     *
+ *   description: takes item out of the queue. does nothing if it is not queued        *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DialBucketQueue::remove(int item) {
+
+    if (bucketOf[item] != -1) {
+        unlink(item);
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: popMinimumLevel(vector<int>)                                       *
+ *                                                                                     *
+ *   description: steps forward from the last level popped to the first bucket that is *
+ *                not empty and moves its items into level. every item in that bucket  *
+ *                has the same key because the queued keys span fewer values than      *
+ *                there are buckets.                                                   *
+ *                                                                                     *
+ *   precondition: the queue must not be empty                                         *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DialBucketQueue::popMinimumLevel(std::vector<int>& level) {
+
+    // the number of buckets
+    int numBuckets = (int)bucketHeads.size();
+
+    level.clear();
+    while (bucketHeads[currentBucket] == -1) {
+        currentBucket = (currentBucket + 1 == numBuckets) ? 0 : currentBucket + 1;
+    }
+
+    for (int item = bucketHeads[currentBucket]; item != -1; item = nextInBucket[item]) {
+        level.push_back(item);
+        bucketOf[item] = -1;
+    }
+    numQueuedItems -= (int)level.size();
+    bucketHeads[currentBucket] = -1;
+}
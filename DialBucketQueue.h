@@ -0,0 +1,108 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: DialBucketQueue.h                                                           *
+ *                                                                                     *
+ *   Desc: header file for Dial's bucket queue of the items 0 to numItems - 1 with    *
+ *         non-negative int keys. there is one bucket per key value in a window of     *
+ *         maxKeyStep + 1 keys, used circularly, so every operation is O(1) apart     *
+ *         from stepping over empty buckets. the keys must be monotone: no key may be  *
+ *         below the last level popped or more than maxKeyStep above it.               *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef DIAL_BUCKET_QUEUE_H_
+#define DIAL_BUCKET_QUEUE_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<vector>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: DialBucketQueue                                                            *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        reset                                                                        *
+ *        empty                                                                        *
+ *        contains                                                                     *
+ *        pushOrDecrease                                                               *
+ *        remove                                                                       *
+ *        popMinimumLevel                                                              *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         bucketHeads                                                                 *
+ *         nextInBucket                                                                *
+ *         prevInBucket                                                                *
+ *         bucketOf                                                                    *
+ *         numQueuedItems                                                              *
+ *         currentBucket                                                               *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         link                                                                        *
+ *         unlink                                                                      *
+ *-------------------------------------------------------------------------------------*/
+class DialBucketQueue {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // the first item of each bucket's list or -1. bucket b holds the keys equal to b modulo the number of buckets
+        std::vector<int> bucketHeads;
+
+        // the next and previous items in the same bucket, or -1 at the ends of the list
+        std::vector<int> nextInBucket;
+        std::vector<int> prevInBucket;
+
+        // the bucket each item is in, or -1 if it is not queued
+        std::vector<int> bucketOf;
+
+        // the number of items queued
+        int numQueuedItems;
+
+        // the bucket of the last level popped. the search for the next level starts here
+        int currentBucket;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // adds item to the front of a bucket's list
+        void link(int item, int bucket);
+
+        // takes item out of its bucket's list
+        void unlink(int item);
+
+    public:
+        // constructor
+        DialBucketQueue(int numItems = 0, int maxKeyStep = 0) { reset(numItems, maxKeyStep); }
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // empties the queue and sizes it for numItems items whose keys are at most maxKeyStep above the last level popped
+        void reset(int numItems, int maxKeyStep);
+
+        // returns true if no items are queued
+        bool empty() const { return numQueuedItems == 0; }
+
+        // returns true if item is queued
+        bool contains(int item) const { return bucketOf[item] != -1; }
+
+        // queues item with key, or moves it to key if it is queued with a different one.
+        // precondition: key is within the window described above
+        void pushOrDecrease(int item, int key);
+
+        // takes item out of the queue if it is queued
+        void remove(int item);
+
+        // moves every item with the smallest key into level, in no particular order
+        // precondition: the queue must not be empty
+        void popMinimumLevel(std::vector<int>& level);
+};
+
+
+#endif
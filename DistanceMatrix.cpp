@@ -0,0 +1,752 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: DistanceMatrix.cpp                                                          *
+ *                                                                                     *
+ *   Desc: implementation file for the all pairs distance matrix                       *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *   Functions:                                                                        *
+ *      relaxBlockScalar(...)  .................  relaxes a block one entry at a time  *
+ *      relaxRowSimd(...)  .....................  relaxes a row 8 entries at a time    *
+ *      relaxBlockSimd(...)  ...................  relaxes a block 8 entries at a time  *
+ *      hasNegativeCycle(int, int*, ...)  ......  looks for a negative cycle           *
+ *      build(int, int*, int*, int*, int*, ...)  computes the distances                *
+ *      clear()  ...............................  drops the matrix                     *
+ *      relaxBlock(int, int, int, bool)  .......  relaxes one block                    *
+ *      repairNextVertices(int*, int*, ...)  ...  reroutes paths stuck on cycles       *
+ *      path(int, int, vector<int>)  ...........  rebuilds a shortest path             *
+ *      save(string)  ..........................  writes the matrix to a file          *
+ *      load(string)  ..........................  reads a matrix from a file           *
+ *      simdKernelSupported()  .................  checks for AVX2                      *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include "DistanceMatrix.h"
+#include<fstream>
+#include<algorithm>
+#include<cstring>
+#include<cstdint>
+#include<cstdlib>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include<immintrin.h>
+#define DISTANCE_MATRIX_HAS_AVX2_KERNEL 1
+#else
+#define DISTANCE_MATRIX_HAS_AVX2_KERNEL 0
+#endif
+
+/*-------------------------------------------------------------------------------------*
+ *   constants                                                                         *
+ *-------------------------------------------------------------------------------------*/
+const int FLOYD_WARSHALL_BLOCK_SIZE = 64; // the side of a block; three blocks of ints fit in a 64 KB cache. a multiple of 8
+const int NO_PATH = 0x3FFFFFFF; // stands for no path while building. two of them add up without overflowing
+const int SIMD_WIDTH = 8; // the number of distances in an AVX2 register
+
+const char DISTANCE_MATRIX_MAGIC[8] = {'G', 'R', 'P', 'H', 'D', 'I', 'S', 'T'}; // the first bytes of every saved matrix
+const std::uint32_t DISTANCE_MATRIX_VERSION = 1; // bumped whenever the layout changes
+const std::uint32_t DISTANCE_MATRIX_BYTE_ORDER_MARK = 0x01020304; // reads differently on a machine of the other endianness
+const std::int16_t SHORT_NO_PATH = INT16_MAX; // stands for no path in a matrix saved 2 bytes an entry
+
+/* the fixed size header at the start of a saved matrix. the distances follow, one row after another,
+   then the next vertices if the paths were kept, each in entries of the size the header gives */
+struct DistanceMatrixHeader {
+    char magic[8]; // DISTANCE_MATRIX_MAGIC
+    std::uint32_t version; // DISTANCE_MATRIX_VERSION
+    std::uint32_t byteOrderMark; // DISTANCE_MATRIX_BYTE_ORDER_MARK
+    std::int64_t numVertices; // the number of rows and columns
+    std::uint32_t distanceBytes; // 2 or 4
+    std::uint32_t nextVertexBytes; // 2 or 4, or 0 if the paths were not kept
+};
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function implementations                                                          *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: relaxBlockScalar(...)                                              *
+ *                                                                                     *
+ *   description: lowers each distance c[i][j] of a block to a[i][k] + b[k][j] for     *
+ *                every k of the block, where a and b are the blocks holding the paths *
+ *                to and from the intermediate vertices. when a or b is the block      *
+ *                itself the intermediate vertices must be taken one at a time, the    *
+ *                way Floyd-Warshall does; otherwise each row is finished before the   *
+ *                next, which keeps it in cache. cNext and aNext, if not null, are the *
+ *                next vertices of c and a and are kept in step with the distances.    *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+static void relaxBlockScalar(int* c, const int* a, const int* b, int* cNext, const int* aNext, int rowStride, bool dependent) {
+
+    if (dependent) {
+        for (int k = 0; k < FLOYD_WARSHALL_BLOCK_SIZE; k++) {
+            const int* bRow = b + (size_t)k * rowStride;
+            for (int i = 0; i < FLOYD_WARSHALL_BLOCK_SIZE; i++) {
+
+                // the distance to the intermediate vertex, skipped if there is no path
+                int throughDistance = a[(size_t)i * rowStride + k];
+                if (throughDistance > NO_PATH / 2) {
+                    continue;
+                }
+
+                int* cRow = c + (size_t)i * rowStride;
+                for (int j = 0; j < FLOYD_WARSHALL_BLOCK_SIZE; j++) {
+                    if (throughDistance + bRow[j] < cRow[j]) {
+                        cRow[j] = throughDistance + bRow[j];
+                        if (cNext != nullptr) {
+                            cNext[(size_t)i * rowStride + j] = aNext[(size_t)i * rowStride + k];
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    for (int i = 0; i < FLOYD_WARSHALL_BLOCK_SIZE; i++) {
+        int* cRow = c + (size_t)i * rowStride;
+        for (int k = 0; k < FLOYD_WARSHALL_BLOCK_SIZE; k++) {
+
+            // the distance to the intermediate vertex, skipped if there is no path
+            int throughDistance = a[(size_t)i * rowStride + k];
+            if (throughDistance > NO_PATH / 2) {
+                continue;
+            }
+
+            const int* bRow = b + (size_t)k * rowStride;
+            if (cNext == nullptr) {
+                for (int j = 0; j < FLOYD_WARSHALL_BLOCK_SIZE; j++) {
+                    cRow[j] = std::min(cRow[j], throughDistance + bRow[j]);
+                }
+            }
+            else {
+                for (int j = 0; j < FLOYD_WARSHALL_BLOCK_SIZE; j++) {
+                    if (throughDistance + bRow[j] < cRow[j]) {
+                        cRow[j] = throughDistance + bRow[j];
+                        cNext[(size_t)i * rowStride + j] = aNext[(size_t)i * rowStride + k];
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+
+#if DISTANCE_MATRIX_HAS_AVX2_KERNEL
+/*-------------------------------------------------------------------------------------*
+ *   function name: relaxRowSimd(...)                                                  *
+ *                                                                                     *
+ *   description: lowers row i of a block through intermediate vertex k, 8 distances   *
+ *                at a time, reading and writing the row in memory. the next vertices  *
+ *                of the entries it lowers are blended in under the same mask.         *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+__attribute__((target("avx2")))
+static void relaxRowSimd(int* c, const int* a, const int* b, int* cNext, const int* aNext, int rowStride, int i, int k) {
+
+    // the distance to the intermediate vertex, skipped if there is no path
+    int throughDistance = a[(size_t)i * rowStride + k];
+    if (throughDistance > NO_PATH / 2) {
+        return;
+    }
+
+    __m256i through = _mm256_set1_epi32(throughDistance);
+    __m256i throughNext = _mm256_set1_epi32((cNext != nullptr) ? aNext[(size_t)i * rowStride + k] : 0);
+    const int* bRow = b + (size_t)k * rowStride;
+    int* cRow = c + (size_t)i * rowStride;
+    int* cNextRow = (cNext != nullptr) ? cNext + (size_t)i * rowStride : nullptr;
+
+    for (int j = 0; j < FLOYD_WARSHALL_BLOCK_SIZE; j += SIMD_WIDTH) {
+        __m256i current = _mm256_loadu_si256((const __m256i*)(cRow + j));
+        __m256i candidate = _mm256_add_epi32(through, _mm256_loadu_si256((const __m256i*)(bRow + j)));
+        if (cNextRow != nullptr) {
+            __m256i improved = _mm256_cmpgt_epi32(current, candidate);
+            __m256i next = _mm256_loadu_si256((const __m256i*)(cNextRow + j));
+            _mm256_storeu_si256((__m256i*)(cNextRow + j), _mm256_blendv_epi8(next, throughNext, improved));
+        }
+        _mm256_storeu_si256((__m256i*)(cRow + j), _mm256_min_epi32(current, candidate));
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: relaxBlockSimd(...)                                                *
+ *                                                                                     *
+ *   description: does what relaxBlockScalar does, 8 distances at a time. only         *
+ *                compiled for AVX2, so it must only run where simdKernelSupported     *
+ *                says so. without next vertices and when a and b are other blocks, a  *
+ *                whole row of the block is held in registers across every k.          *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+__attribute__((target("avx2")))
+static void relaxBlockSimd(int* c, const int* a, const int* b, int* cNext, const int* aNext, int rowStride, bool dependent) {
+
+    const int numVectors = FLOYD_WARSHALL_BLOCK_SIZE / SIMD_WIDTH; // the registers a row of the block takes
+
+    if (!dependent && cNext == nullptr) {
+        for (int i = 0; i < FLOYD_WARSHALL_BLOCK_SIZE; i++) {
+
+            // the row being relaxed
+            int* cRow = c + (size_t)i * rowStride;
+            __m256i rowDistances[numVectors];
+            for (int vector = 0; vector < numVectors; vector++) {
+                rowDistances[vector] = _mm256_loadu_si256((const __m256i*)(cRow + vector * SIMD_WIDTH));
+            }
+
+            for (int k = 0; k < FLOYD_WARSHALL_BLOCK_SIZE; k++) {
+                int throughDistance = a[(size_t)i * rowStride + k];
+                if (throughDistance > NO_PATH / 2) {
+                    continue;
+                }
+                __m256i through = _mm256_set1_epi32(throughDistance);
+                const int* bRow = b + (size_t)k * rowStride;
+                for (int vector = 0; vector < numVectors; vector++) {
+                    __m256i candidate = _mm256_add_epi32(through, _mm256_loadu_si256((const __m256i*)(bRow + vector * SIMD_WIDTH)));
+                    rowDistances[vector] = _mm256_min_epi32(rowDistances[vector], candidate);
+                }
+            }
+
+            for (int vector = 0; vector < numVectors; vector++) {
+                _mm256_storeu_si256((__m256i*)(cRow + vector * SIMD_WIDTH), rowDistances[vector]);
+            }
+        }
+        return;
+    }
+
+    if (dependent) {
+        for (int k = 0; k < FLOYD_WARSHALL_BLOCK_SIZE; k++) {
+            for (int i = 0; i < FLOYD_WARSHALL_BLOCK_SIZE; i++) {
+                relaxRowSimd(c, a, b, cNext, aNext, rowStride, i, k);
+            }
+        }
+    }
+    else {
+        for (int i = 0; i < FLOYD_WARSHALL_BLOCK_SIZE; i++) {
+            for (int k = 0; k < FLOYD_WARSHALL_BLOCK_SIZE; k++) {
+                relaxRowSimd(c, a, b, cNext, aNext, rowStride, i, k);
+            }
+        }
+    }
+}
+#endif
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: hasNegativeCycle(int, int*, int*, int*, int*)                      *
+ *                                                                                     *
+ *   description: runs Bellman-Ford from a virtual source joined to every vertex at    *
+ *                cost 0, stopping early once a pass changes nothing. a change in the  *
+ *                last pass means a cycle keeps lowering distances.                    *
+ *                                                                                     *
+ *   returns: true if the graph has a negative cycle                                   *
+ *-------------------------------------------------------------------------------------*/
+static bool hasNegativeCycle(int numVertices, const int* edgeBegins, const int* edgeEnds, const int* edgeTargets, const int* edgeCosts) {
+
+    // the shortest distance from the virtual source to each vertex
+    std::vector<long long> potentials(numVertices, 0);
+
+    for (int pass = 0; pass < numVertices; pass++) {
+
+        // true if this pass lowered a distance
+        bool changed = false;
+
+        for (int vertex = 0; vertex < numVertices; vertex++) {
+            for (int edge = edgeBegins[vertex]; edge < edgeEnds[vertex]; edge++) {
+                if (potentials[vertex] + edgeCosts[edge] < potentials[edgeTargets[edge]]) {
+                    potentials[edgeTargets[edge]] = potentials[vertex] + edgeCosts[edge];
+                    changed = true;
+                }
+            }
+        }
+        if (!changed) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: build(int, int*, int*, int*, int*, bool, bool)                     *
+ *                                                                                     *
+ *   description: runs blocked Floyd-Warshall. for each block of intermediate vertices *
+ *                the block on the diagonal is relaxed through itself first, then the  *
+ *                rest of its block row and block column through it, and last every    *
+ *                other block through its row and column. only that last step, which   *
+ *                is nearly all the work, reads blocks that are not being changed, so  *
+ *                it gets the faster form of the kernel.                               *
+ *                                                                                     *
+ *                a missing path is NO_PATH while building. adding a cost to it can   *
+ *                take it somewhat below NO_PATH, so anything past NO_PATH / 2 is      *
+ *                still no path, which holds as long as no real path can reach         *
+ *                NO_PATH / 2.                                                         *
+ *                                                                                     *
+ *   returns: true if the matrix was built. false if the graph has a negative cycle or *
+ *            its costs are too large                                                  *
+ *-------------------------------------------------------------------------------------*/
+bool DistanceMatrix::build(int numVerticesValue, const int* edgeBegins, const int* edgeEnds, const int* edgeTargets,
+    const int* edgeCosts, bool keepPaths, bool allowSimd) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the largest cost ignoring its sign, and whether any cost is negative
+    long long largestCost = 0;
+    bool hasNegativeCost = false;
+
+    // the number of blocks along a side of the matrix
+    int numBlocks = (numVerticesValue + FLOYD_WARSHALL_BLOCK_SIZE - 1) / FLOYD_WARSHALL_BLOCK_SIZE;
+
+    // true if the AVX2 kernel is used
+    bool useSimd = allowSimd && simdKernelSupported();
+
+    /*-------------------------------------------------------------------------------------*
+     *   check the costs                                                                   *
+     *-------------------------------------------------------------------------------------*/
+    clear();
+
+    for (int vertex = 0; vertex < numVerticesValue; vertex++) {
+        for (int edge = edgeBegins[vertex]; edge < edgeEnds[vertex]; edge++) {
+            largestCost = std::max(largestCost, (long long)std::abs(edgeCosts[edge]));
+            hasNegativeCost = hasNegativeCost || edgeCosts[edge] < 0;
+        }
+    }
+    if (largestCost * std::max(numVerticesValue - 1, 1) >= NO_PATH / 2) {
+        return false;
+    }
+
+    // a negative cycle would drive the distances down until they overflow
+    if (hasNegativeCost && hasNegativeCycle(numVerticesValue, edgeBegins, edgeEnds, edgeTargets, edgeCosts)) {
+        return false;
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   fill in the edges                                                                 *
+     *-------------------------------------------------------------------------------------*/
+    numVertices = numVerticesValue;
+    rowStride = numBlocks * FLOYD_WARSHALL_BLOCK_SIZE;
+    distances.assign((size_t)rowStride * rowStride, NO_PATH);
+    if (keepPaths) {
+        nextVertices.assign((size_t)rowStride * rowStride, -1);
+    }
+
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        distances[(size_t)vertex * rowStride + vertex] = 0;
+        if (keepPaths) {
+            nextVertices[(size_t)vertex * rowStride + vertex] = vertex;
+        }
+
+        // keep the cheapest of parallel edges; a self loop never beats staying put
+        for (int edge = edgeBegins[vertex]; edge < edgeEnds[vertex]; edge++) {
+            size_t position = (size_t)vertex * rowStride + edgeTargets[edge];
+            if (edgeCosts[edge] < distances[position]) {
+                distances[position] = edgeCosts[edge];
+                if (keepPaths) {
+                    nextVertices[position] = edgeTargets[edge];
+                }
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   relax the blocks                                                                  *
+     *-------------------------------------------------------------------------------------*/
+    for (int blockStep = 0; blockStep < numBlocks; blockStep++) {
+
+        relaxBlock(blockStep, blockStep, blockStep, useSimd);
+
+        for (int block = 0; block < numBlocks; block++) {
+            if (block != blockStep) {
+                relaxBlock(blockStep, block, blockStep, useSimd);
+                relaxBlock(block, blockStep, blockStep, useSimd);
+            }
+        }
+
+        for (int blockRow = 0; blockRow < numBlocks; blockRow++) {
+            if (blockRow == blockStep) {
+                continue;
+            }
+            for (int blockColumn = 0; blockColumn < numBlocks; blockColumn++) {
+                if (blockColumn != blockStep) {
+                    relaxBlock(blockRow, blockColumn, blockStep, useSimd);
+                }
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   mark the missing paths                                                            *
+     *-------------------------------------------------------------------------------------*/
+    for (size_t position = 0; position < distances.size(); position++) {
+        if (distances[position] > NO_PATH / 2) {
+            distances[position] = INT_MAX;
+            if (keepPaths) {
+                nextVertices[position] = -1;
+            }
+        }
+    }
+    simdKernelUsed = useSimd;
+
+    if (keepPaths) {
+        repairNextVertices(edgeBegins, edgeEnds, edgeTargets, edgeCosts);
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: clear()                                                            *
+ *                                                                                     *
+ *   description: drops the matrix and gives back its memory                           *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DistanceMatrix::clear() {
+
+    numVertices = 0;
+    rowStride = 0;
+    simdKernelUsed = false;
+    std::vector<int>().swap(distances);
+    std::vector<int>().swap(nextVertices);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: relaxBlock(int, int, int, bool)                                    *
+ *                                                                                     *
+ *   description: relaxes block (blockRow, blockColumn) through the intermediate       *
+ *                vertices of block blockStep on the kernel asked for                  *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DistanceMatrix::relaxBlock(int blockRow, int blockColumn, int blockStep, bool useSimd) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // where the block being relaxed, the block of paths to the intermediate vertices and the block
+    // of paths from them start
+    size_t cStart = (size_t)blockRow * FLOYD_WARSHALL_BLOCK_SIZE * rowStride + (size_t)blockColumn * FLOYD_WARSHALL_BLOCK_SIZE;
+    size_t aStart = (size_t)blockRow * FLOYD_WARSHALL_BLOCK_SIZE * rowStride + (size_t)blockStep * FLOYD_WARSHALL_BLOCK_SIZE;
+    size_t bStart = (size_t)blockStep * FLOYD_WARSHALL_BLOCK_SIZE * rowStride + (size_t)blockColumn * FLOYD_WARSHALL_BLOCK_SIZE;
+
+    // the next vertices of the block being relaxed and of the paths to the intermediate vertices
+    int* cNext = nextVertices.empty() ? nullptr : nextVertices.data() + cStart;
+    const int* aNext = nextVertices.empty() ? nullptr : nextVertices.data() + aStart;
+
+    // true if the block is its own row or column block, so its entries depend on each other
+    bool dependent = (blockRow == blockStep || blockColumn == blockStep);
+
+    /*-------------------------------------------------------------------------------------*
+     *   relax the block                                                                   *
+     *-------------------------------------------------------------------------------------*/
+#if DISTANCE_MATRIX_HAS_AVX2_KERNEL
+    if (useSimd) {
+        relaxBlockSimd(distances.data() + cStart, distances.data() + aStart, distances.data() + bStart, cNext, aNext, rowStride, dependent);
+        return;
+    }
+#endif
+    relaxBlockScalar(distances.data() + cStart, distances.data() + aStart, distances.data() + bStart, cNext, aNext, rowStride, dependent);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: repairNextVertices(int*, int*, int*, int*)                         *
+ *                                                                                     *
+ *   description: each next vertex starts a shortest path to its target, but where two *
+ *                vertices lie on a cycle of zero cost each may pick the other, and    *
+ *                following them goes around the cycle forever. for each target the    *
+ *                next vertices are followed from every vertex; those whose walk comes *
+ *                back on itself are stuck. each stuck vertex is then given an edge    *
+ *                that starts a shortest path into a vertex that does reach the        *
+ *                target, spreading outward from the ones that do until every stuck    *
+ *                vertex is fixed. it costs O(V^2) when nothing is stuck.              *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DistanceMatrix::repairNextVertices(const int* edgeBegins, const int* edgeEnds, const int* edgeTargets, const int* edgeCosts) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // what is known of each vertex's walk to the current target
+    enum WalkState : char { UNWALKED, WALKING, REACHES_TARGET, STUCK };
+    std::vector<char> walkStates(numVertices);
+
+    // the vertices of the walk being followed, and the stuck vertices of the current target
+    std::vector<int> walk;
+    std::vector<int> stuckVertices;
+
+    /*-------------------------------------------------------------------------------------*
+     *   repair each target's next vertices                                                *
+     *-------------------------------------------------------------------------------------*/
+    for (int target = 0; target < numVertices; target++) {
+
+        std::fill(walkStates.begin(), walkStates.end(), (char)UNWALKED);
+        walkStates[target] = REACHES_TARGET;
+        stuckVertices.clear();
+
+        /* follow the next vertices from every vertex with a path to the target */
+        for (int start = 0; start < numVertices; start++) {
+            if (walkStates[start] != UNWALKED || distance(start, target) == INT_MAX) {
+                continue;
+            }
+
+            // walk until reaching a vertex whose fate is known or one already on this walk
+            int vertex = start;
+            while (walkStates[vertex] == UNWALKED) {
+                walkStates[vertex] = WALKING;
+                walk.push_back(vertex);
+                vertex = nextVertices[(size_t)vertex * rowStride + target];
+            }
+
+            // the whole walk shares the fate of where it ended
+            char walkState = (walkStates[vertex] == REACHES_TARGET) ? REACHES_TARGET : STUCK;
+            for (int walkVertex : walk) {
+                walkStates[walkVertex] = walkState;
+                if (walkState == STUCK) {
+                    stuckVertices.push_back(walkVertex);
+                }
+            }
+            walk.clear();
+        }
+
+        /* give each stuck vertex a shortest path edge into a vertex that reaches the target */
+        bool repaired = true;
+        while (!stuckVertices.empty() && repaired) {
+            repaired = false;
+            for (size_t position = 0; position < stuckVertices.size(); ) {
+
+                // the stuck vertex and its distance to the target
+                int vertex = stuckVertices[position];
+                int vertexDistance = distance(vertex, target);
+
+                for (int edge = edgeBegins[vertex]; edge < edgeEnds[vertex]; edge++) {
+                    int edgeTarget = edgeTargets[edge];
+                    if (walkStates[edgeTarget] == REACHES_TARGET && distance(edgeTarget, target) != INT_MAX
+                        && edgeCosts[edge] + distance(edgeTarget, target) == vertexDistance) {
+                        nextVertices[(size_t)vertex * rowStride + target] = edgeTarget;
+                        walkStates[vertex] = REACHES_TARGET;
+                        break;
+                    }
+                }
+
+                if (walkStates[vertex] == REACHES_TARGET) {
+                    stuckVertices[position] = stuckVertices.back();
+                    stuckVertices.pop_back();
+                    repaired = true;
+                }
+                else {
+                    position++;
+                }
+            }
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: path(int, int, vector<int>)                                        *
+ *                                                                                     *
+ *   description: follows the next vertices from fromVertex until toVertex             *
+ *                                                                                     *
+ *   returns: true if the path was found. false if there is none or the paths were     *
+ *            not kept                                                                 *
+ *-------------------------------------------------------------------------------------*/
+bool DistanceMatrix::path(int fromVertex, int toVertex, std::vector<int>& pathVertices) const {
+
+    pathVertices.clear();
+    if (nextVertices.empty() || distance(fromVertex, toVertex) == INT_MAX) {
+        return false;
+    }
+
+    pathVertices.push_back(fromVertex);
+    while (fromVertex != toVertex && (int)pathVertices.size() <= numVertices) {
+        fromVertex = nextVertices[(size_t)fromVertex * rowStride + toVertex];
+        pathVertices.push_back(fromVertex);
+    }
+
+    return fromVertex == toVertex;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: save(string)                                                       *
+ *                                                                                     *
+ *   description: writes the header, then the rows without the padding they have while *
+ *                building. the distances take 2 bytes each when every one of them     *
+ *                fits below SHORT_NO_PATH, and so do the next vertices when there are *
+ *                few enough vertices.                                                 *
+ *                                                                                     *
+ *   returns: true if the file was written                                             *
+ *-------------------------------------------------------------------------------------*/
+bool DistanceMatrix::save(const std::string& fileName) const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    std::ofstream outfile(fileName, std::ios::binary | std::ios::trunc); // the file being written
+    DistanceMatrixHeader header; // the header
+    bool shortDistances = true; // true if every distance fits in 2 bytes
+
+    /*-------------------------------------------------------------------------------------*
+     *   write the file                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    if ( !outfile.is_open() ) {
+        return false;
+    }
+
+    for (int row = 0; row < numVertices && shortDistances; row++) {
+        for (int column = 0; column < numVertices; column++) {
+            int entry = distance(row, column);
+            if (entry != INT_MAX && (entry >= SHORT_NO_PATH || entry < INT16_MIN)) {
+                shortDistances = false;
+                break;
+            }
+        }
+    }
+
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, DISTANCE_MATRIX_MAGIC, sizeof(DISTANCE_MATRIX_MAGIC));
+    header.version = DISTANCE_MATRIX_VERSION;
+    header.byteOrderMark = DISTANCE_MATRIX_BYTE_ORDER_MARK;
+    header.numVertices = numVertices;
+    header.distanceBytes = shortDistances ? sizeof(std::int16_t) : sizeof(std::int32_t);
+    header.nextVertexBytes = !hasPaths() ? 0 : (numVertices <= INT16_MAX) ? sizeof(std::int16_t) : sizeof(std::int32_t);
+    outfile.write((const char*)&header, sizeof(header));
+
+    /* writes one row of matrix in entries of entryBytes bytes, with INT_MAX written as SHORT_NO_PATH */
+    std::vector<char> rowBytes;
+    auto writeRow = [&](const std::vector<int>& matrix, int row, std::uint32_t entryBytes) {
+        const int* entries = matrix.data() + (size_t)row * rowStride;
+        rowBytes.resize((size_t)numVertices * entryBytes);
+        if (entryBytes == sizeof(std::int32_t)) {
+            std::memcpy(rowBytes.data(), entries, rowBytes.size());
+        }
+        else {
+            for (int column = 0; column < numVertices; column++) {
+                std::int16_t entry = (entries[column] == INT_MAX) ? SHORT_NO_PATH : (std::int16_t)entries[column];
+                std::memcpy(rowBytes.data() + (size_t)column * sizeof(entry), &entry, sizeof(entry));
+            }
+        }
+        outfile.write(rowBytes.data(), rowBytes.size());
+    };
+
+    for (int row = 0; row < numVertices; row++) {
+        writeRow(distances, row, header.distanceBytes);
+    }
+    for (int row = 0; row < numVertices && hasPaths(); row++) {
+        writeRow(nextVertices, row, header.nextVertexBytes);
+    }
+
+    return outfile.good();
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: load(string)                                                       *
+ *                                                                                     *
+ *   description: reads a matrix written by save, checking the header and that the     *
+ *                file holds every entry it promises                                   *
+ *                                                                                     *
+ *   returns: true if the matrix was read                                              *
+ *-------------------------------------------------------------------------------------*/
+bool DistanceMatrix::load(const std::string& fileName) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    std::ifstream infile(fileName, std::ios::binary | std::ios::ate); // the file being read, opened at its end to get its size
+    DistanceMatrixHeader header; // the header
+    std::uint64_t fileSize; // the number of bytes in the file
+
+    /*-------------------------------------------------------------------------------------*
+     *   read the file                                                                     *
+     *-------------------------------------------------------------------------------------*/
+    clear();
+    if ( !infile.is_open() ) {
+        return false;
+    }
+    fileSize = (std::uint64_t)infile.tellg();
+    infile.seekg(0);
+    if (!infile.read((char*)&header, sizeof(header))) {
+        return false;
+    }
+    if (std::memcmp(header.magic, DISTANCE_MATRIX_MAGIC, sizeof(DISTANCE_MATRIX_MAGIC)) != 0 || header.version != DISTANCE_MATRIX_VERSION
+        || header.byteOrderMark != DISTANCE_MATRIX_BYTE_ORDER_MARK || header.numVertices < 0 || header.numVertices > INT_MAX
+        || (header.distanceBytes != sizeof(std::int16_t) && header.distanceBytes != sizeof(std::int32_t))
+        || (header.nextVertexBytes != 0 && header.nextVertexBytes != sizeof(std::int16_t) && header.nextVertexBytes != sizeof(std::int32_t))) {
+        return false;
+    }
+
+    // check the size before allocating anything, so a damaged header cannot ask for too much memory
+    if (fileSize != sizeof(header) + (std::uint64_t)header.numVertices * header.numVertices * (header.distanceBytes + header.nextVertexBytes)) {
+        return false;
+    }
+
+    /* reads a matrix in entries of entryBytes bytes, with SHORT_NO_PATH read back as INT_MAX */
+    std::vector<char> matrixBytes;
+    auto readMatrix = [&](std::vector<int>& matrix, std::uint32_t entryBytes, bool isDistance) {
+        size_t numEntries = (size_t)header.numVertices * header.numVertices;
+        matrixBytes.resize(numEntries * entryBytes);
+        if (!infile.read(matrixBytes.data(), matrixBytes.size())) {
+            return false;
+        }
+        matrix.resize(numEntries);
+        if (entryBytes == sizeof(std::int32_t)) {
+            std::memcpy(matrix.data(), matrixBytes.data(), matrixBytes.size());
+            return true;
+        }
+        for (size_t position = 0; position < numEntries; position++) {
+            std::int16_t entry;
+            std::memcpy(&entry, matrixBytes.data() + position * sizeof(entry), sizeof(entry));
+            matrix[position] = (isDistance && entry == SHORT_NO_PATH) ? INT_MAX : entry;
+        }
+        return true;
+    };
+
+    if (!readMatrix(distances, header.distanceBytes, true)
+        || (header.nextVertexBytes != 0 && !readMatrix(nextVertices, header.nextVertexBytes, false))) {
+        clear();
+        return false;
+    }
+    numVertices = (int)header.numVertices;
+    rowStride = numVertices;
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: simdKernelSupported()                                              *
+ *                                                                                     *
+ *   description: asks the processor whether it has AVX2                               *
+ *                                                                                     *
+ *   returns: true if the AVX2 kernel can run                                          *
+ *-------------------------------------------------------------------------------------*/
+bool DistanceMatrix::simdKernelSupported() {
+
+#if DISTANCE_MATRIX_HAS_AVX2_KERNEL
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,131 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: DistanceMatrix.h                                                            *
+ *                                                                                     *
+ *   Desc: header file for the matrix of shortest distances between every pair of      *
+ *         vertices of a weighted directed graph, computed with a cache blocked        *
+ *         Floyd-Warshall. the matrix is split into square blocks that fit in cache    *
+ *         and each block is relaxed with a min-plus kernel, 8 distances at a time     *
+ *         with AVX2 where the processor has it. meant for small dense graphs, since   *
+ *         it takes O(V^3) time and O(V^2) memory.                                     *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef DISTANCE_MATRIX_H_
+#define DISTANCE_MATRIX_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<vector>
+#include<string>
+#include<climits>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: DistanceMatrix                                                             *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        build                                                                        *
+ *        clear                                                                        *
+ *        size                                                                         *
+ *        hasPaths                                                                     *
+ *        usedSimdKernel                                                               *
+ *        distance                                                                     *
+ *        path                                                                         *
+ *        save                                                                         *
+ *        load                                                                         *
+ *        simdKernelSupported                                                          *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         numVertices                                                                 *
+ *         rowStride                                                                   *
+ *         distances                                                                   *
+ *         nextVertices                                                                *
+ *         simdKernelUsed                                                              *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         relaxBlock                                                                  *
+ *         repairNextVertices                                                          *
+ *-------------------------------------------------------------------------------------*/
+class DistanceMatrix {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // the number of vertices in the matrix
+        int numVertices;
+
+        // the distance between the starts of two rows. while building it is numVertices rounded up
+        // to a whole number of blocks, the extra rows and columns holding no paths
+        int rowStride;
+
+        // the shortest distance from vertex i to vertex j at position i * rowStride + j, INT_MAX if there is none
+        std::vector<int> distances;
+
+        // the vertex after i on a shortest path from i to j at position i * rowStride + j, -1 if there is
+        // no path. empty unless the paths were kept
+        std::vector<int> nextVertices;
+
+        // true if the last build ran the AVX2 kernel
+        bool simdKernelUsed;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // relaxes block (blockRow, blockColumn) through the intermediate vertices of block blockStep
+        void relaxBlock(int blockRow, int blockColumn, int blockStep, bool useSimd);
+
+        // reroutes the next vertices that go around a cycle of zero cost instead of reaching their target
+        void repairNextVertices(const int* edgeBegins, const int* edgeEnds, const int* edgeTargets, const int* edgeCosts);
+
+    public:
+        // constructor
+        DistanceMatrix() : numVertices(0), rowStride(0), simdKernelUsed(false) {}
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // computes the distances of the graph given as CSR arrays: the edges leaving vertex v are at positions
+        // edgeBegins[v] through edgeEnds[v] - 1 of edgeTargets and edgeCosts. keepPaths also keeps what is needed
+        // to rebuild the paths, and allowSimd false forces the scalar kernel. returns false, leaving the matrix
+        // empty, if the graph has a negative cycle or costs so large a path could overflow an int
+        bool build(int numVerticesValue, const int* edgeBegins, const int* edgeEnds, const int* edgeTargets, const int* edgeCosts,
+            bool keepPaths, bool allowSimd = true);
+
+        // drops the matrix
+        void clear();
+
+        // returns the number of vertices in the matrix
+        int size() const { return numVertices; }
+
+        // returns true if the paths were kept
+        bool hasPaths() const { return !nextVertices.empty(); }
+
+        // returns true if the last build ran the AVX2 kernel
+        bool usedSimdKernel() const { return simdKernelUsed; }
+
+        // returns the shortest distance from fromVertex to toVertex, INT_MAX if there is no path
+        int distance(int fromVertex, int toVertex) const { return distances[(size_t)fromVertex * rowStride + toVertex]; }
+
+        // fills pathVertices with the vertices of a shortest path from fromVertex to toVertex, both ends included.
+        // returns false if there is no path or the paths were not kept
+        bool path(int fromVertex, int toVertex, std::vector<int>& pathVertices) const;
+
+        // writes the matrix to fileName in a compact binary form, 2 bytes an entry when every distance fits.
+        // returns false if the file could not be written
+        bool save(const std::string& fileName) const;
+
+        // reads a matrix written by save. returns false, leaving the matrix empty, if the file is not one
+        bool load(const std::string& fileName);
+
+        // returns true if the processor can run the AVX2 kernel
+        static bool simdKernelSupported();
+};
+
+
+#endif
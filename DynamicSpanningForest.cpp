@@ -0,0 +1,774 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: DynamicSpanningForest.cpp                                                   *
+ *                                                                                     *
+ *   Desc: implementation file for the minimum spanning forest kept up to date under   *
+ *         edge insertions, removals and cost changes                                  *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *   Functions:                                                                        *
+ *      build(int, int*, int*, int*, int*, vector<int>)  copies the graph and forest   *
+ *      clear()  .......................  drops the forest                             *
+ *      addVertex()  ...................  adds a vertex as a tree of its own           *
+ *      insertEdge(int, int, int)  .....  inserts an edge, swapping it in if cheaper   *
+ *      removeEdge(int, int, int)  .....  removes an edge, replacing it if needed      *
+ *      updateEdgeCost(int, int, int, int)  changes the cost of an edge                *
+ *      listTreeEdges(vector<tuple>)  ..  lists the edges of the forest                *
+ *      edgeLess(int, int)  ............  compares two edges                           *
+ *      newEdge(int, int, int)  ........  stores an edge and lists it at its ends      *
+ *      deleteEdge(int)  ...............  unlists an edge and frees its node           *
+ *      findEdge(int, int, int)  .......  finds the node of an edge                    *
+ *      isSplayRoot(int)  ..............  tells if a node tops its splay tree          *
+ *      pushDown(int)  .................  passes a reversal on to the children         *
+ *      pullUp(int)  ...................  recomputes the most costly edge below        *
+ *      rotate(int)  ...................  moves a node above its parent                *
+ *      splay(int)  ....................  moves a node to the top of its splay tree    *
+ *      access(int)  ...................  makes a node's root path preferred           *
+ *      makeRoot(int)  .................  reroots a node's tree at it                  *
+ *      findRoot(int)  .................  finds the root of a node's tree              *
+ *      link(int, int)  ................  joins two trees                              *
+ *      cut(int, int)  .................  splits a tree                                *
+ *      linkEdge(int)  .................  adds an edge to the forest                   *
+ *      cutEdge(int)  ..................  takes an edge out of the forest              *
+ *      offerEdge(int)  ................  swaps an edge in if it belongs               *
+ *      reconnect(int, int)  ...........  rejoins a split tree with the cheapest edge  *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include "DynamicSpanningForest.h"
+#include<algorithm>
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function implementations                                                          *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: build(int, int*, int*, int*, int*, vector<int>)                    *
+ *                                                                                     *
+ *   description: copies the edges, lists each at both its ends, and takes the forest  *
+ *                found by the caller, so finding it is left to Graph's spanning tree  *
+ *                engines, which sort the edges far faster than comparing them here    *
+ *                one by one would. each tree of the forest is hung from its first     *
+ *                vertex by a breadth first search that points every node at its       *
+ *                parent, which is a link-cut tree whose preferred paths are single    *
+ *                nodes, so no splaying is needed to build it                          *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::build(int numVertices, const int* edgeBegins, const int* edgeEnds, const int* edgeTargets,
+    const int* edgeCosts, const std::vector<int>& treeEdgePositions) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the node of the edge at each position of the CSR arrays
+    std::vector<int> positionNodes;
+
+    // the number of edges at each vertex, counting both ends, and in all
+    std::vector<int> degrees(numVertices, 0);
+    int numEdges = 0;
+
+    // the vertices of the tree being hung, doubling as the search's queue
+    std::vector<int>& treeVertices = searchQueues[0];
+
+    /*-------------------------------------------------------------------------------------*
+     *   copy the edges                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    clear();
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        for (int edge = edgeBegins[vertex]; edge < edgeEnds[vertex]; edge++) {
+            degrees[vertex]++;
+            degrees[edgeTargets[edge]] += (edgeTargets[edge] != vertex);
+            numEdges++;
+        }
+    }
+    nodes.reserve(numVertices + numEdges);
+    edges.reserve(numVertices + numEdges);
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        addVertex();
+        incidentEdges[vertex].reserve(degrees[vertex]);
+    }
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        if (edgeEnds[vertex] > (int)positionNodes.size()) {
+            positionNodes.resize(edgeEnds[vertex], -1);
+        }
+        for (int edge = edgeBegins[vertex]; edge < edgeEnds[vertex]; edge++) {
+            positionNodes[edge] = newEdge(vertex, edgeTargets[edge], edgeCosts[edge]);
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   hang each tree of the forest from its first vertex                                *
+     *-------------------------------------------------------------------------------------*/
+    for (int position : treeEdgePositions) {
+        edges[positionNodes[position]].inTree = true;
+        treeCost += (unsigned int)edges[positionNodes[position]].cost;
+        numTreeEdges++;
+    }
+    for (int rootVertex = 0; rootVertex < numVertices; rootVertex++) {
+        if (searchSides[rootVertex]) {
+            continue;
+        }
+        searchSides[rootVertex] = 1;
+        treeVertices.assign(1, rootVertex);
+        for (size_t queueFront = 0; queueFront < treeVertices.size(); queueFront++) {
+            int vertex = treeVertices[queueFront];
+            for (int edge : incidentEdges[vertex]) {
+                int toVertex = otherEnd(edge, vertex);
+                if (edges[edge].inTree && !searchSides[toVertex]) {
+                    searchSides[toVertex] = 1;
+                    nodes[edge].parent = vertexNodes[vertex];
+                    nodes[vertexNodes[toVertex]].parent = edge;
+                    treeVertices.push_back(toVertex);
+                }
+            }
+        }
+    }
+    std::fill(searchSides.begin(), searchSides.end(), 0);
+    built = true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: clear()                                                            *
+ *                                                                                     *
+ *   description: drops the forest and the edges copied for it                         *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::clear() {
+
+    built = false;
+    treeCost = 0;
+    numTreeEdges = 0;
+    std::vector<ForestNode>().swap(nodes);
+    std::vector<ForestEdge>().swap(edges);
+    std::vector<int>().swap(freeNodes);
+    std::vector<int>().swap(vertexNodes);
+    std::vector< std::vector<int> >().swap(incidentEdges);
+    std::vector<char>().swap(searchSides);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: addVertex()                                                        *
+ *                                                                                     *
+ *   description: adds a vertex with no edges, which is a tree of its own              *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::addVertex() {
+
+    vertexNodes.push_back((int)nodes.size());
+    nodes.push_back(ForestNode{ -1, { -1, -1 }, -1, false });
+    edges.push_back(ForestEdge{ -1, -1, 0, false, { -1, -1 } });
+    incidentEdges.emplace_back();
+    searchSides.push_back(0);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: insertEdge(int, int, int)                                          *
+ *                                                                                     *
+ *   description: stores the edge and offers it to the forest                          *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::insertEdge(int fromVertex, int toVertex, int cost) {
+
+    offerEdge(newEdge(fromVertex, toVertex, cost));
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: removeEdge(int, int, int)                                          *
+ *                                                                                     *
+ *   description: removes the edge. a copy outside the forest is taken if there is     *
+ *                one, which leaves the forest as it is; otherwise the edge is cut     *
+ *                out of the forest and the two halves are joined again                *
+ *                                                                                     *
+ *   returns: true if the edge was removed. false if there is no such edge             *
+ *-------------------------------------------------------------------------------------*/
+bool DynamicSpanningForest::removeEdge(int fromVertex, int toVertex, int cost) {
+
+    // the node of the edge being removed
+    int edge = findEdge(fromVertex, toVertex, cost);
+
+    if (edge == -1) {
+        return false;
+    }
+
+    if (edges[edge].inTree) {
+        cutEdge(edge);
+        deleteEdge(edge);
+        reconnect(fromVertex, toVertex);
+    }
+    else {
+        deleteEdge(edge);
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: updateEdgeCost(int, int, int, int)                                 *
+ *                                                                                     *
+ *   description: changes the cost of the edge. a forest edge that gets cheaper stays  *
+ *                and only its path maximum is recomputed; one that gets dearer is cut *
+ *                out and the two halves are joined by the cheapest edge between them, *
+ *                which may be the same edge. an edge outside the forest that gets     *
+ *                cheaper is offered to it; one that gets dearer stays out.            *
+ *                                                                                     *
+ *   returns: true if the edge was changed. false if there is no such edge             *
+ *-------------------------------------------------------------------------------------*/
+bool DynamicSpanningForest::updateEdgeCost(int fromVertex, int toVertex, int oldCost, int newCost) {
+
+    // the node of the edge being changed
+    int edge = findEdge(fromVertex, toVertex, oldCost);
+
+    if (edge == -1) {
+        return false;
+    }
+
+    if (!edges[edge].inTree) {
+        edges[edge].cost = newCost;
+        if (newCost < oldCost) {
+            offerEdge(edge);
+        }
+    }
+    else if (newCost < oldCost) {
+        access(edge);
+        edges[edge].cost = newCost;
+        pullUp(edge);
+        treeCost += (unsigned int)newCost - (unsigned int)oldCost;
+    }
+    else if (newCost > oldCost) {
+        cutEdge(edge);
+        edges[edge].cost = newCost;
+        reconnect(fromVertex, toVertex);
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: listTreeEdges(vector<tuple<int, int, int>>)                        *
+ *                                                                                     *
+ *   description: collects the edges of the forest and sorts them by cost, from        *
+ *                vertex and to vertex                                                 *
+ *                                                                                     *
+ *   returns: n/a. the edges are left in treeEdges                                     *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::listTreeEdges(std::vector< std::tuple<int, int, int> >& treeEdges) const {
+
+    treeEdges.clear();
+    treeEdges.reserve(numTreeEdges);
+    for (const ForestEdge& curEdge : edges) {
+        if (curEdge.inTree) {
+            treeEdges.emplace_back(curEdge.cost, curEdge.fromVertex, curEdge.toVertex);
+        }
+    }
+    std::sort(treeEdges.begin(), treeEdges.end());
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: edgeLess(int, int)                                                 *
+ *                                                                                     *
+ *   description: orders edges by cost, then from vertex, to vertex and node, so no    *
+ *                two edges tie and the minimum spanning forest is unique              *
+ *                                                                                     *
+ *   returns: true if firstEdge comes before secondEdge                                *
+ *-------------------------------------------------------------------------------------*/
+bool DynamicSpanningForest::edgeLess(int firstEdge, int secondEdge) const {
+
+    const ForestEdge& first = edges[firstEdge];
+    const ForestEdge& second = edges[secondEdge];
+
+    return std::tie(first.cost, first.fromVertex, first.toVertex, firstEdge)
+        < std::tie(second.cost, second.fromVertex, second.toVertex, secondEdge);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: newEdge(int, int, int)                                             *
+ *                                                                                     *
+ *   description: stores an edge outside the forest in a free node, or a new one, and  *
+ *                adds it to the incident edges of both its ends                       *
+ *                                                                                     *
+ *   returns: the node of the edge                                                     *
+ *-------------------------------------------------------------------------------------*/
+int DynamicSpanningForest::newEdge(int fromVertex, int toVertex, int cost) {
+
+    // the node the edge is stored in
+    int edge;
+
+    if (!freeNodes.empty()) {
+        edge = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else {
+        edge = (int)nodes.size();
+        nodes.emplace_back();
+        edges.emplace_back();
+    }
+    nodes[edge] = ForestNode{ -1, { -1, -1 }, edge, false };
+    edges[edge] = ForestEdge{ fromVertex, toVertex, cost, false, { (int)incidentEdges[fromVertex].size(), -1 } };
+    incidentEdges[fromVertex].push_back(edge);
+    if (toVertex != fromVertex) {
+        edges[edge].incidentPositions[1] = (int)incidentEdges[toVertex].size();
+        incidentEdges[toVertex].push_back(edge);
+    }
+
+    return edge;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: deleteEdge(int)                                                    *
+ *                                                                                     *
+ *   description: takes an edge outside the forest off the incident edges of its ends, *
+ *                moving the last edge of each list into its place, and frees its node *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::deleteEdge(int edge) {
+
+    for (int end = 0; end < 2; end++) {
+        int vertex = (end == 0) ? edges[edge].fromVertex : edges[edge].toVertex;
+        int position = edges[edge].incidentPositions[end];
+        if (position == -1) {
+            continue;
+        }
+
+        // the edge moved into the freed position, and which end of it this vertex is
+        int movedEdge = incidentEdges[vertex].back();
+        int movedEnd = (edges[movedEdge].fromVertex == vertex && edges[movedEdge].incidentPositions[0] == (int)incidentEdges[vertex].size() - 1)
+            ? 0 : 1;
+        incidentEdges[vertex][position] = movedEdge;
+        edges[movedEdge].incidentPositions[movedEnd] = position;
+        incidentEdges[vertex].pop_back();
+    }
+    edges[edge].fromVertex = -1;
+    freeNodes.push_back(edge);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: findEdge(int, int, int)                                            *
+ *                                                                                     *
+ *   description: searches the incident edges of fromVertex for the edge. copies       *
+ *                outside the forest are preferred, since removing or changing one of  *
+ *                them is cheaper and leaves the same forest                           *
+ *                                                                                     *
+ *   returns: the node of the edge, or -1 if there is none                             *
+ *-------------------------------------------------------------------------------------*/
+int DynamicSpanningForest::findEdge(int fromVertex, int toVertex, int cost) const {
+
+    // a matching edge in the forest, kept in case there is none outside it
+    int treeEdge = -1;
+
+    for (int edge : incidentEdges[fromVertex]) {
+        const ForestEdge& curEdge = edges[edge];
+        if (curEdge.fromVertex == fromVertex && curEdge.toVertex == toVertex && curEdge.cost == cost) {
+            if (!curEdge.inTree) {
+                return edge;
+            }
+            treeEdge = edge;
+        }
+    }
+
+    return treeEdge;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: isSplayRoot(int)                                                   *
+ *                                                                                     *
+ *   description: a node tops its splay tree if it has no parent, or its parent is     *
+ *                only a path parent that does not hold it as a child                  *
+ *                                                                                     *
+ *   returns: true if node is the root of its splay tree                               *
+ *-------------------------------------------------------------------------------------*/
+bool DynamicSpanningForest::isSplayRoot(int node) const {
+
+    int parent = nodes[node].parent;
+
+    return parent == -1 || (nodes[parent].children[0] != node && nodes[parent].children[1] != node);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: pushDown(int)                                                      *
+ *                                                                                     *
+ *   description: carries out a pending reversal of node's splay subtree one level     *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::pushDown(int node) {
+
+    ForestNode& curNode = nodes[node];
+
+    if (curNode.reversed) {
+        std::swap(curNode.children[0], curNode.children[1]);
+        for (int child : curNode.children) {
+            if (child != -1) {
+                nodes[child].reversed = !nodes[child].reversed;
+            }
+        }
+        curNode.reversed = false;
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: pullUp(int)                                                        *
+ *                                                                                     *
+ *   description: sets the most costly edge of node's splay subtree to the most costly *
+ *                of node itself, if it is an edge, and its children's                 *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::pullUp(int node) {
+
+    // the most costly edge found so far
+    int maxEdge = isEdgeNode(node) ? node : -1;
+
+    for (int child : nodes[node].children) {
+        if (child != -1 && nodes[child].maxEdge != -1 && (maxEdge == -1 || edgeLess(maxEdge, nodes[child].maxEdge))) {
+            maxEdge = nodes[child].maxEdge;
+        }
+    }
+    nodes[node].maxEdge = maxEdge;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: rotate(int)                                                        *
+ *                                                                                     *
+ *   description: moves node above its parent, keeping the in-order sequence of the    *
+ *                splay tree. a path parent pointer on the old parent moves to node    *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::rotate(int node) {
+
+    int parent = nodes[node].parent;
+    int grandparent = nodes[parent].parent;
+    int side = (nodes[parent].children[1] == node) ? 1 : 0;
+    int innerChild = nodes[node].children[1 - side];
+
+    if (!isSplayRoot(parent)) {
+        nodes[grandparent].children[(nodes[grandparent].children[1] == parent) ? 1 : 0] = node;
+    }
+    nodes[node].parent = grandparent;
+
+    nodes[node].children[1 - side] = parent;
+    nodes[parent].parent = node;
+
+    nodes[parent].children[side] = innerChild;
+    if (innerChild != -1) {
+        nodes[innerChild].parent = parent;
+    }
+
+    pullUp(parent);
+    pullUp(node);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: splay(int)                                                         *
+ *                                                                                     *
+ *   description: carries out the pending reversals from the top of node's splay tree  *
+ *                down to node, then rotates node to the top two levels at a time      *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::splay(int node) {
+
+    splayPath.clear();
+    splayPath.push_back(node);
+    for (int ancestor = node; !isSplayRoot(ancestor); ancestor = nodes[ancestor].parent) {
+        splayPath.push_back(nodes[ancestor].parent);
+    }
+    for (int position = (int)splayPath.size() - 1; position >= 0; position--) {
+        pushDown(splayPath[position]);
+    }
+
+    while (!isSplayRoot(node)) {
+        int parent = nodes[node].parent;
+        if (!isSplayRoot(parent)) {
+            int grandparent = nodes[parent].parent;
+            bool sameSide = (nodes[grandparent].children[0] == parent) == (nodes[parent].children[0] == node);
+            rotate(sameSide ? parent : node);
+        }
+        rotate(node);
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: access(int)                                                        *
+ *                                                                                     *
+ *   description: walks up from node, making each splay tree on the way end at the one *
+ *                below it, so the path from the root of the tree down to node becomes *
+ *                one splay tree with node at its top                                  *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::access(int node) {
+
+    // the splay tree of the path below the current node
+    int below = -1;
+
+    for (int current = node; current != -1; current = nodes[current].parent) {
+        splay(current);
+        nodes[current].children[1] = below;
+        pullUp(current);
+        below = current;
+    }
+    splay(node);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: makeRoot(int)                                                      *
+ *                                                                                     *
+ *   description: makes node the root of its tree by turning its root path around      *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::makeRoot(int node) {
+
+    access(node);
+    nodes[node].reversed = !nodes[node].reversed;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: findRoot(int)                                                      *
+ *                                                                                     *
+ *   description: the root is the first node of node's root path, which is the         *
+ *                leftmost node of its splay tree after an access                      *
+ *                                                                                     *
+ *   returns: the root of node's tree                                                  *
+ *-------------------------------------------------------------------------------------*/
+int DynamicSpanningForest::findRoot(int node) {
+
+    access(node);
+    pushDown(node);
+    while (nodes[node].children[0] != -1) {
+        node = nodes[node].children[0];
+        pushDown(node);
+    }
+    splay(node);
+
+    return node;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: link(int, int)                                                     *
+ *                                                                                     *
+ *   description: makes firstNode the root of its tree and hangs it below secondNode   *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::link(int firstNode, int secondNode) {
+
+    makeRoot(firstNode);
+    nodes[firstNode].parent = secondNode;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: cut(int, int)                                                      *
+ *                                                                                     *
+ *   description: with firstNode the root and secondNode accessed, the root path is    *
+ *                just the two of them, firstNode the left child of secondNode, so     *
+ *                dropping that child splits the tree                                  *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::cut(int firstNode, int secondNode) {
+
+    makeRoot(firstNode);
+    access(secondNode);
+    nodes[secondNode].children[0] = -1;
+    nodes[firstNode].parent = -1;
+    pullUp(secondNode);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: linkEdge(int)                                                      *
+ *                                                                                     *
+ *   description: joins the edge's node to the nodes of both its ends                  *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::linkEdge(int edge) {
+
+    link(edge, vertexNodes[edges[edge].fromVertex]);
+    link(vertexNodes[edges[edge].toVertex], edge);
+    edges[edge].inTree = true;
+    treeCost += (unsigned int)edges[edge].cost;
+    numTreeEdges++;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: cutEdge(int)                                                       *
+ *                                                                                     *
+ *   description: splits the edge's node from the nodes of both its ends               *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::cutEdge(int edge) {
+
+    cut(vertexNodes[edges[edge].fromVertex], edge);
+    cut(edge, vertexNodes[edges[edge].toVertex]);
+    edges[edge].inTree = false;
+    treeCost -= (unsigned int)edges[edge].cost;
+    numTreeEdges--;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: offerEdge(int)                                                     *
+ *                                                                                     *
+ *   description: an edge between two trees joins them. an edge within one tree closes *
+ *                a cycle with the path between its ends, and replaces the most costly *
+ *                edge on that path if it is cheaper; otherwise it stays out. a loop   *
+ *                always stays out.                                                    *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::offerEdge(int edge) {
+
+    // the nodes of the edge's ends
+    int fromNode = vertexNodes[edges[edge].fromVertex];
+    int toNode = vertexNodes[edges[edge].toVertex];
+
+    // the most costly edge on the path between the ends
+    int maxEdge;
+
+    if (fromNode == toNode) {
+        return;
+    }
+
+    if (findRoot(fromNode) != findRoot(toNode)) {
+        linkEdge(edge);
+        return;
+    }
+
+    makeRoot(fromNode);
+    access(toNode);
+    maxEdge = nodes[toNode].maxEdge;
+    if (edgeLess(edge, maxEdge)) {
+        cutEdge(maxEdge);
+        linkEdge(edge);
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: reconnect(int, int)                                                *
+ *                                                                                     *
+ *   description: searches the two halves of the split tree at the same pace, one      *
+ *                vertex from each in turn, along forest edges. the first half to run  *
+ *                out is no larger than twice the other, and every edge leaving it     *
+ *                goes to the other half, so the cheapest edge at its vertices that    *
+ *                ends outside it is the cheapest way to join them again               *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicSpanningForest::reconnect(int firstVertex, int secondVertex) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // how far each search has got through its queue
+    size_t queueFronts[2] = { 0, 0 };
+
+    // the search that ran out first, whose half is searched for the joining edge
+    int smallerSide = -1;
+
+    // the cheapest edge joining the halves found so far
+    int bestEdge = -1;
+
+    /*-------------------------------------------------------------------------------------*
+     *   find the smaller half                                                             *
+     *-------------------------------------------------------------------------------------*/
+    searchQueues[0].assign(1, firstVertex);
+    searchQueues[1].assign(1, secondVertex);
+    searchSides[firstVertex] = 1;
+    searchSides[secondVertex] = 2;
+    while (smallerSide == -1) {
+        for (int side = 0; side < 2 && smallerSide == -1; side++) {
+            if (queueFronts[side] == searchQueues[side].size()) {
+                smallerSide = side;
+                continue;
+            }
+            int vertex = searchQueues[side][queueFronts[side]++];
+            for (int edge : incidentEdges[vertex]) {
+                int toVertex = otherEnd(edge, vertex);
+                if (edges[edge].inTree && searchSides[toVertex] == 0) {
+                    searchSides[toVertex] = (char)(side + 1);
+                    searchQueues[side].push_back(toVertex);
+                }
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   find the cheapest edge out of it and rejoin the halves                            *
+     *-------------------------------------------------------------------------------------*/
+    for (int vertex : searchQueues[smallerSide]) {
+        for (int edge : incidentEdges[vertex]) {
+            if (!edges[edge].inTree && searchSides[otherEnd(edge, vertex)] != smallerSide + 1
+                && (bestEdge == -1 || edgeLess(edge, bestEdge))) {
+                bestEdge = edge;
+            }
+        }
+    }
+    for (int side = 0; side < 2; side++) {
+        for (int vertex : searchQueues[side]) {
+            searchSides[vertex] = 0;
+        }
+    }
+    if (bestEdge != -1) {
+        linkEdge(bestEdge);
+    }
+}
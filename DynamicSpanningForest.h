@@ -0,0 +1,271 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: DynamicSpanningForest.h                                                     *
+ *                                                                                     *
+ *   Desc: header file for a minimum spanning forest that is kept up to date as edges  *
+ *         are inserted, removed and change cost. the forest lives in a link-cut tree, *
+ *         which answers the most costly edge on the path between two vertices in      *
+ *         amortized O(log V): a new or cheaper edge replaces that edge if it beats    *
+ *         it. when a tree edge is removed or gets dearer, the smaller of the two      *
+ *         halves it leaves is searched for the cheapest edge joining them again, so   *
+ *         that costs the degrees of the smaller half rather than the whole graph.     *
+ *         ties between equal costs are broken by from vertex and to vertex, as in     *
+ *         Graph::minimumSpanningTree, so both find the same edges.                    *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef DYNAMIC_SPANNING_FOREST_H_
+#define DYNAMIC_SPANNING_FOREST_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<tuple>
+#include<vector>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: DynamicSpanningForest                                                      *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        build                                                                        *
+ *        clear                                                                        *
+ *        isBuilt                                                                      *
+ *        addVertex                                                                    *
+ *        insertEdge                                                                   *
+ *        removeEdge                                                                   *
+ *        updateEdgeCost                                                               *
+ *        totalCost                                                                    *
+ *        numTrees                                                                     *
+ *        listTreeEdges                                                                *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private structs:                                                               *
+ *         ForestNode                                                                  *
+ *         ForestEdge                                                                  *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         built                                                                       *
+ *         nodes                                                                       *
+ *         edges                                                                       *
+ *         freeNodes                                                                   *
+ *         vertexNodes                                                                 *
+ *         incidentEdges                                                               *
+ *         treeCost                                                                    *
+ *         numTreeEdges                                                                *
+ *         searchSides                                                                 *
+ *         searchQueues                                                                *
+ *         splayPath                                                                   *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         isEdgeNode                                                                  *
+ *         edgeLess                                                                    *
+ *         otherEnd                                                                    *
+ *         newEdge                                                                     *
+ *         deleteEdge                                                                  *
+ *         findEdge                                                                    *
+ *         isSplayRoot                                                                 *
+ *         pushDown                                                                    *
+ *         pullUp                                                                      *
+ *         rotate                                                                      *
+ *         splay                                                                       *
+ *         access                                                                      *
+ *         makeRoot                                                                    *
+ *         findRoot                                                                    *
+ *         link                                                                        *
+ *         cut                                                                         *
+ *         linkEdge                                                                    *
+ *         cutEdge                                                                     *
+ *         offerEdge                                                                   *
+ *         reconnect                                                                   *
+ *-------------------------------------------------------------------------------------*/
+class DynamicSpanningForest {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private structs                                                                   *
+         *-------------------------------------------------------------------------------------*/
+        /* a node of the link-cut tree. each vertex has one, and so does each edge, linked between its two
+           ends while it is in the forest, so the most costly edge on a path is the most costly node on it */
+        struct ForestNode {
+            // the parent in the splay tree, or the path parent if this is the root of its splay tree. -1 if none
+            int parent;
+
+            // the left and right children in the splay tree, -1 if none
+            int children[2];
+
+            // the most costly edge node in this node's splay subtree, -1 if there is none
+            int maxEdge;
+
+            // true if the children of every node in this splay subtree are still to be swapped
+            bool reversed;
+        };
+
+        /* an edge of the graph, kept at the same index as its node. unused for the nodes of vertices */
+        struct ForestEdge {
+            // the vertex the edge leaves, or -1 for the node of a vertex, and the vertex it goes to
+            int fromVertex;
+            int toVertex;
+
+            // the cost of the edge
+            int cost;
+
+            // true if the edge is in the forest
+            bool inTree;
+
+            // where the edge sits in the incident edges of fromVertex and of toVertex. -1 at toVertex for a loop,
+            // which is only listed at fromVertex
+            int incidentPositions[2];
+        };
+
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // true once the forest is built. false again after clear
+        bool built;
+
+        // the link-cut tree nodes of the vertices and edges, and the edges at the same indices
+        std::vector<ForestNode> nodes;
+        std::vector<ForestEdge> edges;
+
+        // the nodes of removed edges, handed out again before the arrays grow
+        std::vector<int> freeNodes;
+
+        // the node of each vertex
+        std::vector<int> vertexNodes;
+
+        // the nodes of the edges at each vertex, in the forest or not
+        std::vector< std::vector<int> > incidentEdges;
+
+        // the total cost of the edges in the forest, wrapping like MinimumSpanningTree::totalCost, and how many there are
+        unsigned int treeCost;
+        int numTreeEdges;
+
+        /* only used while reconnecting the two halves of a tree */
+        // 1 or 2 for the vertices reached from each end of the removed edge, 0 for the rest. reset before returning
+        std::vector<char> searchSides;
+
+        // the vertices reached from each end, in the order they were reached
+        std::vector<int> searchQueues[2];
+
+        /* only used while splaying */
+        // the nodes from the one being splayed up to the root of its splay tree
+        std::vector<int> splayPath;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // returns true if node is the node of an edge rather than a vertex
+        bool isEdgeNode(int node) const { return edges[node].fromVertex != -1; }
+
+        // returns true if edge firstEdge is cheaper than secondEdge, comparing cost, from vertex, to vertex and node
+        bool edgeLess(int firstEdge, int secondEdge) const;
+
+        // returns the end of edge that is not vertex
+        int otherEnd(int edge, int vertex) const { return (edges[edge].fromVertex == vertex) ? edges[edge].toVertex : edges[edge].fromVertex; }
+
+        // stores an edge outside the forest and lists it at its ends. returns its node
+        int newEdge(int fromVertex, int toVertex, int cost);
+
+        // takes an edge outside the forest off the lists of its ends and frees its node
+        void deleteEdge(int edge);
+
+        // returns the node of an edge fromVertex -> toVertex with the given cost, preferring one outside the
+        // forest, or -1 if there is none
+        int findEdge(int fromVertex, int toVertex, int cost) const;
+
+        /* the link-cut tree */
+        // returns true if node is the root of its splay tree
+        bool isSplayRoot(int node) const;
+
+        // swaps the children of node if it is marked reversed, passing the mark on to them
+        void pushDown(int node);
+
+        // recomputes the most costly edge of node's splay subtree from its children
+        void pullUp(int node);
+
+        // moves node above its parent in the splay tree
+        void rotate(int node);
+
+        // moves node to the root of its splay tree
+        void splay(int node);
+
+        // makes the path from the root of node's tree down to node preferred and splays node to its top
+        void access(int node);
+
+        // makes node the root of its tree
+        void makeRoot(int node);
+
+        // returns the root of node's tree
+        int findRoot(int node);
+
+        // joins the trees of two nodes with an edge between them. they must be in different trees
+        void link(int firstNode, int secondNode);
+
+        // splits the tree between two nodes joined by an edge
+        void cut(int firstNode, int secondNode);
+
+        /* the forest */
+        // adds an edge outside the forest to it, between its two ends
+        void linkEdge(int edge);
+
+        // takes an edge in the forest out of it
+        void cutEdge(int edge);
+
+        // adds an edge outside the forest to it if it joins two trees or beats the most costly edge on the
+        // path between its ends, which then leaves the forest
+        void offerEdge(int edge);
+
+        // joins the trees of firstVertex and secondVertex, just split by removing a forest edge between them,
+        // with the cheapest edge between the smaller one and the other, if there is one
+        void reconnect(int firstVertex, int secondVertex);
+
+    public:
+        // constructor
+        DynamicSpanningForest() : built(false), treeCost(0), numTreeEdges(0) {}
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // copies the graph given as CSR arrays and starts from the minimum spanning forest whose edges are at
+        // treeEdgePositions: the edges leaving vertex v go to edgeTargets[edgeBegins[v]] through
+        // edgeTargets[edgeEnds[v] - 1] at the costs in edgeCosts. the forest must break ties the same way
+        void build(int numVertices, const int* edgeBegins, const int* edgeEnds, const int* edgeTargets, const int* edgeCosts,
+            const std::vector<int>& treeEdgePositions);
+
+        // drops the forest
+        void clear();
+
+        // returns true if the forest is built
+        bool isBuilt() const { return built; }
+
+        // adds a vertex with no edges, a tree of its own
+        void addVertex();
+
+        // inserts the edge fromVertex -> toVertex, swapping it into the forest if it belongs there.
+        // amortized O(log V)
+        void insertEdge(int fromVertex, int toVertex, int cost);
+
+        // removes one edge fromVertex -> toVertex of the given cost, finding a replacement if it was in the
+        // forest. returns false if there is no such edge
+        bool removeEdge(int fromVertex, int toVertex, int cost);
+
+        // changes the cost of one edge fromVertex -> toVertex from oldCost to newCost, swapping edges in or out
+        // of the forest as needed. returns false if there is no such edge
+        bool updateEdgeCost(int fromVertex, int toVertex, int oldCost, int newCost);
+
+        // returns the total cost of the forest
+        unsigned int totalCost() const { return treeCost; }
+
+        // returns the number of trees in the forest. 1 if the graph is connected
+        int numTrees() const { return (int)vertexNodes.size() - numTreeEdges; }
+
+        // fills treeEdges with the (cost, from vertex, to vertex) of each edge of the forest, cheapest first,
+        // which is the order Kruskal's algorithm would add them in
+        void listTreeEdges(std::vector< std::tuple<int, int, int> >& treeEdges) const;
+};
+
+
+#endif
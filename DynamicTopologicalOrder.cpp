@@ -0,0 +1,347 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: DynamicTopologicalOrder.cpp                                                 *
+ *                                                                                     *
+ *   Desc: implementation file for the topological order kept up to date under edge    *
+ *         insertions                                                                  *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *   Functions:                                                                        *
+ *      build(int, int*, int*, int*)  ..  orders the graph with Kahn's algorithm       *
+ *      clear()  .......................  drops the order                              *
+ *      addVertex()  ...................  adds a vertex at the end of the order        *
+ *      insertEdge(int, int, vector<int>)  inserts an edge, reordering if needed       *
+ *      removeEdge(int, int)  ..........  removes an edge                              *
+ *      searchForward(int, int, int)  ..  finds the vertices the edge pushes later     *
+ *      searchBackward(int, int)  ......  finds the vertices the edge pulls earlier    *
+ *      reorder()  .....................  moves the two regions into place             *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include "DynamicTopologicalOrder.h"
+#include<algorithm>
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function implementations                                                          *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: build(int, int*, int*, int*)                                       *
+ *                                                                                     *
+ *   description: copies the edges both ways and orders the vertices with Kahn's       *
+ *                algorithm                                                            *
+ *                                                                                     *
+ *   returns: true if the graph is acyclic. false, leaving the order empty, otherwise  *
+ *-------------------------------------------------------------------------------------*/
+bool DynamicTopologicalOrder::build(int numVertices, const int* edgeBegins, const int* edgeEnds, const int* edgeTargets) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the number of edges into each vertex from vertices not yet ordered
+    std::vector<int> inDegrees(numVertices, 0);
+
+    /*-------------------------------------------------------------------------------------*
+     *   copy the edges                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    clear();
+    outEdges.assign(numVertices, std::vector<int>());
+    inEdges.assign(numVertices, std::vector<int>());
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        outEdges[vertex].assign(edgeTargets + edgeBegins[vertex], edgeTargets + edgeEnds[vertex]);
+        for (int edge = edgeBegins[vertex]; edge < edgeEnds[vertex]; edge++) {
+            inEdges[edgeTargets[edge]].push_back(vertex);
+            inDegrees[edgeTargets[edge]]++;
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   order the vertices                                                                *
+     *-------------------------------------------------------------------------------------*/
+    // the ordered vertices double as Kahn's queue
+    orderedVertices.reserve(numVertices);
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        if (inDegrees[vertex] == 0) {
+            orderedVertices.push_back(vertex);
+        }
+    }
+    for (size_t queueFront = 0; queueFront < orderedVertices.size(); queueFront++) {
+        for (int toVertex : outEdges[orderedVertices[queueFront]]) {
+            if (--inDegrees[toVertex] == 0) {
+                orderedVertices.push_back(toVertex);
+            }
+        }
+    }
+
+    // some vertex never lost its last edge, so it is on or after a cycle
+    if ((int)orderedVertices.size() != numVertices) {
+        clear();
+        return false;
+    }
+
+    positions.resize(numVertices);
+    for (int position = 0; position < numVertices; position++) {
+        positions[orderedVertices[position]] = position;
+    }
+    visited.assign(numVertices, 0);
+    searchParents.assign(numVertices, -1);
+    built = true;
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: clear()                                                            *
+ *                                                                                     *
+ *   description: drops the order and the edges copied for it                          *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicTopologicalOrder::clear() {
+
+    built = false;
+    std::vector<int>().swap(positions);
+    std::vector<int>().swap(orderedVertices);
+    std::vector< std::vector<int> >().swap(outEdges);
+    std::vector< std::vector<int> >().swap(inEdges);
+    std::vector<char>().swap(visited);
+    std::vector<int>().swap(searchParents);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: addVertex()                                                        *
+ *                                                                                     *
+ *   description: adds a vertex with no edges. any position would do, so it goes last  *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicTopologicalOrder::addVertex() {
+
+    positions.push_back((int)orderedVertices.size());
+    orderedVertices.push_back((int)outEdges.size());
+    outEdges.emplace_back();
+    inEdges.emplace_back();
+    visited.push_back(0);
+    searchParents.push_back(-1);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: insertEdge(int, int, vector<int>)                                  *
+ *                                                                                     *
+ *   description: inserts fromVertex -> toVertex. if fromVertex is already before      *
+ *                toVertex nothing moves. otherwise the affected region is the         *
+ *                positions from toVertex's up to fromVertex's: the vertices there     *
+ *                reachable from toVertex must end up after the ones that reach        *
+ *                fromVertex. the two sets are found by searches that never leave the  *
+ *                region, and are given back the positions they held, the ones         *
+ *                reaching fromVertex first, each set keeping its own relative order.  *
+ *                if the forward search reaches fromVertex, the edge would close a     *
+ *                cycle and the path it found is the rest of that cycle.               *
+ *                                                                                     *
+ *   returns: true if the edge was inserted. false if it would close a cycle           *
+ *-------------------------------------------------------------------------------------*/
+bool DynamicTopologicalOrder::insertEdge(int fromVertex, int toVertex, std::vector<int>& cycleVertices) {
+
+    cycleVertices.clear();
+
+    /*-------------------------------------------------------------------------------------*
+     *   reorder the affected region if the edge goes backward in the order               *
+     *-------------------------------------------------------------------------------------*/
+    if (fromVertex == toVertex) {
+        cycleVertices.push_back(fromVertex);
+        return false;
+    }
+
+    if (positions[fromVertex] > positions[toVertex]) {
+
+        // search forward from the edge's target, stopping at the edge's source
+        if (searchForward(toVertex, fromVertex, positions[fromVertex])) {
+
+            // the cycle is the new edge followed by the path found back to fromVertex
+            for (int vertex = fromVertex; vertex != toVertex; vertex = searchParents[vertex]) {
+                cycleVertices.push_back(vertex);
+            }
+            cycleVertices.push_back(toVertex);
+            std::reverse(cycleVertices.begin() + 1, cycleVertices.end());
+
+            // the search stopped early, so vertices still waiting on the stack were marked too
+            for (int vertex : forwardRegion) {
+                visited[vertex] = 0;
+            }
+            for (int vertex : searchStack) {
+                visited[vertex] = 0;
+            }
+            return false;
+        }
+
+        searchBackward(fromVertex, positions[toVertex]);
+        reorder();
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   add the edge                                                                      *
+     *-------------------------------------------------------------------------------------*/
+    outEdges[fromVertex].push_back(toVertex);
+    inEdges[toVertex].push_back(fromVertex);
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: removeEdge(int, int)                                               *
+ *                                                                                     *
+ *   description: removes one edge fromVertex -> toVertex. removing an edge never      *
+ *                breaks an order, so only the copied edges change                     *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicTopologicalOrder::removeEdge(int fromVertex, int toVertex) {
+
+    std::vector<int>& fromOutEdges = outEdges[fromVertex];
+    std::vector<int>::iterator outEdge = std::find(fromOutEdges.begin(), fromOutEdges.end(), toVertex);
+    if (outEdge == fromOutEdges.end()) {
+        return;
+    }
+    fromOutEdges.erase(outEdge);
+
+    std::vector<int>& toInEdges = inEdges[toVertex];
+    toInEdges.erase(std::find(toInEdges.begin(), toInEdges.end(), fromVertex));
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: searchForward(int, int, int)                                       *
+ *                                                                                     *
+ *   description: a depth first search from startVertex over the vertices at positions *
+ *                up to upperBound. nothing past fromVertex's position can need to     *
+ *                move, since the order already puts it after everything the edge      *
+ *                could push later. records each vertex's parent so a cycle can be     *
+ *                read back, and stops as soon as it reaches stopVertex.               *
+ *                                                                                     *
+ *   returns: true if stopVertex was reached                                           *
+ *-------------------------------------------------------------------------------------*/
+bool DynamicTopologicalOrder::searchForward(int startVertex, int stopVertex, int upperBound) {
+
+    forwardRegion.clear();
+    searchStack.clear();
+    searchStack.push_back(startVertex);
+    visited[startVertex] = 1;
+    searchParents[startVertex] = -1;
+
+    while (!searchStack.empty()) {
+        int vertex = searchStack.back();
+        searchStack.pop_back();
+        forwardRegion.push_back(vertex);
+
+        for (int toVertex : outEdges[vertex]) {
+            if (toVertex == stopVertex) {
+                searchParents[toVertex] = vertex;
+                return true;
+            }
+            if (!visited[toVertex] && positions[toVertex] < upperBound) {
+                visited[toVertex] = 1;
+                searchParents[toVertex] = vertex;
+                searchStack.push_back(toVertex);
+            }
+        }
+    }
+
+    return false;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: searchBackward(int, int)                                           *
+ *                                                                                     *
+ *   description: a depth first search against the edges from startVertex over the     *
+ *                vertices at positions of lowerBound or more. the two searches never  *
+ *                meet, since a vertex both reaches the source and is reached from the *
+ *                target only if the edge closes a cycle.                              *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicTopologicalOrder::searchBackward(int startVertex, int lowerBound) {
+
+    backwardRegion.clear();
+    searchStack.clear();
+    searchStack.push_back(startVertex);
+    visited[startVertex] = 1;
+
+    while (!searchStack.empty()) {
+        int vertex = searchStack.back();
+        searchStack.pop_back();
+        backwardRegion.push_back(vertex);
+
+        for (int fromVertex : inEdges[vertex]) {
+            if (!visited[fromVertex] && positions[fromVertex] > lowerBound) {
+                visited[fromVertex] = 1;
+                searchStack.push_back(fromVertex);
+            }
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: reorder()                                                          *
+ *                                                                                     *
+ *   description: sorts each region by its current positions, pools the positions the  *
+ *                two held, and hands them out in increasing order to the backward     *
+ *                region and then the forward one. every vertex outside the regions    *
+ *                keeps its position.                                                  *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void DynamicTopologicalOrder::reorder() {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // orders vertices by their current position
+    auto byPosition = [this](int lhs, int rhs) { return positions[lhs] < positions[rhs]; };
+
+    // the next pooled position to hand out
+    size_t nextPosition = 0;
+
+    /*-------------------------------------------------------------------------------------*
+     *   hand the positions back out                                                       *
+     *-------------------------------------------------------------------------------------*/
+    std::sort(backwardRegion.begin(), backwardRegion.end(), byPosition);
+    std::sort(forwardRegion.begin(), forwardRegion.end(), byPosition);
+
+    freedPositions.clear();
+    for (int vertex : backwardRegion) {
+        freedPositions.push_back(positions[vertex]);
+        visited[vertex] = 0;
+    }
+    for (int vertex : forwardRegion) {
+        freedPositions.push_back(positions[vertex]);
+        visited[vertex] = 0;
+    }
+    std::sort(freedPositions.begin(), freedPositions.end());
+
+    for (int vertex : backwardRegion) {
+        positions[vertex] = freedPositions[nextPosition++];
+        orderedVertices[positions[vertex]] = vertex;
+    }
+    for (int vertex : forwardRegion) {
+        positions[vertex] = freedPositions[nextPosition++];
+        orderedVertices[positions[vertex]] = vertex;
+    }
+}
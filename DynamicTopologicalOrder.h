@@ -0,0 +1,144 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: DynamicTopologicalOrder.h                                                   *
+ *                                                                                     *
+ *   Desc: header file for a topological order of a directed acyclic graph that is     *
+ *         kept up to date as edges are inserted, with the algorithm of Pearce and     *
+ *         Kelly. an edge that already agrees with the order costs O(1); otherwise     *
+ *         only the vertices whose position lies between the edge's two ends, and      *
+ *         that are reachable from one end or reach the other, are searched and        *
+ *         moved. an edge that would close a cycle is refused and the cycle reported.  *
+ *         on random insertions that region is small, but an edge against the order    *
+ *         that a long chain of edges already follows still moves the whole chain.     *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef DYNAMIC_TOPOLOGICAL_ORDER_H_
+#define DYNAMIC_TOPOLOGICAL_ORDER_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<vector>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: DynamicTopologicalOrder                                                    *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        build                                                                        *
+ *        clear                                                                        *
+ *        isBuilt                                                                      *
+ *        addVertex                                                                    *
+ *        insertEdge                                                                   *
+ *        removeEdge                                                                   *
+ *        position                                                                     *
+ *        order                                                                        *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         built                                                                       *
+ *         positions                                                                   *
+ *         orderedVertices                                                             *
+ *         outEdges                                                                    *
+ *         inEdges                                                                     *
+ *         visited                                                                     *
+ *         searchParents                                                               *
+ *         searchStack                                                                 *
+ *         forwardRegion                                                               *
+ *         backwardRegion                                                              *
+ *         freedPositions                                                              *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         searchForward                                                               *
+ *         searchBackward                                                              *
+ *         reorder                                                                     *
+ *-------------------------------------------------------------------------------------*/
+class DynamicTopologicalOrder {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // true once the order is built. false again after clear
+        bool built;
+
+        // the position of each vertex in the order
+        std::vector<int> positions;
+
+        // the vertex at each position of the order
+        std::vector<int> orderedVertices;
+
+        // the vertices each vertex has edges to and from, one entry per edge
+        std::vector< std::vector<int> > outEdges;
+        std::vector< std::vector<int> > inEdges;
+
+        /* only used while inserting an edge */
+        // whether each vertex was reached by the current searches. reset before returning
+        std::vector<char> visited;
+
+        // the vertex the forward search reached each vertex from, to report a cycle
+        std::vector<int> searchParents;
+
+        // the vertices waiting to be searched from
+        std::vector<int> searchStack;
+
+        // the vertices the forward search reached from the edge's target and the backward search from its source
+        std::vector<int> forwardRegion;
+        std::vector<int> backwardRegion;
+
+        // the positions the two regions held, handed back out in order
+        std::vector<int> freedPositions;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // collects in forwardRegion the vertices reachable from startVertex at positions up to upperBound.
+        // returns true if it reaches stopVertex, which means the edge being inserted would close a cycle
+        bool searchForward(int startVertex, int stopVertex, int upperBound);
+
+        // collects in backwardRegion the vertices that reach startVertex from positions of lowerBound or more
+        void searchBackward(int startVertex, int lowerBound);
+
+        // gives the vertices of both regions the positions they held, the backward region first
+        void reorder();
+
+    public:
+        // constructor
+        DynamicTopologicalOrder() : built(false) {}
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // orders the graph given as CSR arrays: the edges leaving vertex v go to edgeTargets[edgeBegins[v]]
+        // through edgeTargets[edgeEnds[v] - 1]. returns false, leaving the order empty, if the graph has a cycle
+        bool build(int numVertices, const int* edgeBegins, const int* edgeEnds, const int* edgeTargets);
+
+        // drops the order
+        void clear();
+
+        // returns true if the order is built
+        bool isBuilt() const { return built; }
+
+        // adds a vertex with no edges at the end of the order
+        void addVertex();
+
+        // inserts the edge fromVertex -> toVertex, moving vertices as needed to keep the order. if the edge
+        // would close a cycle it is not inserted, cycleVertices is filled with the cycle starting at fromVertex
+        // and followed by toVertex, and false is returned
+        bool insertEdge(int fromVertex, int toVertex, std::vector<int>& cycleVertices);
+
+        // removes one edge fromVertex -> toVertex. the order stays valid without changing
+        void removeEdge(int fromVertex, int toVertex);
+
+        // returns the position of a vertex in the order
+        int position(int vertexIndex) const { return positions[vertexIndex]; }
+
+        // returns the vertices in order
+        const std::vector<int>& order() const { return orderedVertices; }
+};
+
+
+#endif
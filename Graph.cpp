@@ -10,19 +10,66 @@
  *                                                                                                            *
  *   Functions:                                                                                               *
  *      readGraph(std::string)  .....................................  reads in new graph                     *
- *      getVertexIndex(std::string)  ................................  finds index of a vertex                *
- *      printGraph()  ...............................................  prints graph structure                 *
- *      computeTopologicalSort()  ...................................  computes and prints the sort           *
+ *      parseEdges(TokenScanner, VertexNameTable, int, vector<Edge>)   parses 'from to cost' triples          *
+ *      parseEdgeSectionInParallel(...)  ............................  parses the edges on a thread pool      *
+ *      foldMirroredEdges(vector<vector<Edge>>, bool)  ..............  keeps one copy of each undirected edge *
+ *      buildCompressedAdjacency(vector<vector<Edge>>)  .............  builds the CSR edge arrays             *
+ *      snapshotChecksum(const char*, size_t)  ......................  checksums part of a snapshot           *
+ *      saveSnapshot(std::string)  ..................................  writes a binary snapshot               *
+ *      loadSnapshot(std::string, bool)  ............................  maps a binary snapshot in place        *
+ *      makeEditable()  .............................................  prepares the arrays for edits          *
+ *      relocateEdges(int, int)  ....................................  gives a vertex room for more edges     *
+ *      compactEdges()  .............................................  packs the edge arrays                  *
+ *      findEdge(int, int)  .........................................  finds the position of an edge          *
+ *      addVertex(std::string)  .....................................  adds a vertex                          *
+ *      addEdge(std::string, std::string, int)  .....................  adds an edge                           *
+ *      addEdgeKeepingOrder(std::string, std::string, int, vector<int>)  adds an edge unless it makes a cycle *
+ *      appendEdge(int, int, int)  ..................................  stores an edge in the arrays           *
+ *      removeEdge(std::string, std::string)  .......................  removes an edge                        *
+ *      updateEdgeCost(std::string, std::string, int)  ..............  changes the cost of an edge            *
+ *      applyDeltaFile(std::string)  ................................  applies a batch of edits               *
+ *      topologicalSort()  ..........................................  computes the sort                      *
+ *      topologicalSortByLevels(int)  ...............................  computes the sort level by level       *
+ *      stronglyConnectedComponents()  ..............................  finds the components                   *
+ *      condensation()  .............................................  shrinks each component to a vertex     *
+ *      buildDynamicTopologicalOrder()  .............................  orders the graph for insertions        *
+ *      dynamicTopologicalSort()  ...................................  returns the order kept under edits     *
+ *      buildDynamicSpanningTree()  .................................  keeps a spanning tree under edits      *
  *      setupInDegreeVector()  ......................................  creates list of dependencies           *
- *      printTopologicalSortOutput(list<string>,int) ................  prints sort to screen                  *
- *      computeShortestPaths(std::string)  ..........................  calculates and prints paths            *
- *      printPathList(list<string>)  ................................  prints the list passed                 *
- *      printShortestPathsOutput(string, vector<PathVertex>) ........  prints output for computeShortestPaths *
+ *      shortestPathTree(std::string)  ..............................  calculates the paths from a vertex     *
+ *      computeShortestPathsBatch(vector<string>, int)  .............  computes many trees on a pool          *
+ *      copyShortestPathTree(int, vector<PathVertex>, ShortestPathTree)  copies a tree out of the scratch     *
+ *      computeAllPairsDistances(DistanceMatrix, bool, bool)  .......  computes the distance matrix           *
  *      buildPathRepresentation(vector<PathVertex>, priority_queue) .  builds the pathRepresentation vector   *
- *      computeMinimumSpanningTree()  ...............................  prints edges, weight of minimum tree   *
- *      populateEdgesList(list<Edge>)  ..............................  adds the edges of a graph to a list    *
- *      calculateSpanningTreeTotalCost(list<Edge>)  .................  calculates the total cost of the tree  *
- *      printMinimumSpanningTreeOutput(list<Edge>, unsigned int)  ...  prints the output for spanning tree    *
+ *      buildPathRepresentationWithIndexedHeap(vector<PathVertex>, int, IndexedHeap)  builds it with a heap   *
+ *      buildPathRepresentationWithBuckets(vector<PathVertex>, int, BucketQueue, ...)  builds it with buckets *
+ *      chooseShortestPathEngine()  .................................  picks the shortest path engine         *
+ *      buildPathRepresentationWithDeltaStepping(vector<PathVertex>, int, int)  builds it on many threads     *
+ *      growShortestPathTree(int, ShortestPathScratch, int)  ........  runs the chosen engine                 *
+ *      graphChanged()  .............................................  drops the cached trees                 *
+ *      shortestPath(std::string, std::string, PathQueryMode)  ......  finds one shortest path                *
+ *      buildReverseAdjacency()  ....................................  groups the edges by target             *
+ *      clearReverseAdjacency()  ....................................  drops the reverse adjacency            *
+ *      searchForward(int, int, PointToPointPath)  ..................  searches from the source only          *
+ *      searchBidirectional(int, int, PointToPointPath)  ............  searches from both ends                *
+ *      buildLandmarks(int)  ........................................  builds the landmark tables             *
+ *      computeDistances(int, bool, vector<int>)  ...................  finds the distances from one vertex    *
+ *      landmarkLowerBound(int, int)  ...............................  bounds a distance with the landmarks   *
+ *      clearLandmarks()  ...........................................  drops the landmark tables              *
+ *      searchWithLandmarks(int, int, PointToPointPath)  ............  runs A* with the landmark bounds       *
+ *      buildContractionHierarchy()  ................................  contracts the graph                    *
+ *      searchWithContractionHierarchy(int, int, PointToPointPath)  .  queries the contraction hierarchy      *
+ *      minimumSpanningTree()  ......................................  computes the minimum spanning tree     *
+ *      chooseSpanningTreeEngine()  .................................  picks the spanning tree engine         *
+ *      buildSpanningTreeWithKruskal(MinimumSpanningTree)  ..........  runs Kruskal's algorithm               *
+ *      buildSpanningTreeWithBoruvka(MinimumSpanningTree, int)  .....  runs Boruvka rounds on a pool          *
+ *      buildSpanningTreeWithPrim(MinimumSpanningTree)  .............  runs Prim's algorithm on a heap        *
+ *      buildSpanningTreeFromDynamicForest(MinimumSpanningTree)  ....  copies out the forest kept under edits *
+ *      sortEdgesForSpanningTree(vector<int>, vector<int>)  .........  orders the edges for Kruskal           *
+ *      listEdgesBySource(vector<int>, vector<int>)  ................  orders the edges by their ends         *
+ *      listIncidentEdges(vector<int>, vector<int>, vector<IncidentEdge>)  lists the edges at both ends       *
+ *                                                                                                            *
+ *   The functions that print the results are in GraphOutput.cpp                                              *
  *                                                                                                            *
  *------------------------------------------------------------------------------------------------------------*/
 
@@ -30,14 +77,73 @@
  *   header files                                                                      *
  *-------------------------------------------------------------------------------------*/
 #include "Graph.h"
+#include "MappedFile.h"
+#include "TokenScanner.h"
+#include "ThreadPool.h"
 #include<fstream>
-#include<iostream>
+#include<algorithm>
+#include<cstring>
+#include<cstdint>
 #include<queue>
+#include<atomic>
+#include<functional>
 
 /*-------------------------------------------------------------------------------------*
  *   constants                                                                         *
  *-------------------------------------------------------------------------------------*/
 const int END_OF_PATH = -1; // represents the end vertex when creating paths
+const int READ_ALL_EDGES = -1; // tells parseEdges to read every triple left in its scanner
+const long long MIN_PARALLEL_LOAD_BLOCK_BYTES = 1 << 20; // edge sections are only split into blocks at least this big
+const int BLOCKS_PER_LOAD_THREAD = 4; // how many blocks the edge section is split into per load thread
+const int MIN_EDGE_CAPACITY = 4; // the least room a vertex's edges get when its range is moved by addEdge
+const int MAX_DIAL_EDGE_COST = 1 << 16; // the largest cost AUTOMATIC uses Dial's buckets for, one bucket per distance
+const int MAX_DELTA_STEPPING_BUCKETS = 1 << 16; // the most buckets delta-stepping keeps; wider buckets are used past it
+const int MIN_PARALLEL_SEARCH_ITEMS = 1024; // delta-stepping and the level sort only hand out work when a phase has this many vertices
+const int BLOCKS_PER_SEARCH_THREAD = 4; // how many blocks such a phase is split into per thread
+const int SPANNING_TREE_RADIX_BITS = 11; // the bits of the cost sortEdgesForSpanningTree sorts on per pass
+const size_t SPANNING_TREE_INSERTION_SORT_EDGES = 32; // the longest run of a vertex's edges sortEdgesForSpanningTree sorts by insertion
+const int PRIM_MIN_AVERAGE_DEGREE = 32; // the edges per vertex from which AUTOMATIC_SPANNING_TREE runs Prim's algorithm
+
+/* binary snapshot format */
+const char SNAPSHOT_MAGIC[8] = {'G', 'R', 'P', 'H', 'S', 'N', 'A', 'P'}; // the first bytes of every snapshot
+const std::uint32_t SNAPSHOT_VERSION = 5; // bumped whenever the layout changes
+const std::uint32_t SNAPSHOT_BYTE_ORDER_MARK = 0x01020304; // reads differently on a machine of the other endianness
+const std::uint64_t SNAPSHOT_SECTION_ALIGNMENT = 64; // every section starts on a cache line
+const std::uint64_t SNAPSHOT_CHECKSUM_SEED = 0x9E3779B97F4A7C15ull; // starting value of snapshotChecksum
+const std::uint64_t SNAPSHOT_CHECKSUM_PRIME = 0x100000001B3ull; // multiplier of snapshotChecksum
+
+/* the sections of a snapshot, in file order */
+enum SnapshotSection {
+    SNAPSHOT_NAME_BLOB,
+    SNAPSHOT_NAME_OFFSETS,
+    SNAPSHOT_NAME_SLOTS,
+    SNAPSHOT_EDGE_BEGINS,
+    SNAPSHOT_EDGE_ENDS,
+    SNAPSHOT_EDGE_TARGETS,
+    SNAPSHOT_EDGE_COSTS,
+    SNAPSHOT_LANDMARK_VERTICES,
+    SNAPSHOT_LANDMARK_DISTANCES_FROM,
+    SNAPSHOT_LANDMARK_DISTANCES_TO,
+    NUM_SNAPSHOT_SECTIONS
+};
+
+/* the fixed size header at the start of a snapshot */
+struct SnapshotHeader {
+    char magic[8]; // SNAPSHOT_MAGIC
+    std::uint32_t version; // SNAPSHOT_VERSION
+    std::uint32_t byteOrderMark; // SNAPSHOT_BYTE_ORDER_MARK
+    std::uint64_t headerSize; // sizeof(SnapshotHeader)
+    std::int64_t numVertices; // the number of vertices in the graph
+    std::int64_t numEdges; // the number of edges in the graph
+    std::int32_t minEdgeCost; // the smallest edge cost seen since the graph was loaded
+    std::int32_t maxEdgeCost; // the largest edge cost seen since the graph was loaded
+    std::int32_t undirected; // 1 if each edge is stored once and goes both ways
+    std::int32_t padding; // zero, keeps the arrays below 8 byte aligned
+    std::uint64_t sectionOffsets[NUM_SNAPSHOT_SECTIONS]; // where each section starts in the file
+    std::uint64_t sectionSizes[NUM_SNAPSHOT_SECTIONS]; // the number of bytes in each section
+    std::uint64_t sectionChecksums[NUM_SNAPSHOT_SECTIONS]; // snapshotChecksum of each section
+    std::uint64_t headerChecksum; // snapshotChecksum of the header with this field zero
+};
 
 
 /*-------------------------------------------------------------------------------------*
@@ -47,71 +153,90 @@ const int END_OF_PATH = -1; // represents the end vertex when creating paths
 /*-------------------------------------------------------------------------------------*
  *   function name: readGraph(std::string)                                             *
  *                                                                                     *
- *   description: reads in a new graph replacing old graph                             *
+ *   description: reads in a new graph replacing old graph. the file is mapped into    *
+ *                memory and parsed in place, so vertex names and costs are read       *
+ *                straight from the file's bytes. a file that starts with the snapshot *
+ *                magic is handed to loadSnapshot instead. the graph is read as        *
+ *                undirected when setLoadDirection asks for it, or when it asks to     *
+ *                detect it and every edge is listed both ways.                        *
  *                                                                                     *
- *   returns: true if the file could be read. false otherwise                          *
+ *   returns: true if the file could be read. false if it could not be opened or is    *
+ *            not a valid graph file, in which case the old graph is kept              *
  *-------------------------------------------------------------------------------------*/
 bool Graph::readGraph(std::string fileName) {
 
     /*-------------------------------------------------------------------------------------*
      *   variables used                                                                    *
      *-------------------------------------------------------------------------------------*/
-    std::string curString; // the current line of the file being read
-    std::ifstream infile; // used to read the file to be read
-    std::string fromVertexName; // the name of the 'from' vertex being added to the graph
-    std::string toVertexName; // the name of the 'to' vertex being added to the graph
-    int fromVertexIndex; // the index of the 'from' vertex being added to the graph
-    int toVertexIndex; // the index of the 'to' vertex being added to the graph
-    int newEdgeCost; // the cost of the new edge being added to the graph
+    MappedFile graphFile; // the file being read, mapped into memory
+    std::string_view curToken; // the current vertex name being read
+    int newNumVertices; // the number of vertices in the new graph
+    int newNumEdges; // the number of edges in the new graph
+    VertexNameTable newVertexNames; // the names of the vertices in the new graph
+    std::vector< std::vector<Edge> > edgeBlocks; // the edges of the graph in file order, split into blocks
 
     /*-------------------------------------------------------------------------------------*
-     *   read in the file, delete the old graph, and create the new graph                  *
+     *   read in the file, then replace the old graph with the new graph                   *
      *-------------------------------------------------------------------------------------*/
-    // setting up to read the file
-    infile.open(fileName);
-
-    // make sure file is open. return false if could not be opened
-    if ( !infile.is_open() ) {
+    // map the file. return false if could not be opened
+    if ( !graphFile.open(fileName) ) {
         return false;
     }
 
-    // clear old graph
-    adjacencyList.clear();
-    vertexNameList.clear();
+    // a binary snapshot is loaded in place instead of parsed
+    if (graphFile.size() >= sizeof(SNAPSHOT_MAGIC) && std::memcmp(graphFile.data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0) {
+        graphFile.close();
+        return loadSnapshot(fileName);
+    }
+
+    // the tokens are scanned straight out of the mapped bytes
+    TokenScanner scanner(graphFile.data(), graphFile.data() + graphFile.size());
 
     // get the number of vertices
-    infile >> numVertices;
+    if ( !scanner.nextInt(newNumVertices) || newNumVertices < 0 ) {
+        return false;
+    }
+
+    // size the name table using newNumVertices
+    newVertexNames.reserve(newNumVertices);
 
-    // create lists using the numVertices as the size
-    adjacencyList.resize(numVertices);
-    vertexNameList.resize(numVertices);
-    
-    // add each vertex name to vertexNameList
-    for (int i = 0; i < numVertices; i++) {
-        infile >> curString;
-        vertexNameList[i] = curString;
+    // add each vertex name to newVertexNames. a repeated name makes the file invalid
+    for (int i = 0; i < newNumVertices; i++) {
+        if ( !scanner.nextToken(curToken) || newVertexNames.insert(curToken) == -1 ) {
+            return false;
+        }
     }
 
     // get the number of edges
-    infile >> numEdges;
+    if ( !scanner.nextInt(newNumEdges) || newNumEdges < 0 ) {
+        return false;
+    }
 
-    /* cycle through file edges, get data needed for edge and add edge to the ajdacency list */
-    for (int i = 0; i < numEdges; i++) {
-        // get the pieces of data we need to add a new edge to the adjacency list
-        infile >> fromVertexName;
-        infile >> toVertexName;
-        infile >> newEdgeCost;
+    /* parse the edge section on the load threads. if that is not possible, or the section does not
+       hold exactly newNumEdges one-per-line edges, parse it serially instead */
+    if ( !parseEdgeSectionInParallel(scanner.position(), graphFile.data() + graphFile.size(), newVertexNames, newNumEdges, edgeBlocks) ) {
+        edgeBlocks.assign(1, std::vector<Edge>());
+        if ( !parseEdges(scanner, newVertexNames, newNumEdges, edgeBlocks[0]) ) {
+            return false;
+        }
+    }
 
-        // find the indices of the vertices involved
-        fromVertexIndex = getVertexIndex(fromVertexName);
-        toVertexIndex = getVertexIndex(toVertexName);
+    // unmap the file
+    graphFile.close();
 
-        // add edge to the adjacency list
-        adjacencyList[fromVertexIndex].push_back(Graph::AdjListVertex(toVertexIndex, newEdgeCost));
+    // replace the old graph, keep one copy of each edge listed both ways if it is undirected, and freeze the
+    // edges into the CSR arrays
+    numVertices = newNumVertices;
+    undirected = (loadDirection != DIRECTED) && foldMirroredEdges(edgeBlocks, loadDirection == DETECT_DIRECTION);
+    numEdges = 0;
+    for (const std::vector<Edge>& curBlock : edgeBlocks) {
+        numEdges += (int)curBlock.size();
     }
+    vertexNames = std::move(newVertexNames);
+    buildCompressedAdjacency(edgeBlocks);
 
-    // close the file
-    infile.close();
+    // nothing borrows from an earlier snapshot any more
+    snapshotFile.reset();
 
     return true;
 
@@ -120,553 +245,3535 @@ bool Graph::readGraph(std::string fileName) {
 
 
 /*-------------------------------------------------------------------------------------*
- *   function name: getVertexIndex(string)                                             *
+ *   function name: parseEdges(TokenScanner, VertexNameTable, int, vector<Edge>)       *
  *                                                                                     *
- *   description: finds the index of a vertex based on the name of the vertex          *
+ *   description: reads 'from to cost' triples from scanner and appends them to edges. *
+ *                reads maxEdges triples, or every triple left in the scanner when     *
+ *                maxEdges is READ_ALL_EDGES. only reads nameTable, so several       *
+ *                threads may call it at once with their own scanners.                 *
  *                                                                                     *
- *   returns: the index of the specified vertex or -1 if not found                     *
+ *   returns: false if a triple is incomplete, malformed, or names an unknown vertex   *
  *-------------------------------------------------------------------------------------*/
-int Graph::getVertexIndex(std::string nameOfVertexToFind) {
+bool Graph::parseEdges(TokenScanner& scanner, const VertexNameTable& nameTable, int maxEdges, std::vector<Edge>& edges) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    std::string_view fromVertexName; // the name of the 'from' vertex being added to the graph
+    std::string_view toVertexName; // the name of the 'to' vertex being added to the graph
+    int fromVertexIndex; // the index of the 'from' vertex being added to the graph
+    int toVertexIndex; // the index of the 'to' vertex being added to the graph
+    int newEdgeCost; // the cost of the new edge being added to the graph
+
+    if (maxEdges != READ_ALL_EDGES) {
+        edges.reserve(edges.size() + maxEdges);
+    }
 
-    for (int curIndex = 0; curIndex < vertexNameList.size(); curIndex++) {
-        if (vertexNameList[curIndex] == nameOfVertexToFind) {
-            return curIndex;
+    /* cycle through file edges, get data needed for edge and add edge to the edge list */
+    for (int i = 0; maxEdges == READ_ALL_EDGES || i < maxEdges; i++) {
+        // get the pieces of data we need to add a new edge. running out of tokens is only fine when reading them all
+        if ( !scanner.nextToken(fromVertexName) ) {
+            return maxEdges == READ_ALL_EDGES;
         }
+        if ( !scanner.nextToken(toVertexName) || !scanner.nextInt(newEdgeCost) ) {
+            return false;
+        }
+
+        // find the indices of the vertices involved. an edge to an unknown vertex makes the file invalid
+        fromVertexIndex = nameTable.find(fromVertexName);
+        toVertexIndex = nameTable.find(toVertexName);
+        if (fromVertexIndex == -1 || toVertexIndex == -1) {
+            return false;
+        }
+
+        // add edge to the edge list
+        edges.push_back(Edge(fromVertexIndex, toVertexIndex, newEdgeCost));
     }
 
-    // return if vertex could not be found
-    return -1;
+    return true;
 }
 
 
 
 /*-------------------------------------------------------------------------------------*
- *   function name: printGraph()                                                       *
+ *   function name: parseEdgeSectionInParallel(char*, char*, VertexNameTable, int,     *
+ *                                             vector<vector<Edge>>)                   *
  *                                                                                     *
- *   description: prints the graph to std::cout using the same file format as          *
- *                fileName in the readGraph(std::string) function                      *
+ *   description: splits the edge section [sectionStart, sectionEnd) into blocks that  *
+ *                start on a line boundary and parses the blocks on a thread pool.     *
+ *                block i of edgeBlocks holds the edges of the i-th piece of the file, *
+ *                so reading the blocks in order gives the same edge order as a serial *
+ *                load.                                                                *
  *                                                                                     *
- *   returns: n/a                                                                      *
+ *   returns: true if the section was parsed into exactly expectedEdges edges. false   *
+ *            if the section is too small to be worth splitting, if a block could not  *
+ *            be parsed, or if the edge count does not match, in which case the caller *
+ *            parses the section serially to get the exact result and error handling.  *
  *-------------------------------------------------------------------------------------*/
-void Graph::printGraph() {
+bool Graph::parseEdgeSectionInParallel(const char* sectionStart, const char* sectionEnd, const VertexNameTable& nameTable,
+    int expectedEdges, std::vector< std::vector<Edge> >& edgeBlocks) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the number of blocks. a few per thread so that one slow block does not hold up the rest
+    long long numBlocks = std::min<long long>((long long)numLoadThreads * BLOCKS_PER_LOAD_THREAD,
+        (sectionEnd - sectionStart) / MIN_PARALLEL_LOAD_BLOCK_BYTES);
+
+    // where each block starts. the last entry is sectionEnd
+    std::vector<const char*> blockStarts;
 
-    // print the number of vertices
-    std::cout << numVertices << "\n";
+    // whether each block parsed successfully. char rather than bool so each thread writes its own byte
+    std::vector<char> blockParsed;
+
+    // the total number of edges found
+    long long totalEdges = 0;
+
+    /*-------------------------------------------------------------------------------------*
+     *   split the section on line boundaries                                              *
+     *-------------------------------------------------------------------------------------*/
+    if (numLoadThreads < 2 || numBlocks < 2) {
+        return false;
+    }
 
-    // print the vertices with each vertex getting their own line
-    for (std::string vertex : vertexNameList) {
-        std::cout << vertex << "\n";
+    blockStarts.push_back(sectionStart);
+    for (long long i = 1; i < numBlocks; i++) {
+        // move the even split point forward to the start of the next line
+        const char* splitPoint = std::max(sectionStart + (sectionEnd - sectionStart) * i / numBlocks, blockStarts.back());
+        while (splitPoint != sectionEnd && *(splitPoint - 1) != '\n') {
+            splitPoint++;
+        }
+        blockStarts.push_back(splitPoint);
     }
+    blockStarts.push_back(sectionEnd);
 
-    // print the number of edges
-    std::cout << numEdges << "\n";
+    /*-------------------------------------------------------------------------------------*
+     *   parse the blocks on the thread pool                                               *
+     *-------------------------------------------------------------------------------------*/
+    edgeBlocks.assign(numBlocks, std::vector<Edge>());
+    blockParsed.assign(numBlocks, 0);
+    {
+        ThreadPool loadPool(numLoadThreads);
+        for (long long i = 0; i < numBlocks; i++) {
+            loadPool.submit([&, i] {
+                TokenScanner blockScanner(blockStarts[i], blockStarts[i + 1]);
+                blockParsed[i] = parseEdges(blockScanner, nameTable, READ_ALL_EDGES, edgeBlocks[i]);
+            });
+        }
+        loadPool.wait();
+    }
 
-    // print the edges with each edge getting their own line
-    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
-        for (std::list<AdjListVertex>::iterator iter = adjacencyList[curIndex].begin(); iter != adjacencyList[curIndex].end(); ++iter) {
-            std::cout << vertexNameList[curIndex] << " " << vertexNameList[iter->toIndex] << " " << iter->cost << "\n";
+    // every block must have parsed and together they must hold exactly the edges promised
+    for (long long i = 0; i < numBlocks; i++) {
+        if (!blockParsed[i]) {
+            return false;
         }
+        totalEdges += edgeBlocks[i].size();
     }
 
+    return totalEdges == expectedEdges;
 }
 
 
 
 /*-------------------------------------------------------------------------------------*
- *   function name: computeTopologicalSort()                                           *
+ *   function name: foldMirroredEdges(vector<vector<Edge>>, bool)                      *
  *                                                                                     *
- *   description: prints to standard output a topological sort of the graph or an      *
- *                error message indicating that a topological sort of the graph is     *
- *                not possible.                                                        *
+ *   description: finds the edges of an undirected graph that are listed both ways     *
+ *                and drops one copy of each. the edges between two different          *
+ *                vertices are grouped by their lower numbered end with a counting     *
+ *                pass, and each group is sorted by (higher end, cost, file order), so *
+ *                the copies of an edge sit in one run. each edge listed from the      *
+ *                higher end is paired with one listed from the lower end, and the     *
+ *                first copies from the higher end are dropped, as many as there are   *
+ *                pairs. an edge from a vertex to itself is its own mirror and is      *
+ *                always kept.                                                         *
  *                                                                                     *
- *   returns: n/a                                                                      *
+ *   returns: true if the edges were folded. false if requireSymmetric is true and a   *
+ *            run does not hold as many edges from one end as from the other, in       *
+ *            which case edgeBlocks are left as they are                               *
  *-------------------------------------------------------------------------------------*/
-void Graph::computeTopologicalSort() {
+bool Graph::foldMirroredEdges(std::vector< std::vector<Edge> >& edgeBlocks, bool requireSymmetric) const {
 
     /*-------------------------------------------------------------------------------------*
      *   variables used                                                                    *
      *-------------------------------------------------------------------------------------*/
-    std::vector<int> inDegreeVector; // stores the number of dependencies for each vertex
-    std::queue<int> vertexQueue; // queue that processes vertices
-    std::list<std::string> topologicalSortOrdering; // the order of the topological sort
-    int queueVertexIndex; // the index of the current vertex being looked at
-    int topologicalSortCount = 0; // the number of vertices in the topological sort order
+    // the number of edges, each named by its number in file order
+    int numListed = 0;
+
+    // the edges between two different vertices as (higher end, cost, twice the number in file order, plus
+    // 1 if listed from the higher end), grouped by their lower end. the edges whose lower end is v are at
+    // positions groupBegins[v] through groupBegins[v + 1] - 1
+    std::vector<int> groupBegins(numVertices + 1, 0);
+    std::vector< std::tuple<int, int, int> > groupedEdges;
+
+    // the next free position of each vertex's group
+    std::vector<int> groupCursors;
+
+    // whether each edge is dropped as the mirror of another
+    std::vector<char> dropped;
 
     /*-------------------------------------------------------------------------------------*
-     *   calculate and print the topological sort                                          *
+     *   group the edges by their lower end                                                *
      *-------------------------------------------------------------------------------------*/
-    // set up the in-degree array from the graph
-    inDegreeVector = setupInDegreeVector();
-
-    // add any vertices with in-degree zero to the queue
-    for (int curIndex = 0; curIndex < inDegreeVector.size(); curIndex++) {
-        if ( inDegreeVector[curIndex] == 0) {
-            vertexQueue.push(curIndex);
+    for (std::vector<Edge>& curBlock : edgeBlocks) {
+        for (const Edge& curEdge : curBlock) {
+            numListed++;
+            if (curEdge.fromVertexIndex != curEdge.toVertexIndex) {
+                groupBegins[std::min(curEdge.fromVertexIndex, curEdge.toVertexIndex) + 1]++;
+            }
         }
     }
-
-    // while the queue is not empty
-    while ( !vertexQueue.empty() ) {
-        // remove the first vertex
-        queueVertexIndex = vertexQueue.front();
-        vertexQueue.pop();
-
-        // add name of curVertexIndex to the topological sorting list
-        topologicalSortOrdering.push_back(vertexNameList[queueVertexIndex]);
-        topologicalSortCount++;
-
-        // for each edge from that vertex
-        for (std::list<AdjListVertex>::iterator edge = adjacencyList[queueVertexIndex].begin(); edge != adjacencyList[queueVertexIndex].end(); ++edge) {
-
-            // reduce the in-degree by one
-            inDegreeVector[edge->toIndex]--;
-
-            // if the in-degree for the vertex is 0, then put it in the queue
-            if (inDegreeVector[edge->toIndex] == 0) {
-                vertexQueue.push(edge->toIndex);
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        groupBegins[curIndex + 1] += groupBegins[curIndex];
+    }
+    groupCursors.assign(groupBegins.begin(), groupBegins.end() - 1);
+    groupedEdges.resize(groupBegins[numVertices]);
+    int listed = 0;
+    for (const std::vector<Edge>& curBlock : edgeBlocks) {
+        for (const Edge& curEdge : curBlock) {
+            if (curEdge.fromVertexIndex != curEdge.toVertexIndex) {
+                int lowerEnd = std::min(curEdge.fromVertexIndex, curEdge.toVertexIndex);
+                groupedEdges[groupCursors[lowerEnd]++] = std::make_tuple(std::max(curEdge.fromVertexIndex, curEdge.toVertexIndex),
+                    curEdge.cost, 2 * listed + (curEdge.fromVertexIndex != lowerEnd));
             }
+            listed++;
         }
     }
 
-    // print the topological sort
-    printTopologicalSortOutput(topologicalSortOrdering, topologicalSortCount);
-    
-}
-
-
-
-/*-------------------------------------------------------------------------------------*
- *   function name: setupInDegreeVector()                                              *
- *                                                                                     *
- *   description: creates the in-degree vector which stores the number of dependencies *
- *                each vertex in the graph has.                                        *
- *                                                                                     *
- *   returns: the vector that stores the in-degree data for the graph                  *
- *-------------------------------------------------------------------------------------*/
-std::vector<int> Graph::setupInDegreeVector() {
+    /*-------------------------------------------------------------------------------------*
+     *   pair the copies listed from each end and drop the extra ones                      *
+     *-------------------------------------------------------------------------------------*/
+    dropped.assign(numListed, 0);
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        std::sort(groupedEdges.begin() + groupBegins[curIndex], groupedEdges.begin() + groupBegins[curIndex + 1]);
+
+        for (int runBegin = groupBegins[curIndex], runEnd; runBegin < groupBegins[curIndex + 1]; runBegin = runEnd) {
+
+            // the copies of one edge, and how many of them are listed from each end
+            int numFromLowerEnd = 0;
+            int numFromHigherEnd = 0;
+            for (runEnd = runBegin; runEnd < groupBegins[curIndex + 1]
+                && std::get<0>(groupedEdges[runEnd]) == std::get<0>(groupedEdges[runBegin])
+                && std::get<1>(groupedEdges[runEnd]) == std::get<1>(groupedEdges[runBegin]); runEnd++) {
+                if (std::get<2>(groupedEdges[runEnd]) & 1) {
+                    numFromHigherEnd++;
+                }
+                else {
+                    numFromLowerEnd++;
+                }
+            }
+            if (requireSymmetric && numFromLowerEnd != numFromHigherEnd) {
+                return false;
+            }
 
-    // create in-degree vector
-    std::vector<int> inDegreeVector(numVertices);
+            // drop a copy from the higher end for each pair
+            int numPairs = std::min(numFromLowerEnd, numFromHigherEnd);
+            for (int position = runBegin; position < runEnd && numPairs > 0; position++) {
+                if (std::get<2>(groupedEdges[position]) & 1) {
+                    dropped[std::get<2>(groupedEdges[position]) / 2] = 1;
+                    numPairs--;
+                }
+            }
+        }
+    }
 
-    // cycle through the edges for each vertex and increment the vertex when it is pointed at
-    for (int curIndex = 0; curIndex < adjacencyList.size(); curIndex++) {
-        for (std::list<AdjListVertex>::iterator iter = adjacencyList[curIndex].begin(); iter != adjacencyList[curIndex].end(); ++iter) {
-            inDegreeVector[iter->toIndex]++;
+    /*-------------------------------------------------------------------------------------*
+     *   remove the dropped edges, keeping the order of the rest                           *
+     *-------------------------------------------------------------------------------------*/
+    listed = 0;
+    for (std::vector<Edge>& curBlock : edgeBlocks) {
+        size_t numKept = 0;
+        for (size_t position = 0; position < curBlock.size(); position++) {
+            if (!dropped[listed++]) {
+                curBlock[numKept++] = curBlock[position];
+            }
         }
+        curBlock.resize(numKept);
     }
 
-    // return the vector
-    return inDegreeVector;
+    return true;
 }
 
 
 
 /*-------------------------------------------------------------------------------------*
- *   function name: printTopologicalSortOutput()                                       *
+ *   function name: buildCompressedAdjacency(vector<vector<Edge>>)                     *
  *                                                                                     *
- *   description: prints the correct output for the computeTopologicalSort function    *
- *                to the screen.                                                       *
+ *   description: replaces edgeBegins, edgeEnds, edgeTargets and edgeCosts with the    *
+ *                edges passed. this is a stable counting sort on the from vertex, so  *
+ *                the edges of each vertex keep the order they have when the blocks    *
+ *                are read one after another.                                          *
  *                                                                                     *
  *   returns: n/a                                                                      *
  *-------------------------------------------------------------------------------------*/
-void Graph::printTopologicalSortOutput(std::list<std::string>& topologicalSortOrdering, int numVerticesInSortList) {
+void Graph::buildCompressedAdjacency(const std::vector< std::vector<Edge> >& edgeBlocks) {
 
-    // variables used
-    int count = 0; // the count used to know when we are at the last vertex in the ordering
+    // where each vertex's edges start. the extra last entry is the total number of edges
+    std::vector<int> edgeOffsets(numVertices + 1, 0);
 
-    // if the graph can be sorted then print out the order
-    if (numVertices == numVerticesInSortList) {
-
-        // print out the title
-        std::cout << "Topological Sort:\n";
-
-        for (std::list<std::string>::iterator curVertex = topologicalSortOrdering.begin(); curVertex != topologicalSortOrdering.end(); ++curVertex) {
-
-            // increase the count 
-            count++;
-
-            // if we are at the last vertex then don't print the next arrow
-            if (count == numVerticesInSortList) {
-                std::cout << *curVertex << "\n";
-            }
-
-            // we are not at the last vertex so we need to print the next arrow
-            else {
-                std::cout << *curVertex << " --> ";
-            }
+    // count the edges leaving each vertex, then turn the counts into offsets
+    for (const std::vector<Edge>& curBlock : edgeBlocks) {
+        for (const Edge& curEdge : curBlock) {
+            edgeOffsets[curEdge.fromVertexIndex + 1]++;
         }
     }
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        edgeOffsets[curIndex + 1] += edgeOffsets[curIndex];
+    }
 
-    // the graph cannot be sorted and so a message indicating so is printed
-    else {
-        std::cout << "This graph cannot be topologically sorted.\n";
+    // each range ends where the next begins. edgeEnds is advanced as the edges are placed
+    edgeBegins.assign(edgeOffsets.data(), edgeOffsets.data() + numVertices);
+    edgeEnds.assign(edgeOffsets.data(), edgeOffsets.data() + numVertices);
+
+    // place each edge in its vertex's range, noting the range of the costs
+    edgeTargets.assign(edgeOffsets[numVertices], 0);
+    edgeCosts.assign(edgeOffsets[numVertices], 0);
+    minEdgeCost = (edgeOffsets[numVertices] == 0) ? 0 : INT_MAX;
+    maxEdgeCost = (edgeOffsets[numVertices] == 0) ? 0 : INT_MIN;
+    for (const std::vector<Edge>& curBlock : edgeBlocks) {
+        for (const Edge& curEdge : curBlock) {
+            int position = edgeEnds[curEdge.fromVertexIndex]++;
+            edgeTargets[position] = curEdge.toVertexIndex;
+            edgeCosts[position] = curEdge.cost;
+            minEdgeCost = std::min(minEdgeCost, curEdge.cost);
+            maxEdgeCost = std::max(maxEdgeCost, curEdge.cost);
+        }
     }
+
+    // the arrays are packed and have no room reserved for edits
+    edgeCapacityEnds.clear();
+    numDeadEdgeSlots = 0;
+    clearReverseAdjacency();
+    clearLandmarks();
+    contractionHierarchy.clear();
+    dynamicTopologicalOrder.clear();
+    dynamicSpanningForest.clear();
+    graphChanged();
 }
 
 
 
 /*-------------------------------------------------------------------------------------*
- *   function name: computeShortestPaths(std::string)                                  *
+ *   function name: snapshotChecksum(const char*, size_t)                              *
  *                                                                                     *
- *   description: computes and prints out the path and cost from the parameter vertex  *
- *                to each other reachable vertex in the graph.                         *
+ *   description: computes the checksum stored for each part of a snapshot. works a   *
+ *                word at a time so that verifying a large snapshot is not slower      *
+ *                than reading it.                                                     *
  *                                                                                     *
- *   returns: n/a                                                                      *
+ *   returns: the checksum of the bytes                                                *
  *-------------------------------------------------------------------------------------*/
-void Graph::computeShortestPaths(std::string startingVertexName) {
-
-    /*-------------------------------------------------------------------------------------*
-     *   variables used                                                                    *
-     *-------------------------------------------------------------------------------------*/
-    // holds the Edge items we want to consider for the shortest path
-    std::priority_queue< Edge, std::vector<Edge>, std::greater<Edge> > nextShortestPathQueue;
-
-    // the index of the starting vertex that we are finding the paths for
-    int startingVertexIndex = getVertexIndex(startingVertexName); 
+static std::uint64_t snapshotChecksum(const char* bytes, std::size_t numBytes) {
 
-    // represents the array that stores all information needed for the path to all vertices
-    std::vector<PathVertex> pathRepresentation(numVertices); 
-
-    /*-------------------------------------------------------------------------------------*
-     *   compute the shortest paths for the starting vertex                                *
-     *-------------------------------------------------------------------------------------*/
-    // setup values for the starting vertex and update the number of paths found
-    pathRepresentation[startingVertexIndex].totalDistance = 0;
-    pathRepresentation[startingVertexIndex].prevVertexIndex = END_OF_PATH;
-    pathRepresentation[startingVertexIndex].found = true;
+    std::uint64_t checksum = SNAPSHOT_CHECKSUM_SEED ^ numBytes;
+    std::uint64_t word;
+    std::size_t position = 0;
 
-    /* fill the nextShortestPath queue with edges going out of the starting vertex */
-    // for each edge adjacent to the starting vertex
-    for ( AdjListVertex curEdge : adjacencyList[startingVertexIndex]) {
+    // whole words
+    for ( ; position + sizeof(word) <= numBytes; position += sizeof(word)) {
+        std::memcpy(&word, bytes + position, sizeof(word));
+        checksum = (checksum ^ word) * SNAPSHOT_CHECKSUM_PRIME;
+        checksum ^= checksum >> 29;
+    }
 
-        // add the edge as a Edge object to the queue
-        nextShortestPathQueue.push(Edge(startingVertexIndex, curEdge.toIndex, curEdge.cost)); 
+    // the bytes left over
+    for ( ; position < numBytes; position++) {
+        checksum = (checksum ^ (unsigned char)bytes[position]) * SNAPSHOT_CHECKSUM_PRIME;
     }
-    
-    // build the pathRepresentation
-    buildPathRepresentation(pathRepresentation, nextShortestPathQueue);
 
-    // print out the paths that can be found
-    printShortestPathsOutput(startingVertexName, pathRepresentation);
+    return checksum;
 }
 
 
 
 /*-------------------------------------------------------------------------------------*
- *   function name: printPathList(list<string>)                                        *
+ *   function name: saveSnapshot(std::string)                                          *
  *                                                                                     *
- *   description: prints out the list that is passed. helper function for              *
- *                printShortestPathsOutput.                                            *
+ *   description: writes the graph to fileName as a binary snapshot: a SnapshotHeader  *
+ *                followed by the name blob, name offsets, name hash table, and the    *
+ *                four CSR arrays, each aligned to SNAPSHOT_SECTION_ALIGNMENT bytes    *
+ *                and checksummed. the arrays are written exactly as they are held in  *
+ *                memory, so loadSnapshot can use them without any per-edge work.      *
  *                                                                                     *
- *   returns: n/a                                                                      *
+ *   returns: true if the snapshot was written. false otherwise                        *
  *-------------------------------------------------------------------------------------*/
-void Graph::printPathList(std::list<std::string>& pathList) {
+bool Graph::saveSnapshot(const std::string& fileName) const {
 
     /*-------------------------------------------------------------------------------------*
      *   variables used                                                                    *
      *-------------------------------------------------------------------------------------*/
-    // counts the number of vertices we have processed
-    int count = 0;
+    std::ofstream outfile(fileName, std::ios::binary | std::ios::trunc); // the snapshot being written
+    SnapshotHeader header; // the header, filled in as the sections are written
+    std::uint64_t position; // the number of bytes written so far
+    const char padding[SNAPSHOT_SECTION_ALIGNMENT] = {}; // zeros used to align the sections
+
+    // where each section's bytes are in memory, in SnapshotSection order
+    const char* sectionData[NUM_SNAPSHOT_SECTIONS] = {
+        vertexNames.nameBlobData(),
+        (const char*)vertexNames.nameOffsetsData(),
+        (const char*)vertexNames.slotsData(),
+        (const char*)edgeBegins.data(),
+        (const char*)edgeEnds.data(),
+        (const char*)edgeTargets.data(),
+        (const char*)edgeCosts.data(),
+        (const char*)landmarkVertices.data(),
+        (const char*)landmarkDistancesFrom.data(),
+        (const char*)landmarkDistancesTo.data()
+    };
 
     /*-------------------------------------------------------------------------------------*
-     *   print the path list                                                               *
+     *   write the sections, then go back and write the header                             *
      *-------------------------------------------------------------------------------------*/
-    /* go through the path list and print each entry with an arrow only if it is not the last item */
-    for (std::string curVertexName : pathList) {
-
-        // if we are at the last item
-        if (count == pathList.size() - 1) {
-            std::cout << curVertexName;
-        }
-        else { // we are not at the last item
-            std::cout << curVertexName << " --> ";
-        }
+    if ( !outfile.is_open() ) {
+        return false;
+    }
 
-        // update number of items processed
-        count++;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrderMark = SNAPSHOT_BYTE_ORDER_MARK;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.numVertices = numVertices;
+    header.numEdges = numEdges;
+    header.minEdgeCost = minEdgeCost;
+    header.maxEdgeCost = maxEdgeCost;
+    header.undirected = undirected ? 1 : 0;
+    header.sectionSizes[SNAPSHOT_NAME_BLOB] = vertexNames.nameBlobSize();
+    header.sectionSizes[SNAPSHOT_NAME_OFFSETS] = (numVertices + 1) * sizeof(int);
+    header.sectionSizes[SNAPSHOT_NAME_SLOTS] = vertexNames.numSlots() * sizeof(VertexNameTable::Slot);
+    header.sectionSizes[SNAPSHOT_EDGE_BEGINS] = (std::uint64_t)numVertices * sizeof(int);
+    header.sectionSizes[SNAPSHOT_EDGE_ENDS] = (std::uint64_t)numVertices * sizeof(int);
+    header.sectionSizes[SNAPSHOT_EDGE_TARGETS] = edgeTargets.size() * sizeof(int);
+    header.sectionSizes[SNAPSHOT_EDGE_COSTS] = edgeCosts.size() * sizeof(int);
+    header.sectionSizes[SNAPSHOT_LANDMARK_VERTICES] = landmarkVertices.size() * sizeof(int);
+    header.sectionSizes[SNAPSHOT_LANDMARK_DISTANCES_FROM] = landmarkDistancesFrom.size() * sizeof(int);
+    header.sectionSizes[SNAPSHOT_LANDMARK_DISTANCES_TO] = landmarkDistancesTo.size() * sizeof(int);
+
+    // reserve room for the header
+    outfile.write((const char*)&header, sizeof(header));
+    position = sizeof(header);
+
+    for (int section = 0; section < NUM_SNAPSHOT_SECTIONS; section++) {
+        // pad up to the alignment
+        std::uint64_t paddingSize = (SNAPSHOT_SECTION_ALIGNMENT - position % SNAPSHOT_SECTION_ALIGNMENT) % SNAPSHOT_SECTION_ALIGNMENT;
+        outfile.write(padding, paddingSize);
+        position += paddingSize;
+
+        header.sectionOffsets[section] = position;
+        header.sectionChecksums[section] = snapshotChecksum(sectionData[section], header.sectionSizes[section]);
+        outfile.write(sectionData[section], header.sectionSizes[section]);
+        position += header.sectionSizes[section];
     }
 
+    // the header checksum covers the whole header with the checksum field itself zero
+    header.headerChecksum = snapshotChecksum((const char*)&header, sizeof(header));
+    outfile.seekp(0);
+    outfile.write((const char*)&header, sizeof(header));
+
+    outfile.close();
+    return !outfile.fail();
 }
 
 
+
 /*-------------------------------------------------------------------------------------*
- *   function name: printShortestPathsOutput(string, vector<PathVertex>)               *
+ *   function name: loadSnapshot(std::string, bool)                                    *
  *                                                                                     *
- *   description: prints the correct output for the computeShortestPaths function      *
+ *   description: maps a snapshot written by saveSnapshot and points the graph's       *
+ *                arrays into the mapping, replacing the old graph. only the header    *
+ *                is read here; the kernel pages the rest in as the graph is used, so  *
+ *                loading takes the same time for any size of graph. when              *
+ *                verifyChecksums is true every section is read and checked first.    *
  *                                                                                     *
- *   returns: n/a                                                                      *
+ *   returns: true if the snapshot was loaded. false if it could not be mapped, is not *
+ *            a snapshot of this version, is truncated, or fails a checksum, in which  *
+ *            case the old graph is kept                                               *
  *-------------------------------------------------------------------------------------*/
-void Graph::printShortestPathsOutput(std::string startingVertexName, std::vector<PathVertex>& pathRepresentation) {
+bool Graph::loadSnapshot(const std::string& fileName, bool verifyChecksums) {
 
     /*-------------------------------------------------------------------------------------*
      *   variables used                                                                    *
      *-------------------------------------------------------------------------------------*/
-    // the index of the vertex that we are starting with
-    int startingVertexIndex = getVertexIndex(startingVertexName);
-
-    // the index of a vertex that we are wanting to add to the path
-    int vertexIndexToAdd;
-
-    // represents a path from one vertex to another
-    std::list<std::string> path; 
+    std::shared_ptr<MappedFile> newSnapshotFile = std::make_shared<MappedFile>(); // the mapped snapshot
+    SnapshotHeader header; // a copy of the snapshot's header
+    std::uint64_t expectedChecksum; // the header checksum stored in the file
+    const char* sectionData[NUM_SNAPSHOT_SECTIONS]; // where each section starts in the mapping
 
     /*-------------------------------------------------------------------------------------*
-     *   print the output                                                                  *
+     *   check the header                                                                  *
      *-------------------------------------------------------------------------------------*/
-    /* print label for output and go through each vertex we found a path for to print out that path */
-    std::cout << "Shortest paths from " << startingVertexName << ":\n";
-    int curIndex = 0;
-    for (PathVertex curVertex : pathRepresentation) {
-        
-        // if a path to curVertex has been found
-        if (curVertex.found && (startingVertexIndex != curIndex)) {
-
-            /* build the list that holds the vertex names of the path */
-            vertexIndexToAdd = curIndex;
-            do {
-                // add the vertexIndexToAdd to the path list
-                path.push_front(vertexNameList[vertexIndexToAdd]);
-
-                // update vertexIndexToAdd
-                vertexIndexToAdd = pathRepresentation[vertexIndexToAdd].prevVertexIndex;
-
-            } while (pathRepresentation[vertexIndexToAdd].prevVertexIndex != END_OF_PATH);
+    // the graph is used in place, so the pages are touched in whatever order the algorithms need
+    if ( !newSnapshotFile->open(fileName, false) || newSnapshotFile->size() < sizeof(header) ) {
+        return false;
+    }
+    std::memcpy(&header, newSnapshotFile->data(), sizeof(header));
 
-            // add the starting vertex to the path
-            path.push_front(startingVertexName);
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || header.version != SNAPSHOT_VERSION
+        || header.byteOrderMark != SNAPSHOT_BYTE_ORDER_MARK || header.headerSize != sizeof(SnapshotHeader)) {
+        return false;
+    }
 
-            /* print out the list to the screen */
-            printPathList(path);
+    expectedChecksum = header.headerChecksum;
+    header.headerChecksum = 0;
+    if (snapshotChecksum((const char*)&header, sizeof(header)) != expectedChecksum) {
+        return false;
+    }
 
-            // print weight of the path
-            std::cout << " || Weight: " << curVertex.totalDistance << "\n";
+    // the counts must fit the graph's int indices and agree with the section sizes
+    if (header.numVertices < 0 || header.numVertices >= INT_MAX || header.numEdges < 0 || header.numEdges > INT_MAX
+        || header.sectionSizes[SNAPSHOT_NAME_OFFSETS] != (std::uint64_t)(header.numVertices + 1) * sizeof(int)
+        || header.sectionSizes[SNAPSHOT_EDGE_BEGINS] != (std::uint64_t)header.numVertices * sizeof(int)
+        || header.sectionSizes[SNAPSHOT_EDGE_ENDS] != (std::uint64_t)header.numVertices * sizeof(int)
+        || header.sectionSizes[SNAPSHOT_EDGE_TARGETS] != header.sectionSizes[SNAPSHOT_EDGE_COSTS]
+        || header.sectionSizes[SNAPSHOT_EDGE_TARGETS] % sizeof(int) != 0
+        || header.sectionSizes[SNAPSHOT_EDGE_TARGETS] / sizeof(int) < (std::uint64_t)header.numEdges
+        || header.sectionSizes[SNAPSHOT_EDGE_TARGETS] / sizeof(int) > INT_MAX
+        || header.sectionSizes[SNAPSHOT_NAME_SLOTS] % sizeof(VertexNameTable::Slot) != 0) {
+        return false;
+    }
 
-            // clear the path list
-            path.clear();
+    // the landmark tables hold one distance per landmark and vertex
+    std::uint64_t numLandmarks = header.sectionSizes[SNAPSHOT_LANDMARK_VERTICES] / sizeof(int);
+    if (header.sectionSizes[SNAPSHOT_LANDMARK_VERTICES] % sizeof(int) != 0
+        || header.sectionSizes[SNAPSHOT_LANDMARK_DISTANCES_FROM] != numLandmarks * header.numVertices * sizeof(int)
+        || header.sectionSizes[SNAPSHOT_LANDMARK_DISTANCES_TO] != numLandmarks * header.numVertices * sizeof(int)) {
+        return false;
+    }
 
+    // the hash table size must be a power of two big enough for every name
+    std::uint64_t numSlots = header.sectionSizes[SNAPSHOT_NAME_SLOTS] / sizeof(VertexNameTable::Slot);
+    if (numSlots == 0 || (numSlots & (numSlots - 1)) != 0 || numSlots <= (std::uint64_t)header.numVertices) {
+        return false;
+    }
 
+    // every section must be aligned and lie inside the file
+    for (int section = 0; section < NUM_SNAPSHOT_SECTIONS; section++) {
+        if (header.sectionOffsets[section] % SNAPSHOT_SECTION_ALIGNMENT != 0 || header.sectionOffsets[section] > newSnapshotFile->size()
+            || header.sectionSizes[section] > newSnapshotFile->size() - header.sectionOffsets[section]) {
+            return false;
         }
-        else if (startingVertexIndex != curIndex) {
-            std::cout << "No path from " << startingVertexName << " to " << vertexNameList[curIndex] << " found.\n";
-        }
+        sectionData[section] = newSnapshotFile->data() + header.sectionOffsets[section];
 
-        // update curIndex
-        curIndex++;
+        if (verifyChecksums && snapshotChecksum(sectionData[section], header.sectionSizes[section]) != header.sectionChecksums[section]) {
+            return false;
+        }
     }
+
+    /*-------------------------------------------------------------------------------------*
+     *   point the graph at the mapped sections                                            *
+     *-------------------------------------------------------------------------------------*/
+    numVertices = (int)header.numVertices;
+    numEdges = (int)header.numEdges;
+    minEdgeCost = header.minEdgeCost;
+    maxEdgeCost = header.maxEdgeCost;
+    undirected = (header.undirected != 0);
+    vertexNames.borrow(sectionData[SNAPSHOT_NAME_BLOB], header.sectionSizes[SNAPSHOT_NAME_BLOB],
+        (const int*)sectionData[SNAPSHOT_NAME_OFFSETS], numVertices,
+        (const VertexNameTable::Slot*)sectionData[SNAPSHOT_NAME_SLOTS], numSlots);
+    edgeBegins.borrow((const int*)sectionData[SNAPSHOT_EDGE_BEGINS], numVertices);
+    edgeEnds.borrow((const int*)sectionData[SNAPSHOT_EDGE_ENDS], numVertices);
+    edgeTargets.borrow((const int*)sectionData[SNAPSHOT_EDGE_TARGETS], header.sectionSizes[SNAPSHOT_EDGE_TARGETS] / sizeof(int));
+    edgeCosts.borrow((const int*)sectionData[SNAPSHOT_EDGE_COSTS], header.sectionSizes[SNAPSHOT_EDGE_COSTS] / sizeof(int));
+    edgeCapacityEnds.clear();
+    numDeadEdgeSlots = (int)edgeTargets.size() - numEdges;
+    clearReverseAdjacency();
+    contractionHierarchy.clear();
+    dynamicTopologicalOrder.clear();
+    dynamicSpanningForest.clear();
+    graphChanged();
+    landmarkVertices.borrow((const int*)sectionData[SNAPSHOT_LANDMARK_VERTICES], numLandmarks);
+    landmarkDistancesFrom.borrow((const int*)sectionData[SNAPSHOT_LANDMARK_DISTANCES_FROM], numLandmarks * numVertices);
+    landmarkDistancesTo.borrow((const int*)sectionData[SNAPSHOT_LANDMARK_DISTANCES_TO], numLandmarks * numVertices);
+
+    // keep the mapping alive for as long as the arrays borrow from it
+    snapshotFile = newSnapshotFile;
+
+    return true;
 }
 
 
 
 /*-------------------------------------------------------------------------------------*
- *   function name: buildPathRepresentation(vector<PathVertex>, priority_queue)        *
+ *   function name: makeEditable()                                                     *
  *                                                                                     *
- *   description: builds the pathRepresentation vector which is used to represent all  *
- *                the paths we have found from the starting vertex to all other        *
- *                vertices.                                                            *
+ *   description: gets the graph ready to be edited in place. arrays borrowed from a   *
+ *                snapshot are copied so they can be changed, and edgeCapacityEnds is  *
+ *                set up with no spare room, so the first edge added to a vertex moves *
+ *                its range. does nothing if the graph is already editable.            *
  *                                                                                     *
  *   returns: n/a                                                                      *
  *-------------------------------------------------------------------------------------*/
-void Graph::buildPathRepresentation(std::vector<PathVertex>& pathRepresentation,
-    std::priority_queue< Edge, std::vector<Edge>, std::greater<Edge> >& nextShortestPathQueue) {
-
-    /*-------------------------------------------------------------------------------------*
-     *   variables used                                                                    *
-     *-------------------------------------------------------------------------------------*/
-    // the number of paths we have found. 1 because we consider the starting vertex to be found
-    int numPathsFound = 1; 
-
-    // represents the next shortest path that we want to add
-    Edge nextShortestPath; 
-
-    /*-------------------------------------------------------------------------------------*
-     *   find the correct paths and add them to the pathRepresentation                     *
-     *-------------------------------------------------------------------------------------*/
-    /* while the nextShortestPath is not empty and we have not found all of the paths */
-    while ( !nextShortestPathQueue.empty() && (numPathsFound != numVertices)) {
-
-        // take the next shortest path
-        nextShortestPath = nextShortestPathQueue.top();
-        nextShortestPathQueue.pop();
-
-        // if nextShortestPath has not been found yet, update pathRepresentation, increment numPathsFound, and add adjacent edges
-        if (!pathRepresentation[nextShortestPath.toVertexIndex].found) {
-
-            // update pathRepresentation
-            pathRepresentation[nextShortestPath.toVertexIndex].prevVertexIndex = nextShortestPath.fromVertexIndex;
-            pathRepresentation[nextShortestPath.toVertexIndex].found = true;
-            pathRepresentation[nextShortestPath.toVertexIndex].totalDistance = nextShortestPath.cost;
-
-            // increment numPathsFound
-            numPathsFound++;
-
-            /* add adjacent edges */
-            // for each edge adjacent to nextShortestPath
-            for (AdjListVertex curEdge : adjacencyList[nextShortestPath.toVertexIndex]) {
+void Graph::makeEditable() {
 
-                // if the edge/path has not been found yet, enqueue new Edge item onto the queue
-                if (!pathRepresentation[curEdge.toIndex].found) {
-
-                    // enqueue new item onto the queue
-                    nextShortestPathQueue.push(Edge(nextShortestPath.toVertexIndex, curEdge.toIndex, nextShortestPath.cost + curEdge.cost));
-                }
-            }
-        }
+    if (numVertices > 0 && edgeCapacityEnds.size() == (std::size_t)numVertices) {
+        return;
     }
+
+    edgeBegins.makeOwned();
+    edgeEnds.makeOwned();
+    edgeTargets.makeOwned();
+    edgeCosts.makeOwned();
+    edgeCapacityEnds.assign(edgeEnds.begin(), edgeEnds.end());
 }
 
 
 
 /*-------------------------------------------------------------------------------------*
- *   function name: computeMinimumSpanningTree()                                       *
+ *   function name: relocateEdges(int, int)                                            *
  *                                                                                     *
- *   description: computes the minimum spanning tree, then prints the edges, edge      *
- *                weight, and total weight of the tree.                                *
+ *   description: gives a vertex room for newCapacity edges. a range that already      *
+ *                ends the arrays grows in place; any other range is copied to the end *
+ *                of the arrays and its old positions become dead slots.               *
  *                                                                                     *
- *   precondition: the graph must be connected                                         *
+ *   precondition: the graph must be editable and newCapacity must be at least the     *
+ *                 vertex's out-degree                                                 *
  *                                                                                     *
  *   returns: n/a                                                                      *
  *-------------------------------------------------------------------------------------*/
-void Graph::computeMinimumSpanningTree() {
-
-    /*-------------------------------------------------------------------------------------*
-     *   variables used                                                                    *
-     *-------------------------------------------------------------------------------------*/
-    // list of the edges in the graph
-    std::list<Edge> edgesList;
-
-    // the minimum spanning tree
-    std::list<Edge> minSpanTreeEdges;
-
-    // is the spanning tree complete
-    bool spanningTreeComplete = false;
+void Graph::relocateEdges(int vertexIndex, int newCapacity) {
 
-    // current edge we are looking at
-    Edge curEdge;
+    // the number of edges leaving the vertex
+    int outDegree = edgesEnd(vertexIndex) - edgesBegin(vertexIndex);
 
-    // the disjoint set that represents which vertices are connected in the spanning tree
-    DisjointSet vertexDisjSet(numVertices);
+    // where the range will start
+    int newBegin = (int)edgeTargets.size();
 
-    // the total cost of the minimum spanning tree
-    unsigned int minSpanTreeTotalCost;
+    // the last range in the arrays can simply be extended
+    if (edgeCapacityEnds[vertexIndex] == (int)edgeTargets.size()) {
+        edgeCapacityEnds[vertexIndex] = edgesBegin(vertexIndex) + newCapacity;
+        edgeTargets.resize(edgeCapacityEnds[vertexIndex], 0);
+        edgeCosts.resize(edgeCapacityEnds[vertexIndex], 0);
+        return;
+    }
 
+    // copy the range to the end of the arrays
+    edgeTargets.resize(newBegin + newCapacity, 0);
+    edgeCosts.resize(newBegin + newCapacity, 0);
+    for (int offset = 0; offset < outDegree; offset++) {
+        edgeTargets[newBegin + offset] = edgeTargets[edgesBegin(vertexIndex) + offset];
+        edgeCosts[newBegin + offset] = edgeCosts[edgesBegin(vertexIndex) + offset];
+    }
 
-    /*-------------------------------------------------------------------------------------*
-     *   compute the minimum spanning tree                                                 *
-     *-------------------------------------------------------------------------------------*/
-    // populate edgesList with the edges we need from the adjacency list of the graph
-    populateEdgesList(edgesList);
+    numDeadEdgeSlots += edgeCapacityEnds[vertexIndex] - edgesBegin(vertexIndex);
+    edgeBegins[vertexIndex] = newBegin;
+    edgeEnds[vertexIndex] = newBegin + outDegree;
+    edgeCapacityEnds[vertexIndex] = newBegin + newCapacity;
+}
 
-    // sort the edgesList
-    edgesList.sort();
 
-    // until we're down to one tree(or out of edges)
-    while (!spanningTreeComplete) {
 
-        // get the next edge we want to try to add to the spanning tree
-        curEdge = edgesList.front();
-        edgesList.pop_front();
+/*-------------------------------------------------------------------------------------*
+ *   function name: compactEdges()                                                     *
+ *                                                                                     *
+ *   description: rewrites the edge arrays so the ranges are packed in vertex order    *
+ *                with no dead slots or spare room. called once the dead slots         *
+ *                outnumber the edges, which keeps edits amortized O(1).               *
+ *                                                                                     *
+ *   precondition: the graph must be editable                                          *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::compactEdges() {
 
-        // if the vertices for the curEdge are not in the same tree
-        if (vertexDisjSet.find(curEdge.fromVertexIndex) != vertexDisjSet.find(curEdge.toVertexIndex)) {
+    // the packed arrays
+    GraphArray<int> packedTargets;
+    GraphArray<int> packedCosts;
 
-            // add curEdge to the minimum spanning tree
-            minSpanTreeEdges.push_back(curEdge);
+    // the next free position in the packed arrays
+    int nextPosition = 0;
 
-            // connect the two trees and check if the spanning tree is complete
-            spanningTreeComplete = (vertexDisjSet.doUnion(curEdge.fromVertexIndex, curEdge.toVertexIndex));
+    packedTargets.assign(numEdges, 0);
+    packedCosts.assign(numEdges, 0);
 
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        int newBegin = nextPosition;
+        for (int edge = edgesBegin(curIndex); edge < edgesEnd(curIndex); edge++) {
+            packedTargets[nextPosition] = edgeTargets[edge];
+            packedCosts[nextPosition] = edgeCosts[edge];
+            nextPosition++;
         }
+        edgeBegins[curIndex] = newBegin;
+        edgeEnds[curIndex] = nextPosition;
+        edgeCapacityEnds[curIndex] = nextPosition;
     }
 
-    /*-------------------------------------------------------------------------------------*
-     *   compute total cost of the spanning tree                                           *
-     *-------------------------------------------------------------------------------------*/
-    minSpanTreeTotalCost = calculateSpanningTreeTotalCost(minSpanTreeEdges);
-
-    /*-------------------------------------------------------------------------------------*
-     *   print the output for the minimum spanning tree                                    *
-     *-------------------------------------------------------------------------------------*/
-    printMinimumSpanningTreeOutput(minSpanTreeEdges, minSpanTreeTotalCost);
-
+    edgeTargets = std::move(packedTargets);
+    edgeCosts = std::move(packedCosts);
+    numDeadEdgeSlots = 0;
 }
 
 
 
 /*-------------------------------------------------------------------------------------*
- *   function name: populateEdgesList()                                                *
+ *   function name: findEdge(int, int)                                                 *
  *                                                                                     *
- *   description: sorts the edges of the graph                                         *
+ *   description: searches the edges leaving fromVertexIndex for one that goes to      *
+ *                toVertexIndex                                                        *
  *                                                                                     *
- *   returns: n/a                                                                      *
+ *   returns: the position of the first such edge, or -1 if there is none              *
  *-------------------------------------------------------------------------------------*/
-void Graph::populateEdgesList(std::list<Edge>& edgesList) {
-
-    /*-------------------------------------------------------------------------------------*
-     *   add the edges to the list                                                         *
-     *-------------------------------------------------------------------------------------*/
-    // initialize the current index to the first vertex in the adjacency list
-    int curIndex = 0;
+int Graph::findEdge(int fromVertexIndex, int toVertexIndex) const {
 
-    /* go through the adjacency list */
-    for (std::list<AdjListVertex> curVertexEdges : adjacencyList) {
-
-        /* go through the edges that are adjacent to the current vertex in the adjacency list we are looking at */
-        for (AdjListVertex curEdge : curVertexEdges) {
-
-            // add the edge to edgesList
-            edgesList.push_back(Edge(curIndex, curEdge.toIndex, curEdge.cost));
-            
+    for (int edge = edgesBegin(fromVertexIndex); edge < edgesEnd(fromVertexIndex); edge++) {
+        if (edgeTargets[edge] == toVertexIndex) {
+            return edge;
         }
-
-        // move the current index to the next vertex in the adjacency list
-        curIndex++;
     }
 
+    return -1;
 }
 
 
 
 /*-------------------------------------------------------------------------------------*
- *   function name: calculateSpanningTreeTotalCost(list<Edge>)                         *
+ *   function name: addVertex(std::string)                                             *
  *                                                                                     *
- *   description: calculates the total cost of the minimum spanning tree               *
+ *   description: adds a vertex with no edges to the end of the graph                  *
  *                                                                                     *
- *   returns: the total cost of the minimum spanning tree                              *
+ *   returns: the index of the new vertex, or -1 if the name is already in the graph   *
  *-------------------------------------------------------------------------------------*/
-unsigned int Graph::calculateSpanningTreeTotalCost(std::list<Edge>& minSpanTreeEdges) {
+int Graph::addVertex(const std::string& vertexName) {
 
-    // initialize the totalCost
-    int totalCost = 0;
+    // the index of the new vertex
+    int newIndex;
 
-    // go through the minimum spanning tree and add the cost of each edge to the total
-    for (Edge curEdge : minSpanTreeEdges) {
-        totalCost += curEdge.cost;
+    makeEditable();
+
+    newIndex = vertexNames.insert(vertexName);
+    if (newIndex == -1) {
+        return -1;
+    }
+
+    // the new vertex gets an empty range at the end of the arrays
+    edgeBegins.push_back((int)edgeTargets.size());
+    edgeEnds.push_back((int)edgeTargets.size());
+    edgeCapacityEnds.push_back((int)edgeTargets.size());
+    numVertices++;
+    if (dynamicTopologicalOrder.isBuilt()) {
+        dynamicTopologicalOrder.addVertex();
+    }
+    if (dynamicSpanningForest.isBuilt()) {
+        dynamicSpanningForest.addVertex();
     }
+    clearReverseAdjacency();
+    clearLandmarks();
+    contractionHierarchy.clear();
+    graphChanged();
 
-    // return the total cost of the minimum spanning tree
-    return totalCost;
+    return newIndex;
 }
 
 
 
 /*-------------------------------------------------------------------------------------*
- *   function name: printMinimumSpanningTreeOutput(list<Edge>)                         *
+ *   function name: addEdge(std::string, std::string, int)                             *
  *                                                                                     *
- *   description: prints the correct output for the computeMinimumSpanningTree         *
- *                function                                                             *
+ *   description: adds an edge after the other edges leaving fromVertexName. if a      *
+ *                dynamic topological order is kept, the edge is inserted into it too, *
+ *                and the order is dropped if the edge closes a cycle. a kept minimum  *
+ *                spanning forest is updated by appendEdge.                            *
+ *                                                                                     *
+ *   returns: true if the edge was added. false if either vertex is not in the graph   *
+ *-------------------------------------------------------------------------------------*/
+bool Graph::addEdge(const std::string& fromVertexName, const std::string& toVertexName, int cost) {
+
+    // the indices of the vertices involved
+    int fromVertexIndex = getVertexIndex(fromVertexName);
+    int toVertexIndex = getVertexIndex(toVertexName);
+
+    // the cycle the edge closes, if it does
+    std::vector<int> cycleVertexIndices;
+
+    if (fromVertexIndex == -1 || toVertexIndex == -1) {
+        return false;
+    }
+
+    if (dynamicTopologicalOrder.isBuilt() && !dynamicTopologicalOrder.insertEdge(fromVertexIndex, toVertexIndex, cycleVertexIndices)) {
+        dynamicTopologicalOrder.clear();
+    }
+    appendEdge(fromVertexIndex, toVertexIndex, cost);
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: addEdgeKeepingOrder(std::string, std::string, int, vector<int>)    *
+ *                                                                                     *
+ *   description: adds an edge if the graph stays acyclic. the dynamic topological     *
+ *                order is built on first use; after that each edge only searches and  *
+ *                reorders the vertices between its two ends in the order, and an      *
+ *                edge that already agrees with the order costs O(1)                   *
+ *                                                                                     *
+ *   returns: true if the edge was added. false if either vertex is not in the graph,  *
+ *            the graph has a cycle already, or the edge would close one, which is     *
+ *            then left in cycleVertexIndices                                          *
+ *-------------------------------------------------------------------------------------*/
+bool Graph::addEdgeKeepingOrder(const std::string& fromVertexName, const std::string& toVertexName, int cost,
+    std::vector<int>& cycleVertexIndices) {
+
+    // the indices of the vertices involved
+    int fromVertexIndex = getVertexIndex(fromVertexName);
+    int toVertexIndex = getVertexIndex(toVertexName);
+
+    cycleVertexIndices.clear();
+    if (fromVertexIndex == -1 || toVertexIndex == -1) {
+        return false;
+    }
+
+    if (!dynamicTopologicalOrder.isBuilt() && !buildDynamicTopologicalOrder()) {
+        return false;
+    }
+
+    if (!dynamicTopologicalOrder.insertEdge(fromVertexIndex, toVertexIndex, cycleVertexIndices)) {
+        return false;
+    }
+    appendEdge(fromVertexIndex, toVertexIndex, cost);
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: appendEdge(int, int, int)                                          *
+ *                                                                                     *
+ *   description: stores an edge after the other edges leaving fromVertexIndex. when   *
+ *                the vertex's range is full it is moved with double the room, so      *
+ *                adding is amortized O(1). a kept minimum spanning forest gets the    *
+ *                edge too.                                                            *
  *                                                                                     *
  *   returns: n/a                                                                      *
  *-------------------------------------------------------------------------------------*/
-// prints the correct output for the computeMinimumSpanningTree function
-void Graph::printMinimumSpanningTreeOutput(std::list<Edge>& minSpanTreeEdges, unsigned int minSpanTreeTotalCost) {
+void Graph::appendEdge(int fromVertexIndex, int toVertexIndex, int cost) {
+
+    makeEditable();
+
+    // make room for the edge if the vertex's range is full
+    if (edgesEnd(fromVertexIndex) == edgeCapacityEnds[fromVertexIndex]) {
+        relocateEdges(fromVertexIndex, std::max(MIN_EDGE_CAPACITY, 2 * (edgesEnd(fromVertexIndex) - edgesBegin(fromVertexIndex))));
+    }
+
+    // add the edge to the end of the range
+    edgeTargets[edgesEnd(fromVertexIndex)] = toVertexIndex;
+    edgeCosts[edgesEnd(fromVertexIndex)] = cost;
+    edgeEnds[fromVertexIndex]++;
+    numEdges++;
+    if (dynamicSpanningForest.isBuilt()) {
+        dynamicSpanningForest.insertEdge(fromVertexIndex, toVertexIndex, cost);
+    }
+    minEdgeCost = (numEdges == 1) ? cost : std::min(minEdgeCost, cost);
+    maxEdgeCost = (numEdges == 1) ? cost : std::max(maxEdgeCost, cost);
+    clearReverseAdjacency();
+    clearLandmarks();
+    contractionHierarchy.clear();
+    graphChanged();
+
+    // pack the arrays once more than half of them is dead
+    if (numDeadEdgeSlots > numEdges) {
+        compactEdges();
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: removeEdge(std::string, std::string)                               *
+ *                                                                                     *
+ *   description: removes the first edge from fromVertexName to toVertexName, or in    *
+ *                an undirected graph between them either way. the later edges of the  *
+ *                vertex shift down one position so the order of the remaining edges   *
+ *                does not change.                                                     *
+ *                                                                                     *
+ *   returns: true if an edge was removed. false if there is no such edge              *
+ *-------------------------------------------------------------------------------------*/
+bool Graph::removeEdge(const std::string& fromVertexName, const std::string& toVertexName) {
+
+    // the indices of the vertices involved
+    int fromVertexIndex = getVertexIndex(fromVertexName);
+    int toVertexIndex = getVertexIndex(toVertexName);
+
+    // the position of the edge being removed, and its cost
+    int position;
+    int removedCost;
+
+    if (fromVertexIndex == -1 || toVertexIndex == -1) {
+        return false;
+    }
+
+    // an undirected edge may be stored at either end
+    position = findEdge(fromVertexIndex, toVertexIndex);
+    if (position == -1 && undirected) {
+        std::swap(fromVertexIndex, toVertexIndex);
+        position = findEdge(fromVertexIndex, toVertexIndex);
+    }
+    if (position == -1) {
+        return false;
+    }
+
+    makeEditable();
+    removedCost = edgeCosts[position];
+
+    // shift the later edges down over the removed one
+    for (int edge = position; edge + 1 < edgesEnd(fromVertexIndex); edge++) {
+        edgeTargets[edge] = edgeTargets[edge + 1];
+        edgeCosts[edge] = edgeCosts[edge + 1];
+    }
+    edgeEnds[fromVertexIndex]--;
+    numEdges--;
+    if (dynamicTopologicalOrder.isBuilt()) {
+        dynamicTopologicalOrder.removeEdge(fromVertexIndex, toVertexIndex);
+    }
+    if (dynamicSpanningForest.isBuilt()) {
+        dynamicSpanningForest.removeEdge(fromVertexIndex, toVertexIndex, removedCost);
+    }
+    clearReverseAdjacency();
+    clearLandmarks();
+    contractionHierarchy.clear();
+    graphChanged();
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: updateEdgeCost(std::string, std::string, int)                      *
+ *                                                                                     *
+ *   description: changes the cost of the first edge from fromVertexName to            *
+ *                toVertexName, or in an undirected graph between them either way      *
+ *                                                                                     *
+ *   returns: true if an edge was changed. false if there is no such edge              *
+ *-------------------------------------------------------------------------------------*/
+bool Graph::updateEdgeCost(const std::string& fromVertexName, const std::string& toVertexName, int newCost) {
+
+    // the indices of the vertices involved
+    int fromVertexIndex = getVertexIndex(fromVertexName);
+    int toVertexIndex = getVertexIndex(toVertexName);
+
+    // the position of the edge being changed
+    int position;
+
+    if (fromVertexIndex == -1 || toVertexIndex == -1) {
+        return false;
+    }
+
+    // an undirected edge may be stored at either end
+    position = findEdge(fromVertexIndex, toVertexIndex);
+    if (position == -1 && undirected) {
+        std::swap(fromVertexIndex, toVertexIndex);
+        position = findEdge(fromVertexIndex, toVertexIndex);
+    }
+    if (position == -1) {
+        return false;
+    }
+
+    makeEditable();
+    if (dynamicSpanningForest.isBuilt()) {
+        dynamicSpanningForest.updateEdgeCost(fromVertexIndex, toVertexIndex, edgeCosts[position], newCost);
+    }
+    edgeCosts[position] = newCost;
+    minEdgeCost = std::min(minEdgeCost, newCost);
+    maxEdgeCost = std::max(maxEdgeCost, newCost);
+    clearReverseAdjacency();
+    clearLandmarks();
+    contractionHierarchy.clear();
+    graphChanged();
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: applyDeltaFile(std::string)                                        *
+ *                                                                                     *
+ *   description: applies a batch of changes to the graph already in memory. the file  *
+ *                holds one change per line, applied in order:                         *
+ *                                                                                     *
+ *                   addVertex name                                                    *
+ *                   addEdge from to cost                                              *
+ *                   removeEdge from to                                                *
+ *                   updateEdgeCost from to cost                                       *
+ *                                                                                     *
+ *   returns: true if every change was applied. false if the file could not be read   *
+ *            or a change is malformed or refers to a missing vertex or edge. the      *
+ *            changes before the bad one stay applied.                                 *
+ *-------------------------------------------------------------------------------------*/
+bool Graph::applyDeltaFile(const std::string& fileName) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    MappedFile deltaFile; // the delta file, mapped into memory
+    std::string_view changeType; // the kind of change being applied
+    std::string_view fromVertexName; // the first vertex named by the change
+    std::string_view toVertexName; // the second vertex named by the change
+    int cost; // the cost given by the change
+    bool changeApplied; // whether the current change was valid
+
+    /*-------------------------------------------------------------------------------------*
+     *   apply the changes                                                                 *
+     *-------------------------------------------------------------------------------------*/
+    if ( !deltaFile.open(fileName) ) {
+        return false;
+    }
+
+    TokenScanner scanner(deltaFile.data(), deltaFile.data() + deltaFile.size());
+
+    while (scanner.nextToken(changeType)) {
+
+        if (changeType == "addVertex") {
+            changeApplied = scanner.nextToken(fromVertexName) && addVertex(std::string(fromVertexName)) != -1;
+        }
+        else if (changeType == "addEdge") {
+            changeApplied = scanner.nextToken(fromVertexName) && scanner.nextToken(toVertexName) && scanner.nextInt(cost)
+                && addEdge(std::string(fromVertexName), std::string(toVertexName), cost);
+        }
+        else if (changeType == "removeEdge") {
+            changeApplied = scanner.nextToken(fromVertexName) && scanner.nextToken(toVertexName)
+                && removeEdge(std::string(fromVertexName), std::string(toVertexName));
+        }
+        else if (changeType == "updateEdgeCost") {
+            changeApplied = scanner.nextToken(fromVertexName) && scanner.nextToken(toVertexName) && scanner.nextInt(cost)
+                && updateEdgeCost(std::string(fromVertexName), std::string(toVertexName), cost);
+        }
+        else {
+            changeApplied = false;
+        }
+
+        if (!changeApplied) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: topologicalSort()                                                  *
+ *                                                                                     *
+ *   description: computes a topological order of the vertices with Kahn's algorithm:  *
+ *                a vertex joins the order once every vertex with an edge into it has. *
+ *                if the graph has a cycle, the vertices on it and after it never do.  *
+ *                                                                                     *
+ *   returns: the order, and whether it holds every vertex                             *
+ *-------------------------------------------------------------------------------------*/
+Graph::TopologicalOrder Graph::topologicalSort() const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    std::vector<int> inDegreeVector; // stores the number of dependencies for each vertex
+    TopologicalOrder order; // the order of the topological sort
+    size_t queueFront = 0; // the vertices of order not yet processed start here, so the order doubles as the queue
+    int queueVertexIndex; // the index of the current vertex being looked at
+
+    /*-------------------------------------------------------------------------------------*
+     *   calculate the topological sort                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // an undirected edge goes both ways, which is a cycle
+    if (undirected && numEdges > 0) {
+        return order;
+    }
+
+    // set up the in-degree array from the graph
+    inDegreeVector = setupInDegreeVector();
+    order.vertexIndices.reserve(numVertices);
+
+    // add any vertices with in-degree zero to the queue
+    for (int curIndex = 0; curIndex < (int)inDegreeVector.size(); curIndex++) {
+        if ( inDegreeVector[curIndex] == 0) {
+            order.vertexIndices.push_back(curIndex);
+        }
+    }
+
+    // while the queue is not empty
+    while (queueFront < order.vertexIndices.size()) {
+        // remove the first vertex
+        queueVertexIndex = order.vertexIndices[queueFront++];
+
+        // for each edge from that vertex
+        for (int edge = edgesBegin(queueVertexIndex); edge < edgesEnd(queueVertexIndex); edge++) {
+
+            // reduce the in-degree by one
+            inDegreeVector[edgeTargets[edge]]--;
+
+            // if the in-degree for the vertex is 0, then put it in the queue
+            if (inDegreeVector[edgeTargets[edge]] == 0) {
+                order.vertexIndices.push_back(edgeTargets[edge]);
+            }
+        }
+    }
+
+    order.sorted = ((int)order.vertexIndices.size() == numVertices);
+    return order;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: topologicalSortByLevels(int)                                       *
+ *                                                                                     *
+ *   description: computes a topological order one level at a time. the vertices with  *
+ *                no edges into them are the first level; the edges out of a level are *
+ *                split into blocks over the threads, each lowering the in-degrees     *
+ *                with an atomic decrement, and the vertices whose in-degree reaches   *
+ *                zero form the next level. exactly one thread sees each reach zero,   *
+ *                so no vertex is added twice. each level is sorted by index so the    *
+ *                order is the same however the blocks were run.                      *
+ *                                                                                     *
+ *   returns: the order grouped into levels, and whether it holds every vertex         *
+ *-------------------------------------------------------------------------------------*/
+Graph::TopologicalOrder Graph::topologicalSortByLevels(int numThreads) const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the number of edges into each vertex from vertices not yet in the order
+    std::vector<int> inDegreeVector = setupInDegreeVector();
+    std::vector< std::atomic<int> > inDegrees(numVertices);
+
+    // the order being built, its levels marked as they are finished
+    TopologicalOrder order;
+
+    // the vertices each thread found ready for the next level
+    std::vector< std::vector<int> > workerOutputs((numThreads < 1) ? 1 : numThreads);
+
+    // the threads, if there is more than one
+    std::unique_ptr<ThreadPool> sortPool;
+
+    /*-------------------------------------------------------------------------------------*
+     *   compute the levels                                                                *
+     *-------------------------------------------------------------------------------------*/
+    // an undirected edge goes both ways, which is a cycle
+    if (undirected && numEdges > 0) {
+        return order;
+    }
+
+    if (numThreads > 1) {
+        sortPool.reset(new ThreadPool(numThreads));
+    }
+
+    // the first level is every vertex with in-degree zero
+    order.vertexIndices.reserve(numVertices);
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        inDegrees[curIndex].store(inDegreeVector[curIndex], std::memory_order_relaxed);
+        if (inDegreeVector[curIndex] == 0) {
+            order.vertexIndices.push_back(curIndex);
+        }
+    }
+    order.levelOffsets.push_back(0);
+
+    /* each pass finishes the newest level and finds the next */
+    while (order.levelOffsets.back() < (int)order.vertexIndices.size()) {
+
+        // the level whose edges are followed
+        int levelBegin = order.levelOffsets.back();
+        int levelSize = (int)order.vertexIndices.size() - levelBegin;
+        const int* levelVertices = order.vertexIndices.data() + levelBegin;
+        order.levelOffsets.push_back((int)order.vertexIndices.size());
+
+        /* runs over positions blockBegin to blockEnd - 1 of the level, noting the vertices that become ready */
+        auto followEdges = [this, levelVertices, &inDegrees](int blockBegin, int blockEnd, std::vector<int>& readyVertices) {
+            for (int position = blockBegin; position < blockEnd; position++) {
+                int fromVertexIndex = levelVertices[position];
+                for (int edge = edgesBegin(fromVertexIndex); edge < edgesEnd(fromVertexIndex); edge++) {
+                    if (inDegrees[edgeTargets[edge]].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                        readyVertices.push_back(edgeTargets[edge]);
+                    }
+                }
+            }
+        };
+
+        // split the level into blocks over the threads when it is large enough to pay for it
+        if (!sortPool || levelSize < MIN_PARALLEL_SEARCH_ITEMS) {
+            followEdges(0, levelSize, workerOutputs[0]);
+        }
+        else {
+            int numBlocks = numThreads * BLOCKS_PER_SEARCH_THREAD;
+            for (int block = 0; block < numBlocks; block++) {
+                int blockBegin = (int)((long long)levelSize * block / numBlocks);
+                int blockEnd = (int)((long long)levelSize * (block + 1) / numBlocks);
+                sortPool->submit([&followEdges, &workerOutputs, &sortPool, blockBegin, blockEnd] {
+                    followEdges(blockBegin, blockEnd, workerOutputs[sortPool->currentWorkerIndex()]);
+                });
+            }
+            sortPool->wait();
+        }
+
+        // the ready vertices make up the next level, in index order
+        int nextLevelBegin = (int)order.vertexIndices.size();
+        for (std::vector<int>& readyVertices : workerOutputs) {
+            order.vertexIndices.insert(order.vertexIndices.end(), readyVertices.begin(), readyVertices.end());
+            readyVertices.clear();
+        }
+        std::sort(order.vertexIndices.begin() + nextLevelBegin, order.vertexIndices.end());
+    }
+
+    order.sorted = ((int)order.vertexIndices.size() == numVertices);
+    return order;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: stronglyConnectedComponents()                                      *
+ *                                                                                     *
+ *   description: finds the strongly connected components with Tarjan's algorithm.     *
+ *                each vertex gets a discovery number and a low link, the smallest     *
+ *                discovery number it reaches through vertices still on the component  *
+ *                stack; a vertex whose low link is its own discovery number closes a  *
+ *                component made of it and every vertex above it on that stack. the    *
+ *                depth first search keeps each vertex's next edge on an explicit call *
+ *                stack rather than recursing. Tarjan closes the components sinks      *
+ *                first, so they are numbered backward to come out in topological      *
+ *                order, and a counting pass groups the vertices by component. the     *
+ *                components of an undirected graph are its connected components,      *
+ *                found with a disjoint set instead, and have no order between them.   *
+ *                                                                                     *
+ *   returns: the components                                                           *
+ *-------------------------------------------------------------------------------------*/
+Graph::StronglyConnectedComponents Graph::stronglyConnectedComponents() const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the order each vertex was discovered in, or -1 if it has not been
+    std::vector<int> discoveryIndex(numVertices, -1);
+
+    // the smallest discovery index each vertex reaches within the component stack
+    std::vector<int> lowLink(numVertices, 0);
+
+    // the vertices discovered whose component is not closed yet, and whether each vertex is on it
+    std::vector<int> componentStack;
+    std::vector<char> onComponentStack(numVertices, 0);
+
+    // the depth first search path: each vertex with the position of the next edge it will follow
+    std::vector< std::pair<int, int> > callStack;
+
+    // the number of vertices discovered and of components closed
+    int numDiscovered = 0;
+    int numClosed = 0;
+
+    // the components found
+    StronglyConnectedComponents components;
+
+    /*-------------------------------------------------------------------------------------*
+     *   find the components                                                               *
+     *-------------------------------------------------------------------------------------*/
+    components.componentOfVertex.assign(numVertices, -1);
+
+    // an undirected graph's components are its connected ones, found by joining the ends of every edge.
+    // discoveryIndex numbers each set when its lowest vertex is met, and the numbers are turned around
+    // to be turned back below, so the components come out in the order of their lowest vertex
+    if (undirected) {
+        DisjointSet vertexDisjSet(numVertices);
+        for (int vertex = 0; vertex < numVertices; vertex++) {
+            for (int edge = edgesBegin(vertex); edge < edgesEnd(vertex); edge++) {
+                if (vertexDisjSet.find(vertex) != vertexDisjSet.find(edgeTargets[edge])) {
+                    vertexDisjSet.doUnion(vertex, edgeTargets[edge]);
+                }
+            }
+        }
+        for (int vertex = 0; vertex < numVertices; vertex++) {
+            int root = vertexDisjSet.find(vertex);
+            if (discoveryIndex[root] == -1) {
+                discoveryIndex[root] = numClosed++;
+            }
+            components.componentOfVertex[vertex] = discoveryIndex[root];
+        }
+        for (int vertex = 0; vertex < numVertices; vertex++) {
+            components.componentOfVertex[vertex] = numClosed - 1 - components.componentOfVertex[vertex];
+        }
+    }
+
+    for (int rootVertex = 0; !undirected && rootVertex < numVertices; rootVertex++) {
+        if (discoveryIndex[rootVertex] != -1) {
+            continue;
+        }
+
+        discoveryIndex[rootVertex] = lowLink[rootVertex] = numDiscovered++;
+        componentStack.push_back(rootVertex);
+        onComponentStack[rootVertex] = 1;
+        callStack.emplace_back(rootVertex, edgesBegin(rootVertex));
+
+        while (!callStack.empty()) {
+            int vertex = callStack.back().first;
+            int& nextEdge = callStack.back().second;
+
+            // follow the next edge, descending into a vertex not discovered yet
+            if (nextEdge < edgesEnd(vertex)) {
+                int toVertex = edgeTargets[nextEdge++];
+                if (discoveryIndex[toVertex] == -1) {
+                    discoveryIndex[toVertex] = lowLink[toVertex] = numDiscovered++;
+                    componentStack.push_back(toVertex);
+                    onComponentStack[toVertex] = 1;
+                    callStack.emplace_back(toVertex, edgesBegin(toVertex));
+                }
+                else if (onComponentStack[toVertex]) {
+                    lowLink[vertex] = std::min(lowLink[vertex], discoveryIndex[toVertex]);
+                }
+                continue;
+            }
+
+            // every edge is followed, so close the vertex's component if it is the first one found in it
+            callStack.pop_back();
+            if (lowLink[vertex] == discoveryIndex[vertex]) {
+                int componentVertex;
+                do {
+                    componentVertex = componentStack.back();
+                    componentStack.pop_back();
+                    onComponentStack[componentVertex] = 0;
+                    components.componentOfVertex[componentVertex] = numClosed;
+                } while (componentVertex != vertex);
+                numClosed++;
+            }
+
+            // hand the low link back to the vertex this one was reached from
+            if (!callStack.empty()) {
+                int parentVertex = callStack.back().first;
+                lowLink[parentVertex] = std::min(lowLink[parentVertex], lowLink[vertex]);
+            }
+        }
+    }
 
-    std::cout << "Minimum Spanning Tree:\n";
+    /*-------------------------------------------------------------------------------------*
+     *   number the components in topological order and group the vertices                 *
+     *-------------------------------------------------------------------------------------*/
+    components.componentOffsets.assign(numClosed + 1, 0);
+    components.cyclic.assign(numClosed, 0);
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        int component = numClosed - 1 - components.componentOfVertex[vertex];
+        components.componentOfVertex[vertex] = component;
+        components.componentOffsets[component + 1]++;
+    }
+    for (int component = 0; component < numClosed; component++) {
+        components.componentOffsets[component + 1] += components.componentOffsets[component];
+        components.cyclic[component] = (components.componentOffsets[component + 1] - components.componentOffsets[component] > 1);
+    }
 
-    /* go through the spanning tree and print out the edges and their cost */
-    for (Edge curEdge : minSpanTreeEdges) {
-        std::cout << vertexNameList[curEdge.fromVertexIndex] << " -- " << vertexNameList[curEdge.toVertexIndex] << " || " << "Weight: " << curEdge.cost << "\n";
+    // lowLink is no longer needed, so it holds the next free position of each component
+    std::copy(components.componentOffsets.begin(), components.componentOffsets.end() - 1, lowLink.begin());
+    components.vertexIndices.resize(numVertices);
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        int component = components.componentOfVertex[vertex];
+        components.vertexIndices[lowLink[component]++] = vertex;
+
+        // a single vertex is only a cycle if it has an edge to itself
+        for (int edge = edgesBegin(vertex); edge < edgesEnd(vertex); edge++) {
+            if (edgeTargets[edge] == vertex) {
+                components.cyclic[component] = 1;
+            }
+        }
     }
 
-    // print out the total cost of the minimum spanning tree
-    std::cout << "Total Cost: " << minSpanTreeTotalCost << "\n";
-}
\ No newline at end of file
+    return components;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: condensation()                                                     *
+ *                                                                                     *
+ *   description: finds the components, then the edges between them. the edges that    *
+ *                join two components are counting sorted by target and then, stably,  *
+ *                by source, which leaves each component's targets in increasing order *
+ *                so the repeats are next to each other and dropped in one pass. every *
+ *                step is linear, with no comparison sort.                             *
+ *                                                                                     *
+ *   returns: the condensation                                                         *
+ *-------------------------------------------------------------------------------------*/
+Graph::Condensation Graph::condensation() const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the graph shrunk to its components
+    Condensation condensed;
+
+    // the number of components
+    int numComponents;
+
+    // the edges between components, sorted by target and then by source
+    std::vector<int> byTargetSources, byTargetTargets;
+    std::vector<int> sortedTargets;
+
+    // the number of edges between components and the start of each component's edges while sorting
+    int numCrossEdges = 0;
+    std::vector<int> bucketStarts;
+
+    /*-------------------------------------------------------------------------------------*
+     *   find the components                                                               *
+     *-------------------------------------------------------------------------------------*/
+    condensed.components = stronglyConnectedComponents();
+    numComponents = condensed.components.numComponents();
+    const std::vector<int>& componentOfVertex = condensed.components.componentOfVertex;
+
+    /*-------------------------------------------------------------------------------------*
+     *   sort the edges between components by target                                      *
+     *-------------------------------------------------------------------------------------*/
+    bucketStarts.assign(numComponents + 1, 0);
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        for (int edge = edgesBegin(vertex); edge < edgesEnd(vertex); edge++) {
+            if (componentOfVertex[vertex] != componentOfVertex[edgeTargets[edge]]) {
+                bucketStarts[componentOfVertex[edgeTargets[edge]] + 1]++;
+                numCrossEdges++;
+            }
+        }
+    }
+    for (int component = 0; component < numComponents; component++) {
+        bucketStarts[component + 1] += bucketStarts[component];
+    }
+    byTargetSources.resize(numCrossEdges);
+    byTargetTargets.resize(numCrossEdges);
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        for (int edge = edgesBegin(vertex); edge < edgesEnd(vertex); edge++) {
+            int fromComponent = componentOfVertex[vertex];
+            int toComponent = componentOfVertex[edgeTargets[edge]];
+            if (fromComponent != toComponent) {
+                byTargetSources[bucketStarts[toComponent]] = fromComponent;
+                byTargetTargets[bucketStarts[toComponent]++] = toComponent;
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   stably sort them by source and drop the repeats                                   *
+     *-------------------------------------------------------------------------------------*/
+    bucketStarts.assign(numComponents + 1, 0);
+    for (int position = 0; position < numCrossEdges; position++) {
+        bucketStarts[byTargetSources[position] + 1]++;
+    }
+    for (int component = 0; component < numComponents; component++) {
+        bucketStarts[component + 1] += bucketStarts[component];
+    }
+    sortedTargets.resize(numCrossEdges);
+    for (int position = 0; position < numCrossEdges; position++) {
+        sortedTargets[bucketStarts[byTargetSources[position]]++] = byTargetTargets[position];
+    }
+
+    // bucketStarts now holds where each component's edges end
+    condensed.edgeOffsets.assign(numComponents + 1, 0);
+    for (int component = 0, position = 0; component < numComponents; component++) {
+        for (; position < bucketStarts[component]; position++) {
+            if (condensed.edgeTargets.size() == (size_t)condensed.edgeOffsets[component]
+                || condensed.edgeTargets.back() != sortedTargets[position]) {
+                condensed.edgeTargets.push_back(sortedTargets[position]);
+            }
+        }
+        condensed.edgeOffsets[component + 1] = (int)condensed.edgeTargets.size();
+    }
+
+    return condensed;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildDynamicTopologicalOrder()                                     *
+ *                                                                                     *
+ *   description: orders the graph as it is now for addEdgeKeepingOrder. the order     *
+ *                keeps its own copy of the edges both ways, so it does not depend on  *
+ *                where each vertex's edges sit in the CSR arrays                      *
+ *                                                                                     *
+ *   returns: true if the order was built. false if the graph has a cycle or is        *
+ *            undirected                                                               *
+ *-------------------------------------------------------------------------------------*/
+bool Graph::buildDynamicTopologicalOrder() {
+
+    // every edge of an undirected graph is a cycle, so none can be added keeping an order
+    if (undirected) {
+        return false;
+    }
+
+    return dynamicTopologicalOrder.build(numVertices, edgeBegins.data(), edgeEnds.data(), edgeTargets.data());
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: dynamicTopologicalSort()                                           *
+ *                                                                                     *
+ *   description: copies out the order kept by addEdgeKeepingOrder                     *
+ *                                                                                     *
+ *   returns: the order, unsorted and empty if none is kept                            *
+ *-------------------------------------------------------------------------------------*/
+Graph::TopologicalOrder Graph::dynamicTopologicalSort() const {
+
+    // the order copied out
+    TopologicalOrder order;
+
+    if (dynamicTopologicalOrder.isBuilt()) {
+        order.vertexIndices = dynamicTopologicalOrder.order();
+        order.sorted = true;
+    }
+
+    return order;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildDynamicSpanningTree()                                         *
+ *                                                                                     *
+ *   description: finds a minimum spanning forest on the chosen engine for addEdge,    *
+ *                removeEdge and updateEdgeCost to keep up to date. the forest keeps   *
+ *                its own copy of the edges, so it does not depend on where each       *
+ *                vertex's edges sit in the CSR arrays                                 *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::buildDynamicSpanningTree() {
+
+    // the forest to start from, found by an engine rather than read from an old forest
+    dynamicSpanningForest.clear();
+    MinimumSpanningTree spanningTree = minimumSpanningTree();
+
+    dynamicSpanningForest.build(numVertices, edgeBegins.data(), edgeEnds.data(), edgeTargets.data(), edgeCosts.data(),
+        spanningTree.edgeIndices);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: setupInDegreeVector()                                              *
+ *                                                                                     *
+ *   description: creates the in-degree vector which stores the number of dependencies *
+ *                each vertex in the graph has.                                        *
+ *                                                                                     *
+ *   returns: the vector that stores the in-degree data for the graph                  *
+ *-------------------------------------------------------------------------------------*/
+std::vector<int> Graph::setupInDegreeVector() const {
+
+    // create in-degree vector
+    std::vector<int> inDegreeVector(numVertices);
+
+    // cycle through the edges for each vertex and increment the vertex when it is pointed at
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        for (int edge = edgesBegin(curIndex); edge < edgesEnd(curIndex); edge++) {
+            inDegreeVector[edgeTargets[edge]]++;
+        }
+    }
+
+    // return the vector
+    return inDegreeVector;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: shortestPathTree(std::string)                                      *
+ *                                                                                     *
+ *   description: computes the path and cost from the parameter vertex to each other   *
+ *                reachable vertex in the graph. the tree is kept in an LRU cache      *
+ *                keyed by the source and the graph's version, so asking for a recent  *
+ *                source again skips the search.                                       *
+ *                                                                                     *
+ *   returns: the tree, with found false if the vertex is not in the graph             *
+ *-------------------------------------------------------------------------------------*/
+Graph::ShortestPathTree Graph::shortestPathTree(const std::string& startingVertexName) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the index of the starting vertex that we are finding the paths for
+    int startingVertexIndex = getVertexIndex(startingVertexName); 
+
+    // holds the pathRepresentation and the queue the engine runs on
+    ShortestPathScratch scratch;
+
+    // the tree grown now when it is not cached
+    std::shared_ptr<ShortestPathTree> grownTree;
+
+    /*-------------------------------------------------------------------------------------*
+     *   compute the shortest paths for the starting vertex                                *
+     *-------------------------------------------------------------------------------------*/
+    // stop before indexing anything if the starting vertex is not in the graph
+    if (startingVertexIndex == -1) {
+        ShortestPathTree missingTree;
+        missingTree.sourceVertexName = startingVertexName;
+        return missingTree;
+    }
+
+    // reuse the tree if it was grown on this version of the graph
+    const std::shared_ptr<const ShortestPathTree>* cachedTree = shortestPathCache.find(ShortestPathCacheKey(startingVertexIndex, graphVersion));
+    if (cachedTree != nullptr) {
+        return **cachedTree;
+    }
+
+    // otherwise build the pathRepresentation and keep the tree. an undirected graph's edges are followed
+    // from either end
+    if (undirected) {
+        buildReverseAdjacency();
+    }
+    growShortestPathTree(startingVertexIndex, scratch, numSearchThreads);
+    grownTree = std::make_shared<ShortestPathTree>();
+    grownTree->sourceVertexName = startingVertexName;
+    copyShortestPathTree(startingVertexIndex, scratch.pathRepresentation, *grownTree);
+    shortestPathCache.insert(ShortestPathCacheKey(startingVertexIndex, graphVersion), grownTree);
+
+    return *grownTree;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: computeShortestPathsBatch(vector<string>, int)                     *
+ *                                                                                     *
+ *   description: computes the shortest path tree of every source at once. each source *
+ *                is a task on a work-stealing pool, so a worker whose trees are small *
+ *                takes tasks from one still busy with large ones. the graph is only   *
+ *                read, and each worker grows its trees in its own scratch, which      *
+ *                keeps its arrays and queues allocated from one tree to the next.     *
+ *                every task writes to its own slot of the result, so the trees come   *
+ *                back in source order without any locking.                            *
+ *                                                                                     *
+ *   returns: the trees in the order of sourceVertexNames                              *
+ *-------------------------------------------------------------------------------------*/
+std::vector<Graph::ShortestPathTree> Graph::computeShortestPathsBatch(const std::vector<std::string>& sourceVertexNames,
+    int numThreads) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the tree of each source
+    std::vector<ShortestPathTree> trees(sourceVertexNames.size());
+
+    // the number of sources
+    int numSources = (int)sourceVertexNames.size();
+
+    /*-------------------------------------------------------------------------------------*
+     *   grow the trees                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    if (numSources == 0) {
+        return trees;
+    }
+    if (numThreads > numSources) {
+        numThreads = numSources;
+    }
+
+    // the scratch of each worker, indexed by ThreadPool::currentWorkerIndex
+    std::vector<ShortestPathScratch> workerScratch((numThreads < 1) ? 1 : numThreads);
+
+    // an undirected graph's edges are followed from either end, so the workers share its reverse adjacency
+    if (undirected) {
+        buildReverseAdjacency();
+    }
+
+    {
+        ThreadPool batchPool(numThreads);
+        for (int sourceIndex = 0; sourceIndex < numSources; sourceIndex++) {
+            batchPool.submit([this, sourceIndex, &sourceVertexNames, &trees, &workerScratch, &batchPool] {
+
+                // the tree this task fills in
+                ShortestPathTree& tree = trees[sourceIndex];
+
+                // the index of the source
+                int startingVertexIndex = getVertexIndex(sourceVertexNames[sourceIndex]);
+
+                tree.sourceVertexName = sourceVertexNames[sourceIndex];
+                if (startingVertexIndex == -1) {
+                    return;
+                }
+
+                // the scratch of the worker running this task
+                ShortestPathScratch& scratch = workerScratch[batchPool.currentWorkerIndex()];
+
+                // the trees already keep every worker busy, so each is grown on its worker alone
+                growShortestPathTree(startingVertexIndex, scratch, 1);
+
+                // copy the tree out of the scratch
+                copyShortestPathTree(startingVertexIndex, scratch.pathRepresentation, tree);
+            });
+        }
+        batchPool.wait();
+    }
+
+    return trees;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: copyShortestPathTree(int, vector<PathVertex>, ShortestPathTree)    *
+ *                                                                                     *
+ *   description: fills a tree's distances and previous vertices from a                *
+ *                pathRepresentation grown from startingVertexIndex                    *
+ *                                                                                     *
+ *   returns: n/a. the result is stored in tree                                        *
+ *-------------------------------------------------------------------------------------*/
+void Graph::copyShortestPathTree(int startingVertexIndex, const std::vector<PathVertex>& pathRepresentation, ShortestPathTree& tree) const {
+
+    tree.sourceVertexIndex = startingVertexIndex;
+    tree.found = true;
+    tree.totalDistances.resize(numVertices);
+    tree.prevVertexIndices.resize(numVertices);
+    for (int vertexIndex = 0; vertexIndex < numVertices; vertexIndex++) {
+        const PathVertex& pathVertex = pathRepresentation[vertexIndex];
+        tree.totalDistances[vertexIndex] = pathVertex.found ? pathVertex.totalDistance : INT_MAX;
+        tree.prevVertexIndices[vertexIndex] = (pathVertex.found && vertexIndex != startingVertexIndex) ? pathVertex.prevVertexIndex : -1;
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: computeAllPairsDistances(DistanceMatrix, bool, bool)               *
+ *                                                                                     *
+ *   description: hands the adjacency arrays to matrix, which runs blocked             *
+ *                Floyd-Warshall over them. an undirected graph first gets a copy of   *
+ *                its arrays listing every edge from both ends                         *
+ *                                                                                     *
+ *   returns: true if the matrix was computed                                          *
+ *-------------------------------------------------------------------------------------*/
+bool Graph::computeAllPairsDistances(DistanceMatrix& matrix, bool keepPaths, bool allowSimd) const {
+
+    if (!undirected) {
+        return matrix.build(numVertices, edgeBegins.data(), edgeEnds.data(), edgeTargets.data(), edgeCosts.data(), keepPaths, allowSimd);
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the edges of each vertex in both directions, grouped by a counting pass
+    std::vector<int> bothBegins(numVertices + 1, 0);
+    std::vector<int> bothTargets(2 * numEdges);
+    std::vector<int> bothCosts(2 * numEdges);
+
+    /*-------------------------------------------------------------------------------------*
+     *   list every edge from both ends                                                    *
+     *-------------------------------------------------------------------------------------*/
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        for (int edge = edgesBegin(vertex); edge < edgesEnd(vertex); edge++) {
+            bothBegins[vertex + 1]++;
+            bothBegins[edgeTargets[edge] + 1]++;
+        }
+    }
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        bothBegins[vertex + 1] += bothBegins[vertex];
+    }
+
+    // the next free position of each vertex ends up at the end of its edges
+    std::vector<int> bothEnds(bothBegins.begin(), bothBegins.end() - 1);
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        for (int edge = edgesBegin(vertex); edge < edgesEnd(vertex); edge++) {
+            bothTargets[bothEnds[vertex]] = edgeTargets[edge];
+            bothCosts[bothEnds[vertex]++] = edgeCosts[edge];
+            bothTargets[bothEnds[edgeTargets[edge]]] = vertex;
+            bothCosts[bothEnds[edgeTargets[edge]]++] = edgeCosts[edge];
+        }
+    }
+
+    return matrix.build(numVertices, bothBegins.data(), bothEnds.data(), bothTargets.data(), bothCosts.data(), keepPaths, allowSimd);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildPathRepresentation(vector<PathVertex>, priority_queue)        *
+ *                                                                                     *
+ *   description: builds the pathRepresentation vector which is used to represent all  *
+ *                the paths we have found from the starting vertex to all other        *
+ *                vertices.                                                            *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::buildPathRepresentation(std::vector<PathVertex>& pathRepresentation,
+    std::priority_queue< Edge, std::vector<Edge>, std::greater<Edge> >& nextShortestPathQueue) const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the number of paths we have found. 1 because we consider the starting vertex to be found
+    int numPathsFound = 1; 
+
+    // represents the next shortest path that we want to add
+    Edge nextShortestPath; 
+
+    /*-------------------------------------------------------------------------------------*
+     *   find the correct paths and add them to the pathRepresentation                     *
+     *-------------------------------------------------------------------------------------*/
+    /* while the nextShortestPath is not empty and we have not found all of the paths */
+    while ( !nextShortestPathQueue.empty() && (numPathsFound != numVertices)) {
+
+        // take the next shortest path
+        nextShortestPath = nextShortestPathQueue.top();
+        nextShortestPathQueue.pop();
+
+        // if nextShortestPath has not been found yet, update pathRepresentation, increment numPathsFound, and add adjacent edges
+        if (!pathRepresentation[nextShortestPath.toVertexIndex].found) {
+
+            // update pathRepresentation
+            pathRepresentation[nextShortestPath.toVertexIndex].prevVertexIndex = nextShortestPath.fromVertexIndex;
+            pathRepresentation[nextShortestPath.toVertexIndex].found = true;
+            pathRepresentation[nextShortestPath.toVertexIndex].totalDistance = nextShortestPath.cost;
+
+            // increment numPathsFound
+            numPathsFound++;
+
+            /* add adjacent edges */
+            // for each edge adjacent to nextShortestPath
+            forEachNeighbor(nextShortestPath.toVertexIndex, [&](int toVertexIndex, int cost) {
+
+                // if the edge/path has not been found yet, enqueue new Edge item onto the queue
+                if (!pathRepresentation[toVertexIndex].found) {
+
+                    // enqueue new item onto the queue
+                    nextShortestPathQueue.push(Edge(nextShortestPath.toVertexIndex, toVertexIndex, nextShortestPath.cost + cost));
+                }
+            });
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildPathRepresentationWithIndexedHeap(vector<PathVertex>, int,    *
+ *                                                         IndexedHeap)                *
+ *                                                                                     *
+ *   description: builds the same pathRepresentation as buildPathRepresentation, but   *
+ *                keeps one heap entry per vertex instead of one per relaxed edge.     *
+ *                a vertex's key is (totalDistance, prevVertexIndex, vertex), the      *
+ *                smallest Edge the lazy queue would hold for it, so vertices are      *
+ *                found in the same order and ties pick the same previous vertex.      *
+ *                                                                                     *
+ *   precondition: the starting vertex must already be marked found and                *
+ *                 nextShortestPathHeap must be empty and sized for the graph          *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::buildPathRepresentationWithIndexedHeap(std::vector<PathVertex>& pathRepresentation, int startingVertexIndex,
+    IndexedHeap& nextShortestPathHeap) const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the number of paths we have found. 1 because we consider the starting vertex to be found
+    int numPathsFound = 1;
+
+    // the vertex whose path was just found
+    int foundVertexIndex = startingVertexIndex;
+
+    /*-------------------------------------------------------------------------------------*
+     *   find the correct paths and add them to the pathRepresentation                     *
+     *-------------------------------------------------------------------------------------*/
+    while (true) {
+
+        /* relax the edges leaving the vertex just found */
+        forEachNeighbor(foundVertexIndex, [&](int toVertexIndex, int cost) {
+
+            // the length of the path through the edge
+            int newDistance = pathRepresentation[foundVertexIndex].totalDistance + cost;
+
+            // record the path if it beats the one the vertex already has
+            if (!pathRepresentation[toVertexIndex].found && nextShortestPathHeap.pushOrDecrease(toVertexIndex, newDistance, foundVertexIndex)) {
+                pathRepresentation[toVertexIndex].totalDistance = newDistance;
+                pathRepresentation[toVertexIndex].prevVertexIndex = foundVertexIndex;
+            }
+        });
+
+        // stop once every path is found or no more can be
+        if (nextShortestPathHeap.empty() || numPathsFound == numVertices) {
+            break;
+        }
+
+        // the vertex with the smallest key now has its shortest path
+        foundVertexIndex = nextShortestPathHeap.pop();
+        pathRepresentation[foundVertexIndex].found = true;
+        numPathsFound++;
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildPathRepresentationWithBuckets(vector<PathVertex>, int,        *
+ *                                   BucketQueue, IndexedHeap, vector<int>)            *
+ *                                                                                     *
+ *   description: builds the same pathRepresentation as buildPathRepresentation using  *
+ *                a bucket queue, which hands out every vertex at the next smallest    *
+ *                distance at once. the order the vertices of a level are found in     *
+ *                only matters when zero cost edges join them, so only then are they   *
+ *                found in the lazy queue's order, (prevVertexIndex, vertex), using a  *
+ *                small indexed heap. vertices reached by a zero cost edge join the    *
+ *                heap as soon as the edge is followed.                                *
+ *                                                                                     *
+ *   precondition: the starting vertex must already be marked found, no edge may have  *
+ *                 a negative cost, nextShortestPathBuckets and levelHeap must be      *
+ *                 empty and sized for the graph. level is only working space for the  *
+ *                 vertices of the current level and levelHeap holds those not found   *
+ *                 yet, keyed by prevVertexIndex                                       *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+template<typename BucketQueue>
+void Graph::buildPathRepresentationWithBuckets(std::vector<PathVertex>& pathRepresentation, int startingVertexIndex,
+    BucketQueue& nextShortestPathBuckets, IndexedHeap& levelHeap, std::vector<int>& level) const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the next vertex of level to find when the level is found in the order the bucket queue gave
+    int nextLevelPosition = 0;
+
+    // the distance of the current level
+    int levelDistance = 0;
+
+    // the number of paths we have found. 1 because we consider the starting vertex to be found
+    int numPathsFound = 1;
+
+    // the vertex whose path was just found
+    int foundVertexIndex = startingVertexIndex;
+
+    /*-------------------------------------------------------------------------------------*
+     *   find the correct paths and add them to the pathRepresentation                     *
+     *-------------------------------------------------------------------------------------*/
+    // drop whatever level the last tree left behind
+    level.clear();
+
+    while (true) {
+
+        /* relax the edges leaving the vertex just found */
+        forEachNeighbor(foundVertexIndex, [&](int toVertexIndex, int cost) {
+
+            // the length of the path through the edge
+            int newDistance = levelDistance + cost;
+
+            if (pathRepresentation[toVertexIndex].found) {
+                return;
+            }
+
+            // a zero cost edge adds its vertex to the current level
+            if (newDistance == levelDistance) {
+                if (levelHeap.pushOrDecrease(toVertexIndex, foundVertexIndex, 0)) {
+                    nextShortestPathBuckets.remove(toVertexIndex);
+                    pathRepresentation[toVertexIndex].totalDistance = newDistance;
+                    pathRepresentation[toVertexIndex].prevVertexIndex = foundVertexIndex;
+                }
+            }
+            // otherwise record the path if it beats the one the vertex already has
+            else if (newDistance < pathRepresentation[toVertexIndex].totalDistance
+                || (newDistance == pathRepresentation[toVertexIndex].totalDistance && foundVertexIndex < pathRepresentation[toVertexIndex].prevVertexIndex)) {
+                pathRepresentation[toVertexIndex].totalDistance = newDistance;
+                pathRepresentation[toVertexIndex].prevVertexIndex = foundVertexIndex;
+                nextShortestPathBuckets.pushOrDecrease(toVertexIndex, newDistance);
+            }
+        });
+
+        // stop once every path is found
+        if (numPathsFound == numVertices) {
+            break;
+        }
+
+        /* start the next level once the current one is used up */
+        if (levelHeap.empty() && nextLevelPosition == (int)level.size()) {
+            if (nextShortestPathBuckets.empty()) {
+                break;
+            }
+            nextShortestPathBuckets.popMinimumLevel(level);
+            levelDistance = pathRepresentation[level[0]].totalDistance;
+            nextLevelPosition = 0;
+
+            // the order only matters if a zero cost edge can join two vertices of the level
+            if (minEdgeCost == 0 && level.size() > 1) {
+                for (int levelVertexIndex : level) {
+                    levelHeap.pushOrDecrease(levelVertexIndex, pathRepresentation[levelVertexIndex].prevVertexIndex, 0);
+                }
+                nextLevelPosition = (int)level.size();
+            }
+        }
+
+        // the next vertex of the level now has its shortest path
+        foundVertexIndex = levelHeap.empty() ? level[nextLevelPosition++] : levelHeap.pop();
+        pathRepresentation[foundVertexIndex].found = true;
+        numPathsFound++;
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildPathRepresentationWithDeltaStepping(vector<PathVertex>, int,  *
+ *                                                           int)                      *
+ *                                                                                     *
+ *   description: builds the same pathRepresentation as buildPathRepresentation with   *
+ *                delta-stepping. the distances are split into buckets bucketWidth     *
+ *                wide, and the vertices of the lowest bucket are settled together:    *
+ *                their light edges, costing at most bucketWidth, are relaxed over and *
+ *                over until the bucket stops changing, then their heavy edges, which  *
+ *                can only reach later buckets, are relaxed once. each round's         *
+ *                vertices are split over the threads, which lower distances with an   *
+ *                atomic min.                                                          *
+ *                                                                                     *
+ *                the threads race, so the edge that lowers a distance last is not     *
+ *                always the one the sequential engines would keep. the previous       *
+ *                vertices are picked afterward from the final distances instead: the  *
+ *                smallest vertex with a positive cost edge that ends a shortest path, *
+ *                which is the one the lazy queue pops first. zero cost edges between  *
+ *                vertices at the same distance make the order those vertices are      *
+ *                found in matter, so those vertices are found again in the lazy       *
+ *                queue's order, one distance at a time, the way the bucket engines    *
+ *                find a level.                                                        *
+ *                                                                                     *
+ *   precondition: no edge may have a negative cost                                    *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::buildPathRepresentationWithDeltaStepping(std::vector<PathVertex>& pathRepresentation, int startingVertexIndex,
+    int numThreads) const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the range of distances in one bucket
+    int bucketWidth = deltaSteppingBucketWidth;
+
+    // the shortest distance found so far to each vertex, INT_MAX if it has not been reached
+    std::vector< std::atomic<int> > distances(numVertices);
+
+    // the previous vertex picked for each vertex, INT_MAX until one is
+    std::vector< std::atomic<int> > prevVertexIndices(numVertices);
+
+    // the buckets, reused in a ring since only a window of maxEdgeCost past the current one is ever filled.
+    // a vertex may sit in a bucket its distance has since dropped out of and is skipped there
+    std::vector< std::vector<int> > buckets;
+
+    // the number of entries in all the buckets
+    long long numBucketEntries = 0;
+
+    // the bucket being settled, counting from the one holding distance 0
+    long long currentBucket = 0;
+
+    // the entries taken out of the current bucket, and the vertices among them still in it
+    std::vector<int> bucketEntries;
+    std::vector<int> frontier;
+
+    // every vertex settled in the current bucket, whose heavy edges are relaxed once it is done
+    std::vector<int> bucketVertices;
+
+    // the round each vertex last joined a frontier in and the bucket it was last settled in
+    std::vector<int> frontierRounds(numVertices, -1);
+    std::vector<long long> settledBuckets(numVertices, -1);
+
+    // counts the frontiers
+    int round = 0;
+
+    // the vertices each thread lowered the distance of, or collected for the zero cost pass
+    std::vector< std::vector<int> > workerOutputs((numThreads < 1) ? 1 : numThreads);
+
+    // the threads, if there is more than one
+    std::unique_ptr<ThreadPool> searchPool;
+
+    /*-------------------------------------------------------------------------------------*
+     *   set up the buckets                                                                *
+     *-------------------------------------------------------------------------------------*/
+    // by default a vertex's light edges are about one edge's worth of a bucket
+    if (bucketWidth == 0) {
+        int averageDegree = (numVertices > 0 && numEdges > numVertices) ? numEdges / numVertices : 1;
+        bucketWidth = std::max(1, maxEdgeCost / averageDegree);
+    }
+    if (maxEdgeCost / bucketWidth + 2 > MAX_DELTA_STEPPING_BUCKETS) {
+        bucketWidth = maxEdgeCost / (MAX_DELTA_STEPPING_BUCKETS - 2) + 1;
+    }
+    buckets.resize(maxEdgeCost / bucketWidth + 2);
+
+    if (numThreads > 1) {
+        searchPool.reset(new ThreadPool(numThreads));
+    }
+
+    for (int vertexIndex = 0; vertexIndex < numVertices; vertexIndex++) {
+        distances[vertexIndex].store(INT_MAX, std::memory_order_relaxed);
+        prevVertexIndices[vertexIndex].store(INT_MAX, std::memory_order_relaxed);
+    }
+
+    /* runs work over the items 0 to numItems - 1, split into blocks over the threads when there are
+       enough of them. work gets a block's range and the output list of the thread running it */
+    auto runInBlocks = [&](int numItems, const std::function<void(int, int, std::vector<int>&)>& work) {
+        if (!searchPool || numItems < MIN_PARALLEL_SEARCH_ITEMS) {
+            work(0, numItems, workerOutputs[0]);
+            return;
+        }
+        int numBlocks = numThreads * BLOCKS_PER_SEARCH_THREAD;
+        for (int block = 0; block < numBlocks; block++) {
+            int blockBegin = (int)((long long)numItems * block / numBlocks);
+            int blockEnd = (int)((long long)numItems * (block + 1) / numBlocks);
+            searchPool->submit([&work, &workerOutputs, &searchPool, blockBegin, blockEnd] {
+                work(blockBegin, blockEnd, workerOutputs[searchPool->currentWorkerIndex()]);
+            });
+        }
+        searchPool->wait();
+    };
+
+    /* relaxes the light or the heavy edges leaving vertices, then files every vertex whose distance
+       dropped in the bucket of its new distance */
+    auto relaxEdges = [&](const std::vector<int>& vertices, bool heavyEdges) {
+        runInBlocks((int)vertices.size(), [&](int blockBegin, int blockEnd, std::vector<int>& loweredVertices) {
+            for (int position = blockBegin; position < blockEnd; position++) {
+
+                // the vertex whose edges are relaxed and its distance
+                int fromVertexIndex = vertices[position];
+                int fromDistance = distances[fromVertexIndex].load(std::memory_order_relaxed);
+
+                forEachNeighbor(fromVertexIndex, [&](int toVertexIndex, int cost) {
+                    if ((cost > bucketWidth) != heavyEdges) {
+                        return;
+                    }
+
+                    // the length of the path through the edge
+                    int newDistance = fromDistance + cost;
+
+                    // lower its distance unless another thread already lowered it further
+                    int oldDistance = distances[toVertexIndex].load(std::memory_order_relaxed);
+                    while (newDistance < oldDistance) {
+                        if (distances[toVertexIndex].compare_exchange_weak(oldDistance, newDistance, std::memory_order_relaxed)) {
+                            loweredVertices.push_back(toVertexIndex);
+                            break;
+                        }
+                    }
+                });
+            }
+        });
+
+        for (std::vector<int>& loweredVertices : workerOutputs) {
+            for (int vertexIndex : loweredVertices) {
+                buckets[(distances[vertexIndex].load(std::memory_order_relaxed) / bucketWidth) % buckets.size()].push_back(vertexIndex);
+            }
+            numBucketEntries += (long long)loweredVertices.size();
+            loweredVertices.clear();
+        }
+    };
+
+    /*-------------------------------------------------------------------------------------*
+     *   find the distances                                                                *
+     *-------------------------------------------------------------------------------------*/
+    distances[startingVertexIndex].store(0, std::memory_order_relaxed);
+    buckets[0].push_back(startingVertexIndex);
+    numBucketEntries = 1;
+
+    while (numBucketEntries > 0) {
+
+        // move to the next bucket with entries
+        while (buckets[currentBucket % buckets.size()].empty()) {
+            currentBucket++;
+        }
+
+        /* settle the bucket, relaxing the light edges of the vertices that entered it each round */
+        std::vector<int>& bucket = buckets[currentBucket % buckets.size()];
+        bucketVertices.clear();
+        while (!bucket.empty()) {
+            bucketEntries.swap(bucket);
+            numBucketEntries -= (long long)bucketEntries.size();
+
+            // keep each vertex still in the bucket once
+            frontier.clear();
+            round++;
+            for (int vertexIndex : bucketEntries) {
+                if (distances[vertexIndex].load(std::memory_order_relaxed) / bucketWidth == currentBucket && frontierRounds[vertexIndex] != round) {
+                    frontierRounds[vertexIndex] = round;
+                    frontier.push_back(vertexIndex);
+                    if (settledBuckets[vertexIndex] != currentBucket) {
+                        settledBuckets[vertexIndex] = currentBucket;
+                        bucketVertices.push_back(vertexIndex);
+                    }
+                }
+            }
+            bucketEntries.clear();
+
+            relaxEdges(frontier, false);
+        }
+
+        // the bucket is settled, so its heavy edges only need relaxing once
+        relaxEdges(bucketVertices, true);
+        currentBucket++;
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   pick the previous vertices                                                        *
+     *-------------------------------------------------------------------------------------*/
+    /* the smallest vertex with a positive cost edge ending a shortest path at each vertex, and the
+       ends of the zero cost edges between vertices at the same distance */
+    runInBlocks(numVertices, [&](int blockBegin, int blockEnd, std::vector<int>& zeroEdgeVertices) {
+        for (int fromVertexIndex = blockBegin; fromVertexIndex < blockEnd; fromVertexIndex++) {
+
+            // the distance of the vertex
+            int fromDistance = distances[fromVertexIndex].load(std::memory_order_relaxed);
+
+            if (fromDistance == INT_MAX) {
+                continue;
+            }
+            forEachNeighbor(fromVertexIndex, [&](int toVertexIndex, int cost) {
+                if (toVertexIndex == startingVertexIndex || fromDistance + cost != distances[toVertexIndex].load(std::memory_order_relaxed)) {
+                    return;
+                }
+                if (cost == 0) {
+                    if (toVertexIndex != fromVertexIndex) {
+                        zeroEdgeVertices.push_back(fromVertexIndex);
+                        zeroEdgeVertices.push_back(toVertexIndex);
+                    }
+                    return;
+                }
+
+                // keep the smaller of this vertex and the one already picked
+                int oldPrevVertexIndex = prevVertexIndices[toVertexIndex].load(std::memory_order_relaxed);
+                while (fromVertexIndex < oldPrevVertexIndex
+                    && !prevVertexIndices[toVertexIndex].compare_exchange_weak(oldPrevVertexIndex, fromVertexIndex, std::memory_order_relaxed)) {
+                }
+            });
+        }
+    });
+
+    /* find the vertices joined by zero cost edges again in the lazy queue's order */
+    std::vector<int> zeroEdgeVertices;
+    for (std::vector<int>& workerZeroEdgeVertices : workerOutputs) {
+        zeroEdgeVertices.insert(zeroEdgeVertices.end(), workerZeroEdgeVertices.begin(), workerZeroEdgeVertices.end());
+        workerZeroEdgeVertices.clear();
+    }
+    if (!zeroEdgeVertices.empty()) {
+
+        // the vertices at the current distance not found yet, keyed by prevVertexIndex
+        IndexedHeap levelHeap(numVertices);
+
+        // group the vertices by distance
+        std::sort(zeroEdgeVertices.begin(), zeroEdgeVertices.end(), [&distances](int lhs, int rhs) {
+            int lhsDistance = distances[lhs].load(std::memory_order_relaxed);
+            int rhsDistance = distances[rhs].load(std::memory_order_relaxed);
+            return (lhsDistance != rhsDistance) ? lhsDistance < rhsDistance : lhs < rhs;
+        });
+        zeroEdgeVertices.erase(std::unique(zeroEdgeVertices.begin(), zeroEdgeVertices.end()), zeroEdgeVertices.end());
+
+        round++;
+        for (int levelBegin = 0, levelEnd = 0; levelBegin < (int)zeroEdgeVertices.size(); levelBegin = levelEnd) {
+
+            // the distance of the level and the vertex just found, -1 until one is
+            int levelDistance = distances[zeroEdgeVertices[levelBegin]].load(std::memory_order_relaxed);
+            int foundVertexIndex = -1;
+
+            // queue the vertices of the level that a positive cost edge reaches
+            for (levelEnd = levelBegin; levelEnd < (int)zeroEdgeVertices.size()
+                && distances[zeroEdgeVertices[levelEnd]].load(std::memory_order_relaxed) == levelDistance; levelEnd++) {
+                int levelVertexIndex = zeroEdgeVertices[levelEnd];
+                if (levelVertexIndex == startingVertexIndex) {
+                    foundVertexIndex = startingVertexIndex;
+                }
+                else if (prevVertexIndices[levelVertexIndex].load(std::memory_order_relaxed) != INT_MAX) {
+                    levelHeap.pushOrDecrease(levelVertexIndex, prevVertexIndices[levelVertexIndex].load(std::memory_order_relaxed), 0);
+                }
+            }
+
+            // the starting vertex is found before any other
+            if (foundVertexIndex == -1) {
+                foundVertexIndex = levelHeap.pop();
+            }
+            while (true) {
+                frontierRounds[foundVertexIndex] = round;
+
+                /* follow the zero cost edges leaving the vertex just found */
+                forEachNeighbor(foundVertexIndex, [&](int toVertexIndex, int cost) {
+                    if (cost == 0 && toVertexIndex != startingVertexIndex && frontierRounds[toVertexIndex] != round
+                        && distances[toVertexIndex].load(std::memory_order_relaxed) == levelDistance
+                        && levelHeap.pushOrDecrease(toVertexIndex, foundVertexIndex, 0)) {
+                        prevVertexIndices[toVertexIndex].store(foundVertexIndex, std::memory_order_relaxed);
+                    }
+                });
+
+                if (levelHeap.empty()) {
+                    break;
+                }
+                foundVertexIndex = levelHeap.pop();
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   fill in the pathRepresentation                                                    *
+     *-------------------------------------------------------------------------------------*/
+    for (int vertexIndex = 0; vertexIndex < numVertices; vertexIndex++) {
+        if (distances[vertexIndex].load(std::memory_order_relaxed) != INT_MAX && vertexIndex != startingVertexIndex) {
+            pathRepresentation[vertexIndex].found = true;
+            pathRepresentation[vertexIndex].totalDistance = distances[vertexIndex].load(std::memory_order_relaxed);
+            pathRepresentation[vertexIndex].prevVertexIndex = prevVertexIndices[vertexIndex].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: chooseShortestPathEngine()                                         *
+ *                                                                                     *
+ *   description: resolves the engine set with setShortestPathEngine. AUTOMATIC picks  *
+ *                Dial's buckets when the largest cost is small enough for one bucket  *
+ *                per distance in the window and the radix heap for larger costs.      *
+ *                DIAL_BUCKETS also moves to the radix heap for large costs, and both  *
+ *                bucket queues and delta-stepping give way to the indexed heap when   *
+ *                a cost is negative.                                                  *
+ *                                                                                     *
+ *   returns: the engine computeShortestPaths should run on                            *
+ *-------------------------------------------------------------------------------------*/
+Graph::ShortestPathEngine Graph::chooseShortestPathEngine() const {
+
+    if (shortestPathEngine == LAZY_BINARY_HEAP || shortestPathEngine == INDEXED_HEAP) {
+        return shortestPathEngine;
+    }
+
+    // the bucket queues and delta-stepping need non-negative costs
+    if (minEdgeCost < 0) {
+        return INDEXED_HEAP;
+    }
+    if (shortestPathEngine == DELTA_STEPPING) {
+        return DELTA_STEPPING;
+    }
+
+    // Dial's buckets would need too many buckets for large costs
+    if (shortestPathEngine == RADIX_HEAP || maxEdgeCost > MAX_DIAL_EDGE_COST) {
+        return RADIX_HEAP;
+    }
+
+    return DIAL_BUCKETS;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: growShortestPathTree(int, ShortestPathScratch, int)                *
+ *                                                                                     *
+ *   description: fills scratch.pathRepresentation with the shortest paths from the    *
+ *                starting vertex on the engine chooseShortestPathEngine picks. the    *
+ *                engine's queue is emptied and resized in place, so a scratch used    *
+ *                again for a graph of the same size allocates nothing. only           *
+ *                delta-stepping uses more than the calling thread.                    *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::growShortestPathTree(int startingVertexIndex, ShortestPathScratch& scratch, int numThreads) const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the engine to run on
+    ShortestPathEngine engine = chooseShortestPathEngine();
+
+    // the tree being grown
+    std::vector<PathVertex>& pathRepresentation = scratch.pathRepresentation;
+
+    /*-------------------------------------------------------------------------------------*
+     *   grow the tree                                                                     *
+     *-------------------------------------------------------------------------------------*/
+    pathRepresentation.assign(numVertices, PathVertex());
+
+    // setup values for the starting vertex and update the number of paths found
+    pathRepresentation[startingVertexIndex].totalDistance = 0;
+    pathRepresentation[startingVertexIndex].prevVertexIndex = END_OF_PATH;
+    pathRepresentation[startingVertexIndex].found = true;
+
+    if (engine == DELTA_STEPPING) {
+        buildPathRepresentationWithDeltaStepping(pathRepresentation, startingVertexIndex, numThreads);
+    }
+    else if (engine == DIAL_BUCKETS) {
+        scratch.dialBuckets.reset(numVertices, maxEdgeCost);
+        scratch.heap.reset(numVertices);
+        buildPathRepresentationWithBuckets(pathRepresentation, startingVertexIndex, scratch.dialBuckets, scratch.heap, scratch.level);
+    }
+    else if (engine == RADIX_HEAP) {
+        scratch.radixHeap.reset(numVertices);
+        scratch.heap.reset(numVertices);
+        buildPathRepresentationWithBuckets(pathRepresentation, startingVertexIndex, scratch.radixHeap, scratch.heap, scratch.level);
+    }
+    else if (engine == INDEXED_HEAP) {
+        scratch.heap.reset(numVertices);
+        buildPathRepresentationWithIndexedHeap(pathRepresentation, startingVertexIndex, scratch.heap);
+    }
+    else {
+        scratch.lazyQueue.clear();
+
+        /* fill the nextShortestPath queue with edges going out of the starting vertex */
+        // for each edge adjacent to the starting vertex
+        forEachNeighbor(startingVertexIndex, [&](int toVertexIndex, int cost) {
+
+            // add the edge as a Edge object to the queue
+            scratch.lazyQueue.push(Edge(startingVertexIndex, toVertexIndex, cost));
+        });
+
+        // build the pathRepresentation
+        buildPathRepresentation(pathRepresentation, scratch.lazyQueue);
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: graphChanged()                                                     *
+ *                                                                                     *
+ *   description: moves on to a new graph version and drops the cached trees, whose    *
+ *                paths may no longer be shortest once the graph changes               *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::graphChanged() {
+
+    graphVersion++;
+    shortestPathCache.clear();
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: shortestPath(std::string, std::string, PathQueryMode)              *
+ *                                                                                     *
+ *   description: finds a shortest path from one vertex to another. unlike             *
+ *                computeShortestPaths the search stops as soon as the target's        *
+ *                distance is known, so it only explores the part of the graph closer  *
+ *                to the endpoints than the target.                                    *
+ *                                                                                     *
+ *   returns: the path found. found is false if either vertex is not in the graph or   *
+ *            the target cannot be reached                                             *
+ *-------------------------------------------------------------------------------------*/
+Graph::PointToPointPath Graph::shortestPath(const std::string& sourceVertexName, const std::string& targetVertexName, PathQueryMode mode) {
+
+    // the indices of the endpoints
+    int sourceVertexIndex = getVertexIndex(sourceVertexName);
+    int targetVertexIndex = getVertexIndex(targetVertexName);
+
+    // the answer
+    PointToPointPath path;
+
+    if (sourceVertexIndex == -1 || targetVertexIndex == -1) {
+        return path;
+    }
+
+    // an undirected graph is searched from the source only, following its edges from either end
+    if (undirected) {
+        buildReverseAdjacency();
+        mode = UNIDIRECTIONAL;
+    }
+
+    // the backward searches and the landmark bounds cannot handle negative costs
+    if (mode == BIDIRECTIONAL && minEdgeCost >= 0) {
+        searchBidirectional(sourceVertexIndex, targetVertexIndex, path);
+    }
+    else if (mode == LANDMARKS && minEdgeCost >= 0 && getNumLandmarks() > 0) {
+        searchWithLandmarks(sourceVertexIndex, targetVertexIndex, path);
+    }
+    else if (mode == CONTRACTION_HIERARCHY && minEdgeCost >= 0 && hasContractionHierarchy()) {
+        searchWithContractionHierarchy(sourceVertexIndex, targetVertexIndex, path);
+    }
+    else {
+        searchForward(sourceVertexIndex, targetVertexIndex, path);
+    }
+
+    return path;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildReverseAdjacency()                                            *
+ *                                                                                     *
+ *   description: groups the edges by the vertex they go to, with a counting pass and  *
+ *                a placing pass over the CSR arrays. the incoming edges of each       *
+ *                vertex keep the order of their sources. does nothing if the reverse  *
+ *                adjacency is already built.                                          *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::buildReverseAdjacency() {
+
+    if (!reverseEdgeOffsets.empty()) {
+        return;
+    }
+
+    // where the next incoming edge of each vertex goes
+    std::vector<int> nextPositions;
+
+    // count the edges reaching each vertex, then turn the counts into offsets
+    reverseEdgeOffsets.assign(numVertices + 1, 0);
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        for (int edge = edgesBegin(curIndex); edge < edgesEnd(curIndex); edge++) {
+            reverseEdgeOffsets[edgeTargets[edge] + 1]++;
+        }
+    }
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        reverseEdgeOffsets[curIndex + 1] += reverseEdgeOffsets[curIndex];
+    }
+
+    // place each edge in the range of the vertex it goes to
+    nextPositions.assign(reverseEdgeOffsets.begin(), reverseEdgeOffsets.end() - 1);
+    reverseEdgeSources.assign(numEdges, 0);
+    reverseEdgeCosts.assign(numEdges, 0);
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        for (int edge = edgesBegin(curIndex); edge < edgesEnd(curIndex); edge++) {
+            int position = nextPositions[edgeTargets[edge]]++;
+            reverseEdgeSources[position] = curIndex;
+            reverseEdgeCosts[position] = edgeCosts[edge];
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: clearReverseAdjacency()                                            *
+ *                                                                                     *
+ *   description: drops the reverse adjacency so the next bidirectional query builds   *
+ *                it again from the changed graph                                      *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::clearReverseAdjacency() {
+
+    std::vector<int>().swap(reverseEdgeOffsets);
+    std::vector<int>().swap(reverseEdgeSources);
+    std::vector<int>().swap(reverseEdgeCosts);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: searchForward(int, int, PointToPointPath)                          *
+ *                                                                                     *
+ *   description: runs Dijkstra from the source with the same keys as                  *
+ *                buildPathRepresentationWithIndexedHeap and stops once the target is  *
+ *                found, so the path matches the one computeShortestPaths prints.      *
+ *                                                                                     *
+ *   returns: n/a. the result is stored in path                                        *
+ *-------------------------------------------------------------------------------------*/
+void Graph::searchForward(int sourceVertexIndex, int targetVertexIndex, PointToPointPath& path) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the search's working space, left clean by the last query
+    SearchSpace& search = forwardSearch;
+
+    // the vertex whose path was just found
+    int foundVertexIndex;
+
+    /*-------------------------------------------------------------------------------------*
+     *   search until the target is found                                                 *
+     *-------------------------------------------------------------------------------------*/
+    search.prepare(numVertices);
+    search.label(sourceVertexIndex, 0, END_OF_PATH);
+    search.heap.pushOrDecrease(sourceVertexIndex, 0, END_OF_PATH);
+
+    while (!search.heap.empty()) {
+
+        foundVertexIndex = search.heap.pop();
+        search.settled[foundVertexIndex] = 1;
+        path.numSettledVertices++;
+        if (foundVertexIndex == targetVertexIndex) {
+            break;
+        }
+
+        // relax the edges leaving the vertex just found
+        forEachNeighbor(foundVertexIndex, [&](int toVertexIndex, int cost) {
+            int newDistance = search.distances[foundVertexIndex] + cost;
+            if (!search.settled[toVertexIndex] && search.heap.pushOrDecrease(toVertexIndex, newDistance, foundVertexIndex)) {
+                search.label(toVertexIndex, newDistance, foundVertexIndex);
+            }
+        });
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   follow the path back from the target                                             *
+     *-------------------------------------------------------------------------------------*/
+    if (search.settled[targetVertexIndex]) {
+        path.found = true;
+        path.totalDistance = search.distances[targetVertexIndex];
+        for (int vertexIndex = targetVertexIndex; vertexIndex != END_OF_PATH; vertexIndex = search.nextVertexIndices[vertexIndex]) {
+            path.vertexNames.push_back(std::string(vertexNames.name(vertexIndex)));
+        }
+        std::reverse(path.vertexNames.begin(), path.vertexNames.end());
+    }
+
+    search.clear();
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: searchBidirectional(int, int, PointToPointPath)                    *
+ *                                                                                     *
+ *   description: runs Dijkstra forward from the source and backward from the target   *
+ *                on the reverse adjacency, always advancing the side whose next       *
+ *                distance is smaller. every edge relaxed into a vertex the other side *
+ *                has reached offers a candidate path; the search stops once the next  *
+ *                distances of the two sides add up to at least the best candidate,    *
+ *                because no path through an unsettled vertex can be shorter.          *
+ *                                                                                     *
+ *   precondition: no edge may have a negative cost                                    *
+ *                                                                                     *
+ *   returns: n/a. the result is stored in path                                        *
+ *-------------------------------------------------------------------------------------*/
+void Graph::searchBidirectional(int sourceVertexIndex, int targetVertexIndex, PointToPointPath& path) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the length of the best path found so far. wider than int because it adds two distances
+    long long bestDistance = LLONG_MAX;
+
+    // the vertex where the best path's two halves meet
+    int meetingVertexIndex = -1;
+
+    // the vertex whose distance was just settled
+    int foundVertexIndex;
+
+    /*-------------------------------------------------------------------------------------*
+     *   search from both ends                                                             *
+     *-------------------------------------------------------------------------------------*/
+    buildReverseAdjacency();
+    forwardSearch.prepare(numVertices);
+    backwardSearch.prepare(numVertices);
+    forwardSearch.label(sourceVertexIndex, 0, END_OF_PATH);
+    forwardSearch.heap.pushOrDecrease(sourceVertexIndex, 0, END_OF_PATH);
+    backwardSearch.label(targetVertexIndex, 0, END_OF_PATH);
+    backwardSearch.heap.pushOrDecrease(targetVertexIndex, 0, END_OF_PATH);
+    if (sourceVertexIndex == targetVertexIndex) {
+        bestDistance = 0;
+        meetingVertexIndex = sourceVertexIndex;
+    }
+
+    while (!forwardSearch.heap.empty() && !backwardSearch.heap.empty()
+        && (long long)forwardSearch.heap.topPriority() + backwardSearch.heap.topPriority() < bestDistance) {
+
+        // advance the side that is closer to its next vertex
+        bool searchingForward = forwardSearch.heap.topPriority() <= backwardSearch.heap.topPriority();
+        SearchSpace& search = searchingForward ? forwardSearch : backwardSearch;
+        SearchSpace& otherSearch = searchingForward ? backwardSearch : forwardSearch;
+
+        foundVertexIndex = search.heap.pop();
+        search.settled[foundVertexIndex] = 1;
+        path.numSettledVertices++;
+
+        // the edges leaving the vertex going forward, or reaching it going backward
+        int firstEdge = searchingForward ? edgesBegin(foundVertexIndex) : reverseEdgeOffsets[foundVertexIndex];
+        int lastEdge = searchingForward ? edgesEnd(foundVertexIndex) : reverseEdgeOffsets[foundVertexIndex + 1];
+
+        for (int edge = firstEdge; edge < lastEdge; edge++) {
+            int neighborIndex = searchingForward ? edgeTargets[edge] : reverseEdgeSources[edge];
+            int newDistance = search.distances[foundVertexIndex] + (searchingForward ? edgeCosts[edge] : reverseEdgeCosts[edge]);
+
+            if (!search.settled[neighborIndex] && search.heap.pushOrDecrease(neighborIndex, newDistance, foundVertexIndex)) {
+                search.label(neighborIndex, newDistance, foundVertexIndex);
+            }
+
+            // a vertex reached from both sides joins the two halves into a path
+            if (otherSearch.distances[neighborIndex] != INT_MAX
+                && (long long)search.distances[neighborIndex] + otherSearch.distances[neighborIndex] < bestDistance) {
+                bestDistance = (long long)search.distances[neighborIndex] + otherSearch.distances[neighborIndex];
+                meetingVertexIndex = neighborIndex;
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   join the two halves of the path at the meeting vertex                            *
+     *-------------------------------------------------------------------------------------*/
+    if (meetingVertexIndex != -1) {
+        path.found = true;
+        path.totalDistance = (int)bestDistance;
+        for (int vertexIndex = meetingVertexIndex; vertexIndex != END_OF_PATH; vertexIndex = forwardSearch.nextVertexIndices[vertexIndex]) {
+            path.vertexNames.push_back(std::string(vertexNames.name(vertexIndex)));
+        }
+        std::reverse(path.vertexNames.begin(), path.vertexNames.end());
+        for (int vertexIndex = backwardSearch.nextVertexIndices[meetingVertexIndex]; vertexIndex != END_OF_PATH;
+            vertexIndex = backwardSearch.nextVertexIndices[vertexIndex]) {
+            path.vertexNames.push_back(std::string(vertexNames.name(vertexIndex)));
+        }
+    }
+
+    forwardSearch.clear();
+    backwardSearch.clear();
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildLandmarks(int)                                                *
+ *                                                                                     *
+ *   description: picks landmarks with the farthest-first rule and stores the         *
+ *                distances from and to each one. the first landmark is the vertex     *
+ *                farthest from vertex 0, and each next one is the vertex farthest     *
+ *                from the landmarks already picked, counting vertices none of them   *
+ *                reach as farthest of all. ties go to the lowest index, so the same   *
+ *                graph always gets the same landmarks.                                *
+ *                                                                                     *
+ *   returns: true if the tables were built. false if the graph has no vertices or a   *
+ *            negative cost, or is undirected, in which case the old tables are        *
+ *            dropped                                                                  *
+ *-------------------------------------------------------------------------------------*/
+bool Graph::buildLandmarks(int numLandmarks) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the distances from the vertex being added as a landmark, then to it
+    std::vector<int> distances;
+
+    // the distance to each vertex from the nearest landmark picked so far
+    std::vector<int> nearestLandmarkDistances;
+
+    // the next vertex to add as a landmark
+    int nextLandmarkIndex;
+
+    /*-------------------------------------------------------------------------------------*
+     *   pick the landmarks and fill in their tables                                       *
+     *-------------------------------------------------------------------------------------*/
+    clearLandmarks();
+    if (numVertices == 0 || minEdgeCost < 0 || numLandmarks < 1 || undirected) {
+        return false;
+    }
+    numLandmarks = std::min(numLandmarks, numVertices);
+
+    landmarkVertices.assign(numLandmarks, 0);
+    landmarkDistancesFrom.assign((std::size_t)numLandmarks * numVertices, INT_MAX);
+    landmarkDistancesTo.assign((std::size_t)numLandmarks * numVertices, INT_MAX);
+
+    // start from the distances from vertex 0 so the first landmark is far from it
+    computeDistances(0, false, nearestLandmarkDistances);
+
+    for (int landmark = 0; landmark < numLandmarks; landmark++) {
+
+        // take the vertex farthest from every landmark so far
+        nextLandmarkIndex = (int)(std::max_element(nearestLandmarkDistances.begin(), nearestLandmarkDistances.end())
+            - nearestLandmarkDistances.begin());
+        landmarkVertices[landmark] = nextLandmarkIndex;
+
+        // record the distances from the landmark, and bring the nearest landmark distances up to date
+        computeDistances(nextLandmarkIndex, false, distances);
+        for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+            landmarkDistancesFrom[(std::size_t)curIndex * numLandmarks + landmark] = distances[curIndex];
+            nearestLandmarkDistances[curIndex] = (landmark == 0) ? distances[curIndex] : std::min(nearestLandmarkDistances[curIndex], distances[curIndex]);
+        }
+
+        // a landmark is never picked twice, even in a graph where every vertex is reachable at distance 0
+        nearestLandmarkDistances[nextLandmarkIndex] = -1;
+
+        // record the distances to the landmark
+        computeDistances(nextLandmarkIndex, true, distances);
+        for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+            landmarkDistancesTo[(std::size_t)curIndex * numLandmarks + landmark] = distances[curIndex];
+        }
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: computeDistances(int, bool, vector<int>)                           *
+ *                                                                                     *
+ *   description: runs a full Dijkstra on the indexed heap from sourceVertexIndex,     *
+ *                following the edges forward or, for the distances to the vertex,     *
+ *                backward over the reverse adjacency                                  *
+ *                                                                                     *
+ *   precondition: no edge may have a negative cost                                    *
+ *                                                                                     *
+ *   returns: n/a. distances is filled in, with INT_MAX where there is no path         *
+ *-------------------------------------------------------------------------------------*/
+void Graph::computeDistances(int sourceVertexIndex, bool followReverseEdges, std::vector<int>& distances) {
+
+    // the vertices reached but not settled
+    IndexedHeap nextVertexHeap(numVertices);
+
+    // the vertex whose distance was just settled
+    int foundVertexIndex;
+
+    if (followReverseEdges) {
+        buildReverseAdjacency();
+    }
+
+    distances.assign(numVertices, INT_MAX);
+    distances[sourceVertexIndex] = 0;
+    nextVertexHeap.pushOrDecrease(sourceVertexIndex, 0, 0);
+
+    while (!nextVertexHeap.empty()) {
+        foundVertexIndex = nextVertexHeap.pop();
+
+        int firstEdge = followReverseEdges ? reverseEdgeOffsets[foundVertexIndex] : edgesBegin(foundVertexIndex);
+        int lastEdge = followReverseEdges ? reverseEdgeOffsets[foundVertexIndex + 1] : edgesEnd(foundVertexIndex);
+        for (int edge = firstEdge; edge < lastEdge; edge++) {
+            int neighborIndex = followReverseEdges ? reverseEdgeSources[edge] : edgeTargets[edge];
+            int newDistance = distances[foundVertexIndex] + (followReverseEdges ? reverseEdgeCosts[edge] : edgeCosts[edge]);
+            if (newDistance < distances[neighborIndex]) {
+                distances[neighborIndex] = newDistance;
+                nextVertexHeap.pushOrDecrease(neighborIndex, newDistance, 0);
+            }
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: landmarkLowerBound(int, int)                                       *
+ *                                                                                     *
+ *   description: bounds the distance from a vertex to the target with the triangle    *
+ *                inequality. for each landmark L, dist(v, t) is at least              *
+ *                dist(L, t) - dist(L, v) and at least dist(v, L) - dist(t, L). a       *
+ *                landmark that reaches v but not t, or is reached by t but not by v,  *
+ *                proves v cannot reach t.                                             *
+ *                                                                                     *
+ *   returns: the largest bound, or INT_MAX if v cannot reach t                        *
+ *-------------------------------------------------------------------------------------*/
+int Graph::landmarkLowerBound(int vertexIndex, int targetVertexIndex) const {
+
+    // the number of landmarks
+    int numLandmarks = getNumLandmarks();
+
+    // where the vertex's and the target's distances start in the tables
+    const int* vertexDistancesFrom = landmarkDistancesFrom.data() + (std::size_t)vertexIndex * numLandmarks;
+    const int* vertexDistancesTo = landmarkDistancesTo.data() + (std::size_t)vertexIndex * numLandmarks;
+    const int* targetDistancesFrom = landmarkDistancesFrom.data() + (std::size_t)targetVertexIndex * numLandmarks;
+    const int* targetDistancesTo = landmarkDistancesTo.data() + (std::size_t)targetVertexIndex * numLandmarks;
+
+    // the best bound so far
+    int lowerBound = 0;
+
+    for (int landmark = 0; landmark < numLandmarks; landmark++) {
+        if (vertexDistancesFrom[landmark] != INT_MAX) {
+            if (targetDistancesFrom[landmark] == INT_MAX) {
+                return INT_MAX;
+            }
+            lowerBound = std::max(lowerBound, targetDistancesFrom[landmark] - vertexDistancesFrom[landmark]);
+        }
+        if (targetDistancesTo[landmark] != INT_MAX) {
+            if (vertexDistancesTo[landmark] == INT_MAX) {
+                return INT_MAX;
+            }
+            lowerBound = std::max(lowerBound, vertexDistancesTo[landmark] - targetDistancesTo[landmark]);
+        }
+    }
+
+    return lowerBound;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: clearLandmarks()                                                   *
+ *                                                                                     *
+ *   description: drops the landmark tables, whose bounds no longer hold once the      *
+ *                graph changes                                                        *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::clearLandmarks() {
+
+    landmarkVertices.clear();
+    landmarkDistancesFrom.clear();
+    landmarkDistancesTo.clear();
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: searchWithLandmarks(int, int, PointToPointPath)                    *
+ *                                                                                     *
+ *   description: runs A* from the source. a vertex's key is its distance plus the     *
+ *                landmark lower bound of what is left, which never overestimates and  *
+ *                is consistent, so the target's distance is final when it is settled  *
+ *                while the search leans toward the target instead of spreading in     *
+ *                every direction. vertices the landmarks prove cannot reach the       *
+ *                target are never queued.                                             *
+ *                                                                                     *
+ *   precondition: landmarks must be built and no edge may have a negative cost        *
+ *                                                                                     *
+ *   returns: n/a. the result is stored in path                                        *
+ *-------------------------------------------------------------------------------------*/
+void Graph::searchWithLandmarks(int sourceVertexIndex, int targetVertexIndex, PointToPointPath& path) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the search's working space, left clean by the last query
+    SearchSpace& search = forwardSearch;
+
+    // the vertex whose path was just found
+    int foundVertexIndex;
+
+    // the lower bound from the source
+    int sourceLowerBound = landmarkLowerBound(sourceVertexIndex, targetVertexIndex);
+
+    /*-------------------------------------------------------------------------------------*
+     *   search until the target is found                                                 *
+     *-------------------------------------------------------------------------------------*/
+    search.prepare(numVertices);
+    if (sourceLowerBound != INT_MAX) {
+        search.label(sourceVertexIndex, 0, END_OF_PATH);
+        search.heap.pushOrDecrease(sourceVertexIndex, sourceLowerBound, END_OF_PATH);
+    }
+
+    while (!search.heap.empty()) {
+
+        foundVertexIndex = search.heap.pop();
+        search.settled[foundVertexIndex] = 1;
+        path.numSettledVertices++;
+        if (foundVertexIndex == targetVertexIndex) {
+            break;
+        }
+
+        // relax the edges leaving the vertex just found
+        for (int edge = edgesBegin(foundVertexIndex); edge < edgesEnd(foundVertexIndex); edge++) {
+            int toVertexIndex = edgeTargets[edge];
+            int newDistance = search.distances[foundVertexIndex] + edgeCosts[edge];
+
+            // only a path at least as short as the known one can change the vertex's key
+            if (search.settled[toVertexIndex] || newDistance > search.distances[toVertexIndex]) {
+                continue;
+            }
+
+            int lowerBound = landmarkLowerBound(toVertexIndex, targetVertexIndex);
+            if (lowerBound != INT_MAX && search.heap.pushOrDecrease(toVertexIndex, newDistance + lowerBound, foundVertexIndex)) {
+                search.label(toVertexIndex, newDistance, foundVertexIndex);
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   follow the path back from the target                                             *
+     *-------------------------------------------------------------------------------------*/
+    if (search.settled[targetVertexIndex]) {
+        path.found = true;
+        path.totalDistance = search.distances[targetVertexIndex];
+        for (int vertexIndex = targetVertexIndex; vertexIndex != END_OF_PATH; vertexIndex = search.nextVertexIndices[vertexIndex]) {
+            path.vertexNames.push_back(std::string(vertexNames.name(vertexIndex)));
+        }
+        std::reverse(path.vertexNames.begin(), path.vertexNames.end());
+    }
+
+    search.clear();
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildContractionHierarchy()                                        *
+ *                                                                                     *
+ *   description: contracts the graph as it is now. the hierarchy reads the CSR arrays *
+ *                directly, so the edges of each vertex may be anywhere in them        *
+ *                                                                                     *
+ *   returns: true if the hierarchy was built. false if the graph has no vertices or a *
+ *            negative cost, or is undirected                                          *
+ *-------------------------------------------------------------------------------------*/
+bool Graph::buildContractionHierarchy() {
+
+    // the hierarchy only follows edges the way they are stored
+    if (undirected) {
+        return false;
+    }
+
+    return contractionHierarchy.build(numVertices, edgeBegins.data(), edgeEnds.data(), edgeTargets.data(), edgeCosts.data());
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: searchWithContractionHierarchy(int, int, PointToPointPath)         *
+ *                                                                                     *
+ *   description: queries the contraction hierarchy, which comes back with the         *
+ *                shortcuts already unpacked into the original vertices               *
+ *                                                                                     *
+ *   precondition: the hierarchy must be built                                         *
+ *                                                                                     *
+ *   returns: n/a. the result is stored in path                                        *
+ *-------------------------------------------------------------------------------------*/
+void Graph::searchWithContractionHierarchy(int sourceVertexIndex, int targetVertexIndex, PointToPointPath& path) {
+
+    // the indices of the vertices along the path
+    std::vector<int> pathVertexIndices;
+
+    path.found = contractionHierarchy.query(sourceVertexIndex, targetVertexIndex, path.totalDistance, pathVertexIndices,
+        path.numSettledVertices);
+    for (int vertexIndex : pathVertexIndices) {
+        path.vertexNames.push_back(std::string(vertexNames.name(vertexIndex)));
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: minimumSpanningTree()                                              *
+ *                                                                                     *
+ *   description: computes a minimum spanning tree on the engine                       *
+ *                chooseSpanningTreeEngine picks. the edges are treated as undirected. *
+ *                if buildDynamicSpanningTree keeps one, it is copied out instead.     *
+ *                                                                                     *
+ *   returns: the tree. on a graph that is not connected, a spanning forest            *
+ *-------------------------------------------------------------------------------------*/
+Graph::MinimumSpanningTree Graph::minimumSpanningTree() const {
+
+    // the minimum spanning tree
+    MinimumSpanningTree spanningTree;
+
+    if (dynamicSpanningForest.isBuilt()) {
+        buildSpanningTreeFromDynamicForest(spanningTree);
+        spanningTree.numTrees = numVertices - (int)spanningTree.edgeIndices.size();
+        return spanningTree;
+    }
+
+    switch (chooseSpanningTreeEngine()) {
+        case BORUVKA:
+            buildSpanningTreeWithBoruvka(spanningTree, numSearchThreads);
+            break;
+        case PRIM:
+            buildSpanningTreeWithPrim(spanningTree);
+            break;
+        default:
+            buildSpanningTreeWithKruskal(spanningTree);
+            break;
+    }
+    spanningTree.numTrees = numVertices - (int)spanningTree.edgeIndices.size();
+
+    return spanningTree;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: chooseSpanningTreeEngine()                                         *
+ *                                                                                     *
+ *   description: resolves the engine set with setSpanningTreeEngine.                  *
+ *                AUTOMATIC_SPANNING_TREE picks Prim's algorithm when the graph has at *
+ *                least PRIM_MIN_AVERAGE_DEGREE edges per vertex, where sorting every  *
+ *                edge costs Kruskal's algorithm more than Prim's heap work, and       *
+ *                Kruskal's algorithm on sparser graphs.                               *
+ *                                                                                     *
+ *   returns: the engine minimumSpanningTree should run                                *
+ *-------------------------------------------------------------------------------------*/
+Graph::SpanningTreeEngine Graph::chooseSpanningTreeEngine() const {
+
+    if (spanningTreeEngine != AUTOMATIC_SPANNING_TREE) {
+        return spanningTreeEngine;
+    }
+
+    return ((long long)numEdges >= (long long)PRIM_MIN_AVERAGE_DEGREE * numVertices) ? PRIM : KRUSKAL;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildSpanningTreeWithKruskal(MinimumSpanningTree)                  *
+ *                                                                                     *
+ *   description: adds the edges from the cheapest up whenever they join two separate  *
+ *                trees                                                                *
+ *                                                                                     *
+ *   returns: n/a. the edges are added to spanningTree                                 *
+ *-------------------------------------------------------------------------------------*/
+void Graph::buildSpanningTreeWithKruskal(MinimumSpanningTree& spanningTree) const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the position of every edge in the graph, cheapest first
+    std::vector<int> sortedEdges;
+
+    // the vertex each position's edge leaves
+    std::vector<int> edgeSources;
+
+    // is the spanning tree complete
+    bool spanningTreeComplete = false;
+
+    // the disjoint set that represents which vertices are connected in the spanning tree
+    DisjointSet vertexDisjSet(numVertices);
+
+    /*-------------------------------------------------------------------------------------*
+     *   compute the minimum spanning tree                                                 *
+     *-------------------------------------------------------------------------------------*/
+    // order the edges of the graph
+    sortEdgesForSpanningTree(sortedEdges, edgeSources);
+
+    // until we're down to one tree(or out of edges)
+    for (size_t next = 0; !spanningTreeComplete && next < sortedEdges.size(); next++) {
+
+        // get the next edge we want to try to add to the spanning tree
+        int edge = sortedEdges[next];
+        int fromVertexIndex = edgeSources[edge];
+        int toVertexIndex = edgeTargets[edge];
+
+        // if the vertices for the edge are not in the same tree
+        if (vertexDisjSet.find(fromVertexIndex) != vertexDisjSet.find(toVertexIndex)) {
+
+            // add the edge to the minimum spanning tree
+            spanningTree.edgeIndices.push_back(edge);
+            spanningTree.fromVertexIndices.push_back(fromVertexIndex);
+            spanningTree.totalCost += edgeCosts[edge];
+
+            // connect the two trees and check if the spanning tree is complete
+            spanningTreeComplete = (vertexDisjSet.doUnion(fromVertexIndex, toVertexIndex));
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildSpanningTreeWithBoruvka(MinimumSpanningTree, int)             *
+ *                                                                                     *
+ *   description: runs Boruvka rounds until no component has an edge out. the edges   *
+ *                are ordered by (cost, from vertex, to vertex, position), the same    *
+ *                order Kruskal's algorithm adds them in; with no two edges equal the  *
+ *                minimum spanning forest is unique, so every component can take its   *
+ *                lightest edge out at once and the rounds end with Kruskal's edges.   *
+ *                each vertex first lists its edges in either direction and sorts them *
+ *                in that order. components only grow, so an edge that is inside one   *
+ *                stays inside, and each vertex keeps a cursor past its edges that     *
+ *                are: a round moves every vertex's cursor to its first edge still     *
+ *                leaving its component, which is its lightest one out. over all the   *
+ *                rounds each edge is passed at most twice, and the sorting and        *
+ *                the cursors are split into blocks of vertices over the threads. a    *
+ *                serial pass per round takes the lightest edge of each component and  *
+ *                joins the components along them. the tree is then sorted into        *
+ *                Kruskal's order.                                                     *
+ *                                                                                     *
+ *   returns: n/a. the edges are added to spanningTree                                 *
+ *-------------------------------------------------------------------------------------*/
+void Graph::buildSpanningTreeWithBoruvka(MinimumSpanningTree& spanningTree, int numThreads) const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the vertex each position's edge leaves
+    std::vector<int> edgeSources;
+
+    // the edges each vertex is an end of, out and in, grouped by vertex and each vertex's lightest first.
+    // vertex v's run is positions incidentBegins[v] through incidentBegins[v + 1] - 1
+    std::vector<int> incidentBegins;
+    std::vector<IncidentEdge> incidentEdges;
+
+    // the first of each vertex's edges that may still leave its component
+    std::vector<int> incidentCursors;
+
+    // the component of each vertex, named by its root in the disjoint set
+    std::vector<int> componentOfVertex(numVertices);
+
+    // the lightest edge out of each vertex's component found at that vertex, then at any vertex of the
+    // component, or -1 if there is none
+    std::vector<int> lightestOfVertex(numVertices, -1);
+    std::vector<int> lightestOfComponent(numVertices, -1);
+
+    // the components joined so far
+    DisjointSet vertexDisjSet(numVertices);
+
+    // whether a round joined any components
+    bool joined = true;
+
+    // the threads, if there is more than one
+    std::unique_ptr<ThreadPool> spanningTreePool;
+
+    // true if edge lhs comes before edge rhs in Kruskal's order
+    auto lighter = [this, &edgeSources](int lhs, int rhs) {
+        return std::make_tuple(edgeCosts[lhs], edgeSources[lhs], edgeTargets[lhs], lhs)
+            < std::make_tuple(edgeCosts[rhs], edgeSources[rhs], edgeTargets[rhs], rhs);
+    };
+
+    // the same for two listed edges. the ends and position are only looked up to break ties in cost
+    auto lighterIncident = [&lighter](const IncidentEdge& lhs, const IncidentEdge& rhs) {
+        return (lhs.cost != rhs.cost) ? (lhs.cost < rhs.cost) : lighter(lhs.edge, rhs.edge);
+    };
+
+    /* runs work(blockBegin, blockEnd) over every vertex, split into blocks over the threads when there are enough */
+    auto forEachVertexBlock = [this, numThreads, &spanningTreePool](const std::function<void(int, int)>& work) {
+        if (!spanningTreePool || numVertices < MIN_PARALLEL_SEARCH_ITEMS) {
+            work(0, numVertices);
+            return;
+        }
+        int numBlocks = numThreads * BLOCKS_PER_SEARCH_THREAD;
+        for (int block = 0; block < numBlocks; block++) {
+            int blockBegin = (int)((long long)numVertices * block / numBlocks);
+            int blockEnd = (int)((long long)numVertices * (block + 1) / numBlocks);
+            spanningTreePool->submit([&work, blockBegin, blockEnd] { work(blockBegin, blockEnd); });
+        }
+        spanningTreePool->wait();
+    };
+
+    /*-------------------------------------------------------------------------------------*
+     *   list and sort the edges at both ends                                              *
+     *-------------------------------------------------------------------------------------*/
+    if (numThreads > 1) {
+        spanningTreePool.reset(new ThreadPool(numThreads));
+    }
+
+    listIncidentEdges(edgeSources, incidentBegins, incidentEdges);
+    incidentCursors.assign(incidentBegins.begin(), incidentBegins.end() - 1);
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        componentOfVertex[curIndex] = curIndex;
+    }
+
+    forEachVertexBlock([&incidentBegins, &incidentEdges, &lighterIncident](int blockBegin, int blockEnd) {
+        for (int curIndex = blockBegin; curIndex < blockEnd; curIndex++) {
+            std::sort(incidentEdges.begin() + incidentBegins[curIndex], incidentEdges.begin() + incidentBegins[curIndex + 1],
+                lighterIncident);
+        }
+    });
+
+    /*-------------------------------------------------------------------------------------*
+     *   join the components along their lightest edges until none has an edge out        *
+     *-------------------------------------------------------------------------------------*/
+    while (joined) {
+        joined = false;
+
+        // move each vertex's cursor to its lightest edge still leaving its component
+        forEachVertexBlock([&incidentBegins, &incidentEdges, &incidentCursors, &componentOfVertex, &lightestOfVertex]
+            (int blockBegin, int blockEnd) {
+            for (int curIndex = blockBegin; curIndex < blockEnd; curIndex++) {
+                int& cursor = incidentCursors[curIndex];
+                while (cursor < incidentBegins[curIndex + 1]
+                    && componentOfVertex[incidentEdges[cursor].otherVertex] == componentOfVertex[curIndex]) {
+                    cursor++;
+                }
+                lightestOfVertex[curIndex] = (cursor < incidentBegins[curIndex + 1]) ? incidentEdges[cursor].edge : -1;
+            }
+        });
+
+        // take the lightest per component
+        for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+            int& lightest = lightestOfComponent[componentOfVertex[curIndex]];
+            if (lightestOfVertex[curIndex] != -1 && (lightest == -1 || lighter(lightestOfVertex[curIndex], lightest))) {
+                lightest = lightestOfVertex[curIndex];
+            }
+        }
+
+        // join along them. two components may pick the same edge, which joins them only once
+        for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+            int edge = lightestOfComponent[curIndex];
+            if (edge == -1) {
+                continue;
+            }
+            lightestOfComponent[curIndex] = -1;
+            if (vertexDisjSet.find(edgeSources[edge]) != vertexDisjSet.find(edgeTargets[edge])) {
+                vertexDisjSet.doUnion(edgeSources[edge], edgeTargets[edge]);
+                spanningTree.edgeIndices.push_back(edge);
+                joined = true;
+            }
+        }
+
+        for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+            componentOfVertex[curIndex] = vertexDisjSet.find(curIndex);
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   list the edges in Kruskal's order                                                 *
+     *-------------------------------------------------------------------------------------*/
+    std::sort(spanningTree.edgeIndices.begin(), spanningTree.edgeIndices.end(), lighter);
+    for (int edge : spanningTree.edgeIndices) {
+        spanningTree.fromVertexIndices.push_back(edgeSources[edge]);
+        spanningTree.totalCost += edgeCosts[edge];
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildSpanningTreeWithPrim(MinimumSpanningTree)                     *
+ *                                                                                     *
+ *   description: grows one tree at a time from the lowest numbered vertex not yet in  *
+ *                a tree, always adding the lightest edge from the tree to a vertex    *
+ *                outside it. the indexed heap holds each outside vertex once, keyed   *
+ *                by the lightest edge found to it so far and lowered in place, so     *
+ *                the edges are never sorted: each is looked at once from either end   *
+ *                for O(E + V log V) heap work on a dense graph. the edges are ranked  *
+ *                by (from vertex, to vertex, position) and the heap breaks ties in    *
+ *                cost by that rank, which makes the order of the edges the same one   *
+ *                Kruskal's algorithm uses and the forest the same. the tree is then   *
+ *                sorted into Kruskal's order.                                         *
+ *                                                                                     *
+ *   returns: n/a. the edges are added to spanningTree                                 *
+ *-------------------------------------------------------------------------------------*/
+void Graph::buildSpanningTreeWithPrim(MinimumSpanningTree& spanningTree) const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the vertex each position's edge leaves
+    std::vector<int> edgeSources;
+
+    // the edges each vertex is an end of, out and in. vertex v's are positions incidentBegins[v] through
+    // incidentBegins[v + 1] - 1
+    std::vector<int> incidentBegins;
+    std::vector<IncidentEdge> incidentEdges;
+
+    /* what the tree knows of a vertex, kept together so offering an edge to it touches one record */
+    struct FringeVertex {
+        // the cost of the lightest edge found from the tree to the vertex
+        int cost;
+
+        // that edge, or -1 if none has been found
+        int edge;
+
+        // whether the vertex is in a tree yet
+        bool inTree;
+    };
+    std::vector<FringeVertex> fringeVertices(numVertices, { 0, -1, false });
+
+    // the vertices next to the tree, keyed by the cost and from vertex of their lightest edge from it
+    IndexedHeap fringe(numVertices);
+
+    // true if edge lhs comes before edge rhs in Kruskal's order
+    auto lighter = [this, &edgeSources](int lhs, int rhs) {
+        return std::make_tuple(edgeCosts[lhs], edgeSources[lhs], edgeTargets[lhs], lhs)
+            < std::make_tuple(edgeCosts[rhs], edgeSources[rhs], edgeTargets[rhs], rhs);
+    };
+
+    /*-------------------------------------------------------------------------------------*
+     *   grow a tree from each vertex no earlier tree reached                              *
+     *-------------------------------------------------------------------------------------*/
+    listIncidentEdges(edgeSources, incidentBegins, incidentEdges);
+
+    for (int rootIndex = 0; rootIndex < numVertices; rootIndex++) {
+        if (fringeVertices[rootIndex].inTree) {
+            continue;
+        }
+
+        // the root joins without an edge
+        fringe.pushOrDecrease(rootIndex, INT_MIN, INT_MIN);
+        while (!fringe.empty()) {
+            int curIndex = fringe.pop();
+            fringeVertices[curIndex].inTree = true;
+            if (fringeVertices[curIndex].edge != -1) {
+                spanningTree.edgeIndices.push_back(fringeVertices[curIndex].edge);
+            }
+
+            // offer the vertex's edges to the vertices outside the tree
+            for (int position = incidentBegins[curIndex]; position < incidentBegins[curIndex + 1]; position++) {
+                const IncidentEdge& incident = incidentEdges[position];
+                FringeVertex& other = fringeVertices[incident.otherVertex];
+                if (other.inTree || (other.edge != -1 && (incident.cost > other.cost
+                    || (incident.cost == other.cost && !lighter(incident.edge, other.edge))))) {
+                    continue;
+                }
+                other.cost = incident.cost;
+                other.edge = incident.edge;
+                fringe.pushOrDecrease(incident.otherVertex, incident.cost, edgeSources[incident.edge]);
+            }
+        }
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   list the edges in Kruskal's order                                                 *
+     *-------------------------------------------------------------------------------------*/
+    std::sort(spanningTree.edgeIndices.begin(), spanningTree.edgeIndices.end(), lighter);
+    for (int edge : spanningTree.edgeIndices) {
+        spanningTree.fromVertexIndices.push_back(edgeSources[edge]);
+        spanningTree.totalCost += edgeCosts[edge];
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: buildSpanningTreeFromDynamicForest(MinimumSpanningTree)            *
+ *                                                                                     *
+ *   description: lists the edges of the forest kept under edits, already in Kruskal's *
+ *                order, and finds where each sits among its from vertex's edges. of   *
+ *                equal edges the first stored is taken, as Kruskal's algorithm would. *
+ *                                                                                     *
+ *   returns: n/a. the edges are added to spanningTree                                 *
+ *-------------------------------------------------------------------------------------*/
+void Graph::buildSpanningTreeFromDynamicForest(MinimumSpanningTree& spanningTree) const {
+
+    // the (cost, from vertex, to vertex) of each edge of the forest
+    std::vector< std::tuple<int, int, int> > treeEdges;
+
+    dynamicSpanningForest.listTreeEdges(treeEdges);
+    spanningTree.edgeIndices.reserve(treeEdges.size());
+    spanningTree.fromVertexIndices.reserve(treeEdges.size());
+    for (const std::tuple<int, int, int>& treeEdge : treeEdges) {
+        int fromVertexIndex = std::get<1>(treeEdge);
+        int edge = edgesBegin(fromVertexIndex);
+        while (edgeTargets[edge] != std::get<2>(treeEdge) || edgeCosts[edge] != std::get<0>(treeEdge)) {
+            edge++;
+        }
+        spanningTree.edgeIndices.push_back(edge);
+        spanningTree.fromVertexIndices.push_back(fromVertexIndex);
+    }
+    spanningTree.totalCost = dynamicSpanningForest.totalCost();
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: sortEdgesForSpanningTree(vector<int>, vector<int>)                 *
+ *                                                                                     *
+ *   description: lists the position of every edge of the graph ordered by (cost, from *
+ *                vertex, to vertex), equal edges keeping the order they are stored    *
+ *                in, and notes the vertex each position's edge leaves. walking the    *
+ *                vertices in index order lists the edges by from vertex, and each     *
+ *                vertex's short run is put in target order, so an LSD radix sort on   *
+ *                the cost is all that is left. each edge becomes one 64 bit record,   *
+ *                its cost less the smallest cost in the high half and its position    *
+ *                in the low half, and every pass stably scatters the records by the   *
+ *                next SPANNING_TREE_RADIX_BITS bits of the cost, as many passes as    *
+ *                the spread of the costs needs.                                       *
+ *                                                                                     *
+ *   returns: n/a. the results are stored in edgeIndices and edgeSources               *
+ *-------------------------------------------------------------------------------------*/
+void Graph::sortEdgesForSpanningTree(std::vector<int>& edgeIndices, std::vector<int>& edgeSources) const {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the smallest and largest cost of the edges
+    int minCost = 0;
+    int maxCost = 0;
+
+    // the edges as records of cost above minCost in the high half and position in the low half,
+    // and the buffer each pass scatters them into
+    std::vector<unsigned long long> records;
+    std::vector<unsigned long long> scattered;
+
+    // the number of records in each bucket of a pass, then where each bucket starts
+    std::vector<size_t> bucketStarts(((size_t)1 << SPANNING_TREE_RADIX_BITS) + 1);
+
+    /*-------------------------------------------------------------------------------------*
+     *   list the edges                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    listEdgesBySource(edgeIndices, edgeSources);
+    for (size_t position = 0; position < edgeIndices.size(); position++) {
+        minCost = (position == 0) ? edgeCosts[edgeIndices[position]] : std::min(minCost, edgeCosts[edgeIndices[position]]);
+        maxCost = (position == 0) ? edgeCosts[edgeIndices[position]] : std::max(maxCost, edgeCosts[edgeIndices[position]]);
+    }
+
+    /*-------------------------------------------------------------------------------------*
+     *   sort the edges by cost                                                            *
+     *-------------------------------------------------------------------------------------*/
+    // the cost less minCost fits an unsigned int even when the costs span every int
+    unsigned int costSpread = (unsigned int)maxCost - (unsigned int)minCost;
+    if (costSpread == 0) {
+        return;
+    }
+
+    records.resize(edgeIndices.size());
+    scattered.resize(edgeIndices.size());
+    for (size_t position = 0; position < edgeIndices.size(); position++) {
+        unsigned int costKey = (unsigned int)edgeCosts[edgeIndices[position]] - (unsigned int)minCost;
+        records[position] = ((unsigned long long)costKey << 32) | (unsigned int)edgeIndices[position];
+    }
+
+    // one pass per SPANNING_TREE_RADIX_BITS bits of the spread, lowest first
+    for (int shift = 32; shift < 64 && (costSpread >> (shift - 32)) != 0; shift += SPANNING_TREE_RADIX_BITS) {
+        unsigned long long digitMask = ((unsigned long long)1 << SPANNING_TREE_RADIX_BITS) - 1;
+
+        std::fill(bucketStarts.begin(), bucketStarts.end(), 0);
+        for (unsigned long long record : records) {
+            bucketStarts[((record >> shift) & digitMask) + 1]++;
+        }
+        for (size_t bucket = 1; bucket < bucketStarts.size(); bucket++) {
+            bucketStarts[bucket] += bucketStarts[bucket - 1];
+        }
+        for (unsigned long long record : records) {
+            scattered[bucketStarts[(record >> shift) & digitMask]++] = record;
+        }
+        records.swap(scattered);
+    }
+
+    for (size_t position = 0; position < records.size(); position++) {
+        edgeIndices[position] = (int)(records[position] & 0xffffffffULL);
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: listEdgesBySource(vector<int>, vector<int>)                        *
+ *                                                                                     *
+ *   description: lists the position of every edge of the graph ordered by (from       *
+ *                vertex, to vertex), equal edges keeping the order they are stored    *
+ *                in, and notes the vertex each position's edge leaves. walking the    *
+ *                vertices in index order lists the edges by from vertex, and each     *
+ *                vertex's run is put in target order, by insertion when it is short   *
+ *                                                                                     *
+ *   returns: n/a. the results are stored in edgeIndices and edgeSources               *
+ *-------------------------------------------------------------------------------------*/
+void Graph::listEdgesBySource(std::vector<int>& edgeIndices, std::vector<int>& edgeSources) const {
+
+    // orders a vertex's edge positions by the vertex they go to
+    auto byTarget = [this](int lhs, int rhs) { return edgeTargets[lhs] < edgeTargets[rhs]; };
+
+    edgeIndices.clear();
+    edgeIndices.reserve(numEdges);
+    edgeSources.assign(edgeTargets.size(), -1);
+
+    /* go through the vertices of the graph */
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+
+        /* go through the edges leaving the current vertex */
+        size_t runStart = edgeIndices.size();
+        for (int edge = edgesBegin(curIndex); edge < edgesEnd(curIndex); edge++) {
+            edgeIndices.push_back(edge);
+            edgeSources[edge] = curIndex;
+        }
+
+        // put the run in target order, by insertion for the short runs most vertices have
+        if (edgeIndices.size() - runStart > SPANNING_TREE_INSERTION_SORT_EDGES) {
+            std::stable_sort(edgeIndices.begin() + runStart, edgeIndices.end(), byTarget);
+        }
+        else {
+            for (size_t next = runStart + 1; next < edgeIndices.size(); next++) {
+                int edge = edgeIndices[next];
+                size_t position = next;
+                for (; position > runStart && byTarget(edge, edgeIndices[position - 1]); position--) {
+                    edgeIndices[position] = edgeIndices[position - 1];
+                }
+                edgeIndices[position] = edge;
+            }
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: listIncidentEdges(vector<int>, vector<int>, vector<IncidentEdge>)  *
+ *                                                                                     *
+ *   description: lists every edge at both of its ends, grouped by vertex with two     *
+ *                counting passes, so the spanning tree engines can treat the edges    *
+ *                as undirected. each vertex's run lists its edges by the vertex they  *
+ *                leave. edges from a vertex to itself never join two trees and are    *
+ *                left out.                                                            *
+ *                                                                                     *
+ *   returns: n/a. the results are stored in edgeSources, incidentBegins and           *
+ *            incidentEdges                                                            *
+ *-------------------------------------------------------------------------------------*/
+void Graph::listIncidentEdges(std::vector<int>& edgeSources, std::vector<int>& incidentBegins,
+    std::vector<IncidentEdge>& incidentEdges) const {
+
+    // the next free position of each vertex's run
+    std::vector<int> incidentCursors;
+
+    edgeSources.assign(edgeTargets.size(), -1);
+    incidentBegins.assign(numVertices + 1, 0);
+
+    /* count the edges at each vertex */
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        for (int edge = edgesBegin(curIndex); edge < edgesEnd(curIndex); edge++) {
+            edgeSources[edge] = curIndex;
+            if (edgeTargets[edge] != curIndex) {
+                incidentBegins[curIndex + 1]++;
+                incidentBegins[edgeTargets[edge] + 1]++;
+            }
+        }
+    }
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        incidentBegins[curIndex + 1] += incidentBegins[curIndex];
+    }
+
+    /* place each edge at both ends */
+    incidentCursors.assign(incidentBegins.begin(), incidentBegins.end() - 1);
+    incidentEdges.resize(incidentBegins[numVertices]);
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        for (int edge = edgesBegin(curIndex); edge < edgesEnd(curIndex); edge++) {
+            if (edgeTargets[edge] != curIndex) {
+                incidentEdges[incidentCursors[curIndex]++] = { edgeCosts[edge], edgeTargets[edge], edge };
+                incidentEdges[incidentCursors[edgeTargets[edge]]++] = { edgeCosts[edge], curIndex, edge };
+            }
+        }
+    }
+}
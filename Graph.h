@@ -3,7 +3,8 @@
  *                                                                                     *
  *   File: Graph.h                                                                     *
  *                                                                                     *
- *   Desc: header file for a representation of a weighted directed graph               *
+ *   Desc: header file for a representation of a weighted graph, directed or, when     *
+ *         loaded as undirected, with each edge stored once and going both ways        *
  *                                                                                     *
  *   Author: Alex Lerch                                                                *
  *                                                                                     *
@@ -19,17 +20,96 @@
 #include<string>
 #include<queue>
 #include "DisjointSet.h"
+#include "VertexNameTable.h"
+#include "TokenScanner.h"
+#include "ThreadPool.h"
+#include "GraphArray.h"
+#include "MappedFile.h"
+#include "IndexedHeap.h"
+#include "DialBucketQueue.h"
+#include "RadixHeap.h"
+#include "ContractionHierarchy.h"
+#include "DynamicTopologicalOrder.h"
+#include "DynamicSpanningForest.h"
+#include "DistanceMatrix.h"
+#include "LruCache.h"
+#include<memory>
 #include<tuple>
 #include<climits>
+#include<algorithm>
+#include<string_view>
 
 /*-------------------------------------------------------------------------------------*
  *   class: Graph                                                                      *
  *                                                                                     *
  *   public:                                                                           *
  *                                                                                     *
+ *      public constants:                                                              *
+ *        DEFAULT_SHORTEST_PATH_CACHE_CAPACITY                                         *
+ *                                                                                     *
+ *      public enums:                                                                  *
+ *        ShortestPathEngine                                                           *
+ *        PathQueryMode                                                                *
+ *        SpanningTreeEngine                                                           *
+ *        EdgeDirection                                                                *
+ *                                                                                     *
+ *      public structs:                                                                *
+ *        PointToPointPath                                                             *
+ *        ShortestPathTree                                                             *
+ *        TopologicalOrder                                                             *
+ *        StronglyConnectedComponents                                                  *
+ *        Condensation                                                                 *
+ *        MinimumSpanningTree                                                          *
+ *                                                                                     *
  *      public functions:                                                              *
  *        readGraph                                                                    *
+ *        setNumLoadThreads                                                            *
+ *        setLoadDirection                                                             *
+ *        isUndirected                                                                 *
+ *        saveSnapshot                                                                 *
+ *        loadSnapshot                                                                 *
+ *        addVertex                                                                    *
+ *        addEdge                                                                      *
+ *        addEdgeKeepingOrder                                                          *
+ *        removeEdge                                                                   *
+ *        updateEdgeCost                                                               *
+ *        applyDeltaFile                                                               *
+ *        setShortestPathEngine                                                        *
+ *        setNumSearchThreads                                                          *
+ *        setDeltaSteppingBucketWidth                                                  *
+ *        setSpanningTreeEngine                                                        *
+ *        setShortestPathCacheCapacity                                                 *
+ *        getShortestPathCacheHits                                                     *
+ *        getShortestPathCacheMisses                                                   *
+ *        shortestPath                                                                 *
+ *        buildLandmarks                                                               *
+ *        getNumLandmarks                                                              *
+ *        buildContractionHierarchy                                                    *
+ *        hasContractionHierarchy                                                      *
+ *        buildDynamicTopologicalOrder                                                 *
+ *        hasDynamicTopologicalOrder                                                   *
+ *        buildDynamicSpanningTree                                                     *
+ *        hasDynamicSpanningTree                                                       *
+ *        dynamicTopologicalSort                                                       *
+ *        getNumVertices                                                               *
+ *        getNumEdges                                                                  *
+ *        getVertexName                                                                *
+ *        getEdgeTarget                                                                *
+ *        getEdgeCost                                                                  *
+ *        topologicalSort                                                              *
+ *        topologicalSortByLevels                                                      *
+ *        stronglyConnectedComponents                                                  *
+ *        condensation                                                                 *
+ *        shortestPathTree                                                             *
+ *        computeShortestPathsBatch                                                    *
+ *        computeAllPairsDistances                                                     *
+ *        minimumSpanningTree                                                          *
  *        printGraph                                                                   *
+ *        printTopologicalSort                                                         *
+ *        printTopologicalLevels                                                       *
+ *        printCondensation                                                            *
+ *        printShortestPathTree                                                        *
+ *        printMinimumSpanningTree                                                     *
  *        computeTopologicalSort                                                       *
  *        computeShortestPaths                                                         *
  *        computeMinimumSpanningTree                                                   *
@@ -37,53 +117,341 @@
  *   private:                                                                          *
  *                                                                                     *
  *      private structs:                                                               *
- *         AdjListVertex                                                               *
  *         PathVertex                                                                  *
  *         Edge                                                                        *
+ *         SearchSpace                                                                 *
+ *         LazyPathQueue                                                               *
+ *         ShortestPathScratch                                                         *
+ *         ShortestPathCacheKey                                                        *
+ *         ShortestPathCacheKeyHash                                                    *
+ *         IncidentEdge                                                                *
  *                                                                                     *
  *      private data members:                                                          *
- *         adjacencyList                                                               *
- *         vertexNameList                                                              *
+ *         edgeBegins                                                                  *
+ *         edgeEnds                                                                    *
+ *         edgeTargets                                                                 *
+ *         edgeCosts                                                                   *
+ *         edgeCapacityEnds                                                            *
+ *         numDeadEdgeSlots                                                            *
+ *         vertexNames                                                                 *
  *         numVertices                                                                 *
  *         numEdges                                                                    *
+ *         numLoadThreads                                                              *
+ *         shortestPathEngine                                                          *
+ *         numSearchThreads                                                            *
+ *         deltaSteppingBucketWidth                                                    *
+ *         spanningTreeEngine                                                          *
+ *         loadDirection                                                               *
+ *         undirected                                                                  *
+ *         minEdgeCost                                                                 *
+ *         maxEdgeCost                                                                 *
+ *         reverseEdgeOffsets                                                          *
+ *         reverseEdgeSources                                                          *
+ *         reverseEdgeCosts                                                            *
+ *         forwardSearch                                                               *
+ *         backwardSearch                                                              *
+ *         landmarkVertices                                                            *
+ *         landmarkDistancesFrom                                                       *
+ *         landmarkDistancesTo                                                         *
+ *         contractionHierarchy                                                        *
+ *         dynamicTopologicalOrder                                                     *
+ *         dynamicSpanningForest                                                       *
+ *         snapshotFile                                                                *
+ *         graphVersion                                                                *
+ *         shortestPathCache                                                           *
  *                                                                                     *
  *      private member functions:                                                      *
+ *         edgesBegin                                                                  *
+ *         edgesEnd                                                                    *
+ *         forEachNeighbor                                                             *
+ *         parseEdges                                                                  *
+ *         parseEdgeSectionInParallel                                                  *
+ *         foldMirroredEdges                                                           *
+ *         buildCompressedAdjacency                                                    *
+ *         makeEditable                                                                *
+ *         relocateEdges                                                               *
+ *         compactEdges                                                                *
+ *         findEdge                                                                    *
+ *         appendEdge                                                                  *
  *         getVertexIndex                                                              *
  *         setupInDegreeVector                                                         *
- *         printTopologicalSortOutput                                                  *
- *         printPathList                                                               *
- *         printShortestPathsOutput                                                    *
  *         buildPathRepresentation                                                     *
- *         populateEdgesList                                                           *
- *         calculateSpanningTreeTotalCost                                              *
- *         printMinimumSpanningTreeOutput                                              *
+ *         buildPathRepresentationWithIndexedHeap                                      *
+ *         buildPathRepresentationWithBuckets                                          *
+ *         chooseShortestPathEngine                                                    *
+ *         buildPathRepresentationWithDeltaStepping                                    *
+ *         growShortestPathTree                                                        *
+ *         copyShortestPathTree                                                        *
+ *         graphChanged                                                                *
+ *         buildReverseAdjacency                                                       *
+ *         clearReverseAdjacency                                                       *
+ *         searchForward                                                               *
+ *         searchBidirectional                                                         *
+ *         searchWithLandmarks                                                         *
+ *         computeDistances                                                            *
+ *         landmarkLowerBound                                                          *
+ *         clearLandmarks                                                              *
+ *         searchWithContractionHierarchy                                              *
+ *         buildSpanningTreeWithKruskal                                                *
+ *         buildSpanningTreeWithBoruvka                                                *
+ *         buildSpanningTreeWithPrim                                                   *
+ *         buildSpanningTreeFromDynamicForest                                          *
+ *         chooseSpanningTreeEngine                                                    *
+ *         sortEdgesForSpanningTree                                                    *
+ *         listEdgesBySource                                                           *
+ *         listIncidentEdges                                                           *
  *-------------------------------------------------------------------------------------*/
 class Graph{
-    private:
+    public:
+        // the number of trees computeShortestPaths keeps cached unless setShortestPathCacheCapacity changes it
+        static const int DEFAULT_SHORTEST_PATH_CACHE_CAPACITY = 8;
+
         /*-------------------------------------------------------------------------------------*
-         *   private structs                                                                   *
+         *   public enums                                                                      *
+         *-------------------------------------------------------------------------------------*/
+        /* the priority queues computeShortestPaths can run on. every engine prints the same output */
+        enum ShortestPathEngine {
+            // a std::priority_queue holding one entry per relaxed edge, up to O(E) entries
+            LAZY_BINARY_HEAP,
+
+            // an indexed 4-ary heap holding at most one entry per vertex, lowered in place
+            INDEXED_HEAP,
+
+            // Dial's buckets, one per distance in a window of maxEdgeCost + 1. needs non-negative costs
+            DIAL_BUCKETS,
+
+            // a monotone radix heap with 33 buckets. needs non-negative costs
+            RADIX_HEAP,
+
+            // delta-stepping on numSearchThreads threads, relaxing the edges out of a whole bucket of
+            // distances at once. needs non-negative costs
+            DELTA_STEPPING,
+
+            // picks one of the above from the range of edge costs seen at load
+            AUTOMATIC
+        };
+
+        /* the searches shortestPath can run */
+        enum PathQueryMode {
+            // Dijkstra from the source, stopping once the target is found. picks the same path computeShortestPaths would
+            UNIDIRECTIONAL,
+
+            // Dijkstra from both ends at once, the backward half on the reverse adjacency. needs non-negative
+            // costs and may pick a different path of the same weight when there are ties
+            BIDIRECTIONAL,
+
+            // A* from the source, guided by lower bounds from the landmark tables built by buildLandmarks.
+            // needs non-negative costs and may pick a different path of the same weight when there are ties
+            LANDMARKS,
+
+            // an upward search from both ends of the hierarchy built by buildContractionHierarchy. needs
+            // non-negative costs and may pick a different path of the same weight when there are ties
+            CONTRACTION_HIERARCHY
+        };
+
+        /* the algorithms minimumSpanningTree can run. every engine finds the same edges and lists them in
+           the same order, breaking ties between equal costs by from vertex, to vertex and position */
+        enum SpanningTreeEngine {
+            // Kruskal's algorithm over every edge sorted by cost, on the calling thread
+            KRUSKAL,
+
+            // Boruvka rounds on numSearchThreads threads, each component taking its lightest edge out
+            // at once. no global sort, and edges found inside a component are dropped as it grows
+            BORUVKA,
+
+            // Prim's algorithm on an indexed heap with one entry per vertex, lowered in place. no global
+            // sort, so it wins on dense graphs
+            PRIM,
+
+            // picks PRIM or KRUSKAL from the number of edges per vertex
+            AUTOMATIC_SPANNING_TREE
+        };
+
+        /* how readGraph reads the edges of a graph file */
+        enum EdgeDirection {
+            // each edge goes from its first vertex to its second only
+            DIRECTED,
+
+            // each edge goes both ways and is stored once. an edge listed again the other way round with the
+            // same cost is the same edge, so a file listing every edge both ways loads as if it listed each once
+            UNDIRECTED,
+
+            // UNDIRECTED if every edge is listed both ways with the same cost, DIRECTED otherwise
+            DETECT_DIRECTION
+        };
+
+        /*-------------------------------------------------------------------------------------*
+         *   public structs                                                                    *
          *-------------------------------------------------------------------------------------*/
-        /* represents an edge in the the adjacency list */
-        struct AdjListVertex{
+        /* the answer to a shortestPath query */
+        struct PointToPointPath {
             public:
                 /* data members */
-                // the index of the vertex that is adjacent to the vertex in the adjacencyList
-                int toIndex;
+                // true if the target can be reached from the source
+                bool found;
 
-                // cost of the edge between vector vertex and destination
-                int cost;
+                // the total cost of the path
+                int totalDistance;
+
+                // the vertices of the path, the source first and the target last. empty if there is no path
+                std::vector<std::string> vertexNames;
+
+                // the number of vertices whose shortest distance the search settled, a measure of its work
+                int numSettledVertices;
+
+                /* constructor */
+                PointToPointPath() : found(false), totalDistance(INT_MAX), numSettledVertices(0) {}
+        };
+
+        /* the shortest paths from one source to every vertex, as computed by shortestPathTree and
+           computeShortestPathsBatch. vertices are numbered in the order they are listed in the graph file */
+        struct ShortestPathTree {
+            public:
+                /* data members */
+                // the name of the source vertex
+                std::string sourceVertexName;
+
+                // the index of the source vertex, -1 if it is not in the graph
+                int sourceVertexIndex;
+
+                // true if the source is in the graph. the vectors are empty otherwise
+                bool found;
+
+                // the total cost of the path to each vertex, INT_MAX if there is none
+                std::vector<int> totalDistances;
 
-                /* operator overload */
-                bool operator<(const AdjListVertex& rhs) const {
-                    return std::tie(cost, toIndex) < std::tie(rhs.cost, rhs.toIndex);
+                // the vertex before each vertex on its path, -1 for the source and unreached vertices
+                std::vector<int> prevVertexIndices;
+
+                /* member functions */
+                // fills pathVertices with the vertices of the path to vertexIndex, the source first. the path is
+                // only walked when asked for. returns false, leaving pathVertices empty, if there is no path
+                bool pathTo(int vertexIndex, std::vector<int>& pathVertices) const {
+                    pathVertices.clear();
+                    if (!found || vertexIndex < 0 || vertexIndex >= (int)totalDistances.size() || totalDistances[vertexIndex] == INT_MAX) {
+                        return false;
+                    }
+                    for (int curIndex = vertexIndex; curIndex != -1; curIndex = prevVertexIndices[curIndex]) {
+                        pathVertices.push_back(curIndex);
+                    }
+                    std::reverse(pathVertices.begin(), pathVertices.end());
+                    return true;
+                }
+
+                /* constructor */
+                ShortestPathTree() : sourceVertexIndex(-1), found(false) {}
+        };
+
+        /* a topological order of the vertices, as computed by topologicalSort or, grouped into levels,
+           by topologicalSortByLevels. level 0 holds the vertices with no edges into them and each later
+           level the vertices whose last dependency is in the level before, so the vertices of a level can
+           all run at once */
+        struct TopologicalOrder {
+            public:
+                /* data members */
+                // true if every vertex is in the order. false if the graph has a cycle
+                bool sorted;
+
+                // the indices of the vertices in order. when the graph has a cycle, only the vertices
+                // that do not depend on one
+                std::vector<int> vertexIndices;
+
+                // where each level starts in vertexIndices, then the size of vertexIndices. level l is
+                // positions levelOffsets[l] through levelOffsets[l + 1] - 1. empty for a flat order
+                std::vector<int> levelOffsets;
+
+                /* member functions */
+                // returns the number of levels, the number of vertices on the longest chain of dependencies
+                int numLevels() const { return levelOffsets.empty() ? 0 : (int)levelOffsets.size() - 1; }
+
+                // returns the number of vertices in the largest level, the most that can ever run at once
+                int maxLevelWidth() const {
+                    int maxWidth = 0;
+                    for (int level = 0; level < numLevels(); level++) {
+                        maxWidth = std::max(maxWidth, levelOffsets[level + 1] - levelOffsets[level]);
+                    }
+                    return maxWidth;
                 }
 
                 /* constructor */
-                AdjListVertex(int toIndexValue = 0, int costValue = 0, int fromIndexValue = 0) 
-                    : toIndex(toIndexValue), cost(costValue) {}
+                TopologicalOrder() : sorted(false) {}
         };
 
+        /* the strongly connected components of the graph, as computed by stronglyConnectedComponents.
+           two vertices are in the same component if each can reach the other. the components are
+           numbered in a topological order of the condensation, so every edge between two components
+           goes from a lower number to a higher one */
+        struct StronglyConnectedComponents {
+            public:
+                /* data members */
+                // the component of each vertex
+                std::vector<int> componentOfVertex;
 
+                // the indices of the vertices grouped by component, in index order within each
+                std::vector<int> vertexIndices;
+
+                // where each component starts in vertexIndices, then the size of vertexIndices. component c
+                // is positions componentOffsets[c] through componentOffsets[c + 1] - 1
+                std::vector<int> componentOffsets;
+
+                // whether each component holds a cycle: it has more than one vertex or an edge to itself
+                std::vector<char> cyclic;
+
+                /* member functions */
+                // returns the number of components
+                int numComponents() const { return componentOffsets.empty() ? 0 : (int)componentOffsets.size() - 1; }
+
+                // returns the number of vertices in a component
+                int componentSize(int component) const { return componentOffsets[component + 1] - componentOffsets[component]; }
+
+                // returns the number of components that hold a cycle. 0 if and only if the graph can be sorted
+                int numCyclicComponents() const { return (int)std::count(cyclic.begin(), cyclic.end(), 1); }
+        };
+
+        /* the condensation of the graph, as computed by condensation: each strongly connected component
+           shrunk to one vertex, which leaves a DAG. its edges are in CSR form like the graph's */
+        struct Condensation {
+            public:
+                /* data members */
+                // the components, numbered in topological order of the condensation
+                StronglyConnectedComponents components;
+
+                // where the edges leaving each component start in edgeTargets, then the size of edgeTargets
+                std::vector<int> edgeOffsets;
+
+                // the component each edge goes to. one edge per pair of components, in increasing order
+                std::vector<int> edgeTargets;
+
+                /* member functions */
+                // returns the number of edges between components
+                int numEdges() const { return (int)edgeTargets.size(); }
+        };
+
+        /* a minimum spanning tree, as computed by minimumSpanningTree. its edges are given by their
+           position in the graph's edge arrays, which stays valid until the graph changes */
+        struct MinimumSpanningTree {
+            public:
+                /* data members */
+                // the position of each edge of the tree, in the order Kruskal's algorithm adds them
+                std::vector<int> edgeIndices;
+
+                // the vertex each edge of the tree leaves
+                std::vector<int> fromVertexIndices;
+
+                // the total cost of the edges of the tree
+                unsigned int totalCost;
+
+                // the number of trees in the forest. 1 if the graph is connected
+                int numTrees;
+
+                /* constructor */
+                MinimumSpanningTree() : totalCost(0), numTrees(0) {}
+        };
+
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private structs                                                                   *
+         *-------------------------------------------------------------------------------------*/
         /* represents a vertex in the overall path */
         struct PathVertex { 
             public:
@@ -132,14 +500,155 @@ class Graph{
                     : fromVertexIndex(fromVertexValue), toVertexIndex(toVertexValue), cost(costValue) {}
         };
 
+        /* the working space of one direction of a shortestPath search. kept between queries and reset
+           only where the last query reached, so a query costs time in the vertices it reaches and not
+           in the size of the graph */
+        struct SearchSpace {
+            public:
+                /* data members */
+                // the shortest distance found so far to each vertex, INT_MAX if it has not been reached
+                std::vector<int> distances;
+
+                // the vertex before each vertex on its path, or the vertex after it when searching backward
+                std::vector<int> nextVertexIndices;
+
+                // whether each vertex's distance is final
+                std::vector<char> settled;
+
+                // the vertices reached by the current query, so they can be reset afterward
+                std::vector<int> reachedVertices;
+
+                // the vertices reached but not settled, keyed by (distance, nextVertexIndex)
+                IndexedHeap heap;
+
+                // sizes the space for numVertices vertices, dropping anything left from a graph of another size
+                void prepare(int numVertices) {
+                    if ((int)distances.size() != numVertices) {
+                        distances.assign(numVertices, INT_MAX);
+                        nextVertexIndices.assign(numVertices, -1);
+                        settled.assign(numVertices, 0);
+                        reachedVertices.clear();
+                        heap.reset(numVertices);
+                    }
+                }
+
+                // records a shorter path to vertexIndex
+                void label(int vertexIndex, int distance, int nextVertexIndex) {
+                    if (distances[vertexIndex] == INT_MAX) {
+                        reachedVertices.push_back(vertexIndex);
+                    }
+                    distances[vertexIndex] = distance;
+                    nextVertexIndices[vertexIndex] = nextVertexIndex;
+                }
+
+                // resets the vertices the last query reached
+                void clear() {
+                    for (int vertexIndex : reachedVertices) {
+                        distances[vertexIndex] = INT_MAX;
+                        nextVertexIndices[vertexIndex] = -1;
+                        settled[vertexIndex] = 0;
+                    }
+                    reachedVertices.clear();
+                    heap.clear();
+                }
+        };
+
+        /* the lazy engine's queue, with a way to empty it that keeps its storage */
+        struct LazyPathQueue : public std::priority_queue< Edge, std::vector<Edge>, std::greater<Edge> > {
+            public:
+                // removes every entry
+                void clear() { c.clear(); }
+        };
+
+        /* everything growShortestPathTree allocates, so a caller running many searches allocates it
+           once. each thread needs its own */
+        struct ShortestPathScratch {
+            public:
+                /* data members */
+                // the tree being grown
+                std::vector<PathVertex> pathRepresentation;
+
+                // the queue of the engine in use. only the one chosen is ever sized
+                LazyPathQueue lazyQueue;
+                IndexedHeap heap;
+                DialBucketQueue dialBuckets;
+                RadixHeap radixHeap;
+
+                // the current level of a bucket engine
+                std::vector<int> level;
+        };
+
+        /* the key of a tree in the shortest path cache: its source and the version of the graph it was grown on */
+        struct ShortestPathCacheKey {
+            public:
+                /* data members */
+                // the index of the source vertex
+                int sourceVertexIndex;
+
+                // the graphVersion the tree was grown on
+                unsigned long long graphVersion;
+
+                /* operator overload to compare two keys */
+                bool operator==(const ShortestPathCacheKey& rhs) const {
+                    return sourceVertexIndex == rhs.sourceVertexIndex && graphVersion == rhs.graphVersion;
+                }
+
+                /* constructor */
+                ShortestPathCacheKey(int sourceVertexValue = -1, unsigned long long graphVersionValue = 0)
+                    : sourceVertexIndex(sourceVertexValue), graphVersion(graphVersionValue) {}
+        };
+
+        /* hashes a ShortestPathCacheKey for the cache's hash map */
+        struct ShortestPathCacheKeyHash {
+            public:
+                size_t operator()(const ShortestPathCacheKey& key) const {
+                    return std::hash<unsigned long long>()(key.graphVersion * 0x9E3779B97F4A7C15ULL + (unsigned)key.sourceVertexIndex);
+                }
+        };
+
+        /* an edge as seen from one of its ends by the spanning tree engines, carrying the cost and the other
+           end so they rarely look the edge up */
+        struct IncidentEdge {
+            public:
+                /* data members */
+                // the cost of the edge
+                int cost;
+
+                // the vertex at the other end
+                int otherVertex;
+
+                // the position of the edge
+                int edge;
+        };
+
         /*-------------------------------------------------------------------------------------*
          *   private data members                                                              *
          *-------------------------------------------------------------------------------------*/
-        // representation of the graph using an adjacency list
-        std::vector< std::list<AdjListVertex> > adjacencyList;
+        /* compressed sparse row (CSR) representation of the graph. the edges leaving vertex v are
+           stored at positions edgeBegins[v] through edgeEnds[v] - 1 of edgeTargets and edgeCosts,
+           in the order they were read from the file or added. after readGraph each vertex's range
+           ends where the next one begins; edits may move a range to the end of the arrays. after
+           loadSnapshot the arrays borrow their values from the mapped snapshot file */
+        // the position of the first edge of each vertex
+        GraphArray<int> edgeBegins;
+
+        // the position one past the last edge of each vertex
+        GraphArray<int> edgeEnds;
+
+        // the index of the vertex each edge goes to
+        GraphArray<int> edgeTargets;
+
+        // the cost of each edge
+        GraphArray<int> edgeCosts;
+
+        // the end of the space reserved for each vertex's edges. empty until the graph is first edited
+        std::vector<int> edgeCapacityEnds;
+
+        // the number of positions in edgeTargets and edgeCosts left unused by ranges that were moved
+        int numDeadEdgeSlots;
 
         // stores the names of the vertices in the graph
-        std::vector<std::string> vertexNameList;
+        VertexNameTable vertexNames;
 
         // number of vertices in the graph
         int numVertices;
@@ -147,55 +656,432 @@ class Graph{
         // number of edges in the graph
         int numEdges;
 
+        // number of threads readGraph may use to parse the edge section
+        int numLoadThreads;
+
+        // the priority queue computeShortestPaths runs on
+        ShortestPathEngine shortestPathEngine;
+
+        // number of threads the DELTA_STEPPING and BORUVKA engines may use
+        int numSearchThreads;
+
+        // the range of distances in one DELTA_STEPPING bucket, or 0 to pick it from the costs and degree
+        int deltaSteppingBucketWidth;
+
+        // the algorithm minimumSpanningTree runs
+        SpanningTreeEngine spanningTreeEngine;
+
+        // how the next readGraph reads the edges
+        EdgeDirection loadDirection;
+
+        // true if each edge goes both ways and is stored once, at the end it was listed from or, when it was
+        // listed both ways, at its lower numbered end. the searches then also follow the reverse adjacency
+        bool undirected;
+
+        // the smallest and largest edge cost seen since the graph was loaded. edits only widen the range
+        int minEdgeCost;
+        int maxEdgeCost;
+
+        /* the edges grouped by the vertex they go to, for searching backward from a target. the edges
+           reaching vertex v are at positions reverseEdgeOffsets[v] through reverseEdgeOffsets[v + 1] - 1.
+           built by the first bidirectional query, or by the first search of an undirected graph, and dropped
+           whenever the graph changes */
+        // where each vertex's incoming edges start. empty while the reverse adjacency is not built
+        std::vector<int> reverseEdgeOffsets;
+
+        // the index of the vertex each incoming edge comes from
+        std::vector<int> reverseEdgeSources;
+
+        // the cost of each incoming edge
+        std::vector<int> reverseEdgeCosts;
+
+        // the working space of shortestPath's search from the source and, when bidirectional, from the target
+        SearchSpace forwardSearch;
+        SearchSpace backwardSearch;
+
+        /* the landmark tables used by LANDMARKS queries. for landmark i and vertex v, the shortest distance
+           from the landmark to v is landmarkDistancesFrom[v * k + i] and from v to the landmark is
+           landmarkDistancesTo[v * k + i], where k is the number of landmarks, or INT_MAX where there is no
+           path. a vertex's distances sit together so a lower bound reads one run of memory. saved in
+           snapshots and dropped whenever the graph changes */
+        // the index of each landmark. empty if no landmarks are built
+        GraphArray<int> landmarkVertices;
+
+        // the distances from each landmark to every vertex
+        GraphArray<int> landmarkDistancesFrom;
+
+        // the distances from every vertex to each landmark
+        GraphArray<int> landmarkDistancesTo;
+
+        // the shortcuts and vertex order used by CONTRACTION_HIERARCHY queries. dropped whenever the graph changes
+        ContractionHierarchy contractionHierarchy;
+
+        // the topological order kept up to date by addEdgeKeepingOrder once built. follows every edit, and is
+        // dropped when an edit closes a cycle or the graph is replaced
+        DynamicTopologicalOrder dynamicTopologicalOrder;
+
+        // the minimum spanning forest kept up to date under edits once built, which minimumSpanningTree then
+        // reads instead of computing one. dropped when the graph is replaced
+        DynamicSpanningForest dynamicSpanningForest;
+
+        // the mapped snapshot the graph's arrays are borrowed from, or nullptr after a text load.
+        // shared so that copies of the graph keep the mapping alive
+        std::shared_ptr<MappedFile> snapshotFile;
+
+        // counts the changes to the graph, so a result computed on one version is never taken for another
+        unsigned long long graphVersion;
+
+        // the trees computeShortestPaths grew most recently, so asking for the same source again only
+        // prints. shared so an evicted tree stays alive while it is being printed. emptied whenever the graph changes
+        LruCache< ShortestPathCacheKey, std::shared_ptr<const ShortestPathTree>, ShortestPathCacheKeyHash > shortestPathCache;
+
         /*-------------------------------------------------------------------------------------*
          *   private member functions                                                          *
          *-------------------------------------------------------------------------------------*/
-        // returns the index of a specified vertex
-        int getVertexIndex(std::string nameOfVertexToFind);
+        // returns the position of the first edge leaving vertex
+        int edgesBegin(int vertexIndex) const { return edgeBegins[vertexIndex]; }
+
+        // returns the position one past the last edge leaving vertex
+        int edgesEnd(int vertexIndex) const { return edgeEnds[vertexIndex]; }
+
+        // calls visit(toVertexIndex, cost) for each edge leaving vertexIndex and, in an undirected graph, for
+        // each edge reaching it as well. an undirected graph's reverse adjacency must be built
+        template<typename Visit>
+        void forEachNeighbor(int vertexIndex, Visit visit) const {
+            for (int edge = edgesBegin(vertexIndex); edge < edgesEnd(vertexIndex); edge++) {
+                visit(edgeTargets[edge], edgeCosts[edge]);
+            }
+            if (undirected) {
+                for (int edge = reverseEdgeOffsets[vertexIndex]; edge < reverseEdgeOffsets[vertexIndex + 1]; edge++) {
+                    visit(reverseEdgeSources[edge], reverseEdgeCosts[edge]);
+                }
+            }
+        }
+
+        // parses 'from to cost' triples from scanner into edges. maxEdges of -1 reads until the scanner is empty
+        static bool parseEdges(TokenScanner& scanner, const VertexNameTable& nameTable, int maxEdges, std::vector<Edge>& edges);
 
-        // creates the in-degree vector used in computeTopologicalSort function
-        std::vector<int> setupInDegreeVector();
+        // parses the edge section on numLoadThreads threads. returns false if the caller should parse it serially
+        bool parseEdgeSectionInParallel(const char* sectionStart, const char* sectionEnd, const VertexNameTable& nameTable,
+            int expectedEdges, std::vector< std::vector<Edge> >& edgeBlocks);
 
-        // prints the correct output for the computeTopologicalSort function
-        void printTopologicalSortOutput(std::list<std::string>& topologicalSortOrdering, int numVerticesInSortList);
+        // drops from edgeBlocks each edge that is listed again the other way round with the same cost, keeping
+        // the copy that leaves the lower numbered end. if requireSymmetric is true and some edge is not listed
+        // both ways, leaves edgeBlocks as they are and returns false
+        bool foldMirroredEdges(std::vector< std::vector<Edge> >& edgeBlocks, bool requireSymmetric) const;
 
-        // prints out the list passed
-        void printPathList(std::list<std::string>& pathList);
+        // replaces the CSR arrays with the edges passed, keeping the order of each vertex's edges
+        void buildCompressedAdjacency(const std::vector< std::vector<Edge> >& edgeBlocks);
 
-        // prints the correct output for the computeShortestPaths function
-        void printShortestPathsOutput(std::string startingVertexName, std::vector<PathVertex>& pathRepresentation);
+        // takes ownership of borrowed arrays and sets up edgeCapacityEnds so the graph can be edited
+        void makeEditable();
+
+        // moves a vertex's edges to the end of the arrays with room for newCapacity edges
+        void relocateEdges(int vertexIndex, int newCapacity);
+
+        // rewrites the edge arrays without the positions left behind by moved ranges
+        void compactEdges();
+
+        // returns the position of the first edge from fromVertexIndex to toVertexIndex or -1 if there is none
+        int findEdge(int fromVertexIndex, int toVertexIndex) const;
+
+        // adds an edge after the other edges leaving fromVertexIndex, leaving the dynamic order to the caller
+        void appendEdge(int fromVertexIndex, int toVertexIndex, int cost);
+
+        // returns the index of a specified vertex or -1 if the vertex is not in the graph
+        int getVertexIndex(const std::string& nameOfVertexToFind) const { return vertexNames.find(nameOfVertexToFind); }
+
+        // creates the in-degree vector used in topologicalSort function
+        std::vector<int> setupInDegreeVector() const;
 
         // builds the pathRepresentation vector
         void buildPathRepresentation(std::vector<PathVertex>& pathRepresentation,
-            std::priority_queue< Edge, std::vector<Edge>, std::greater<Edge> >& nextShortestPathQueue);
+            std::priority_queue< Edge, std::vector<Edge>, std::greater<Edge> >& nextShortestPathQueue) const;
+
+        // builds the pathRepresentation vector from the starting vertex using an empty indexed heap sized for the graph
+        void buildPathRepresentationWithIndexedHeap(std::vector<PathVertex>& pathRepresentation, int startingVertexIndex,
+            IndexedHeap& nextShortestPathHeap) const;
+
+        // builds the pathRepresentation vector from the starting vertex using a DialBucketQueue or RadixHeap.
+        // levelHeap must be empty and sized for the graph
+        template<typename BucketQueue>
+        void buildPathRepresentationWithBuckets(std::vector<PathVertex>& pathRepresentation, int startingVertexIndex,
+            BucketQueue& nextShortestPathBuckets, IndexedHeap& levelHeap, std::vector<int>& level) const;
+
+        // builds the pathRepresentation vector from the starting vertex by delta-stepping on numThreads threads
+        void buildPathRepresentationWithDeltaStepping(std::vector<PathVertex>& pathRepresentation, int startingVertexIndex,
+            int numThreads) const;
+
+        // returns the engine computeShortestPaths should run on, resolving AUTOMATIC
+        ShortestPathEngine chooseShortestPathEngine() const;
+
+        // fills scratch.pathRepresentation with the shortest paths from startingVertexIndex on the chosen engine,
+        // using up to numThreads threads. only reads the graph, so several threads may grow trees at once, each
+        // with its own scratch
+        void growShortestPathTree(int startingVertexIndex, ShortestPathScratch& scratch, int numThreads) const;
+
+        // fills tree's distances and previous vertices from a pathRepresentation grown from startingVertexIndex
+        void copyShortestPathTree(int startingVertexIndex, const std::vector<PathVertex>& pathRepresentation, ShortestPathTree& tree) const;
+
+        // moves on to a new graphVersion and drops the cached trees after the graph changes
+        void graphChanged();
+
+        // builds the reverse adjacency if it is not built yet
+        void buildReverseAdjacency();
 
-        // adds the edges of the graph to edgesList. helper function for computeMinimumSpanningTree
-        void populateEdgesList(std::list<Edge>& edgesList);
+        // drops the reverse adjacency after the graph changes
+        void clearReverseAdjacency();
 
-        // calculates the total cost of the minimum spanning tree
-        unsigned int calculateSpanningTreeTotalCost(std::list<Edge>& minSpanTreeEdges);
+        // runs Dijkstra from sourceVertexIndex until targetVertexIndex is found
+        void searchForward(int sourceVertexIndex, int targetVertexIndex, PointToPointPath& path);
 
-        // prints the correct output for the computeMinimumSpanningTree function
-        void printMinimumSpanningTreeOutput(std::list<Edge>& minSpanTreeEdges, unsigned int minSpanTreeTotalCost);
+        // runs Dijkstra from both ends until the two searches prove the best meeting point
+        void searchBidirectional(int sourceVertexIndex, int targetVertexIndex, PointToPointPath& path);
+
+        // runs A* from sourceVertexIndex guided by the landmark lower bounds until targetVertexIndex is found
+        void searchWithLandmarks(int sourceVertexIndex, int targetVertexIndex, PointToPointPath& path);
+
+        // fills distances with the shortest distance from sourceVertexIndex to every vertex, or to sourceVertexIndex
+        // from every vertex when followReverseEdges is true. INT_MAX marks vertices with no path
+        void computeDistances(int sourceVertexIndex, bool followReverseEdges, std::vector<int>& distances);
+
+        // returns a lower bound on the distance from vertexIndex to targetVertexIndex, or INT_MAX if the
+        // landmarks prove there is no path
+        int landmarkLowerBound(int vertexIndex, int targetVertexIndex) const;
+
+        // drops the landmark tables after the graph changes
+        void clearLandmarks();
+
+        // finds the path with a contraction hierarchy query and turns its vertices into names
+        void searchWithContractionHierarchy(int sourceVertexIndex, int targetVertexIndex, PointToPointPath& path);
+
+        // adds the edges of a minimum spanning forest to spanningTree with Kruskal's algorithm
+        void buildSpanningTreeWithKruskal(MinimumSpanningTree& spanningTree) const;
+
+        // adds the edges of a minimum spanning forest to spanningTree with Boruvka rounds on up to numThreads
+        // threads, then puts them in the order Kruskal's algorithm would add them
+        void buildSpanningTreeWithBoruvka(MinimumSpanningTree& spanningTree, int numThreads) const;
+
+        // adds the edges of a minimum spanning forest to spanningTree with Prim's algorithm, then puts them in
+        // the order Kruskal's algorithm would add them
+        void buildSpanningTreeWithPrim(MinimumSpanningTree& spanningTree) const;
+
+        // adds the edges of the forest kept by dynamicSpanningForest to spanningTree, in the order Kruskal's
+        // algorithm would add them
+        void buildSpanningTreeFromDynamicForest(MinimumSpanningTree& spanningTree) const;
+
+        // returns the engine minimumSpanningTree runs, resolving AUTOMATIC_SPANNING_TREE from the density
+        SpanningTreeEngine chooseSpanningTreeEngine() const;
+
+        // fills edgeIndices with the position of every edge ordered by (cost, from vertex, to vertex), and
+        // edgeSources with the vertex each position's edge leaves. helper function for minimumSpanningTree
+        void sortEdgesForSpanningTree(std::vector<int>& edgeIndices, std::vector<int>& edgeSources) const;
+
+        // the same ordered by (from vertex, to vertex) only
+        void listEdgesBySource(std::vector<int>& edgeIndices, std::vector<int>& edgeSources) const;
+
+        // fills edgeSources as above, and incidentEdges with every edge but those from a vertex to itself
+        // listed at both ends. vertex v's are positions incidentBegins[v] through incidentBegins[v + 1] - 1
+        void listIncidentEdges(std::vector<int>& edgeSources, std::vector<int>& incidentBegins,
+            std::vector<IncidentEdge>& incidentEdges) const;
 
     public:
         // constructor
         Graph(int numVerticesValue = 0, int numEdgesValue = 0) : 
-            numVertices(numVerticesValue), numEdges(numEdgesValue) 
+            numDeadEdgeSlots(0), numVertices(numVerticesValue), numEdges(numEdgesValue), numLoadThreads(ThreadPool::defaultNumThreads()),
+            shortestPathEngine(AUTOMATIC), numSearchThreads(ThreadPool::defaultNumThreads()), deltaSteppingBucketWidth(0),
+            spanningTreeEngine(AUTOMATIC_SPANNING_TREE), loadDirection(DIRECTED), undirected(false), minEdgeCost(0), maxEdgeCost(0),
+            graphVersion(0), shortestPathCache(DEFAULT_SHORTEST_PATH_CACHE_CAPACITY)
         {
-            adjacencyList.resize(numVerticesValue);
-            vertexNameList.resize(numVerticesValue);
+            edgeBegins.assign(numVerticesValue, 0);
+            edgeEnds.assign(numVerticesValue, 0);
         }
 
         /*-------------------------------------------------------------------------------------*
          *   public member functions                                                           *
          *-------------------------------------------------------------------------------------*/
-        // reads in a new graph replacing old graph
+        // reads in a new graph replacing old graph. fileName may be a text graph or a snapshot
         bool readGraph(std::string fileName);
 
-        // prints the graph to cout using the same file format as fileName in readGraph
+        // writes the graph to fileName as a binary snapshot. returns false if the file could not be written
+        bool saveSnapshot(const std::string& fileName) const;
+
+        // maps a snapshot written by saveSnapshot and uses it in place, replacing the old graph.
+        // verifyChecksums reads the whole file to check it; otherwise only the header is read up front
+        bool loadSnapshot(const std::string& fileName, bool verifyChecksums = false);
+
+        // adds a vertex with no edges. returns its index, or -1 if the name is already in the graph
+        int addVertex(const std::string& vertexName);
+
+        // adds an edge after the other edges leaving fromVertexName. amortized O(1).
+        // returns false if either vertex is not in the graph
+        bool addEdge(const std::string& fromVertexName, const std::string& toVertexName, int cost);
+
+        // adds an edge only if the graph stays acyclic, keeping the dynamic topological order up to date and
+        // building it first if needed. usually far cheaper than sorting again. returns false if either vertex
+        // is not in the graph, the graph already has a cycle, or the edge would close one, in which case
+        // cycleVertexIndices holds that cycle starting with fromVertexName and then toVertexName
+        bool addEdgeKeepingOrder(const std::string& fromVertexName, const std::string& toVertexName, int cost,
+            std::vector<int>& cycleVertexIndices);
+
+        // removes the first edge from fromVertexName to toVertexName, keeping the order of the other edges.
+        // O(out-degree). returns false if there is no such edge
+        bool removeEdge(const std::string& fromVertexName, const std::string& toVertexName);
+
+        // changes the cost of the first edge from fromVertexName to toVertexName. O(out-degree).
+        // returns false if there is no such edge
+        bool updateEdgeCost(const std::string& fromVertexName, const std::string& toVertexName, int newCost);
+
+        // applies the changes listed in a delta file to the graph in memory. returns false if the file
+        // could not be read or a change is invalid, in which case the changes before it stay applied
+        bool applyDeltaFile(const std::string& fileName);
+
+        // sets the number of threads readGraph may use to parse the edges. 1 loads serially
+        void setNumLoadThreads(int numLoadThreadsValue) { numLoadThreads = (numLoadThreadsValue < 1) ? 1 : numLoadThreadsValue; }
+
+        // chooses how the next readGraph reads the edges. DIRECTED, the default, keeps every edge as listed
+        void setLoadDirection(EdgeDirection loadDirectionValue) { loadDirection = loadDirectionValue; }
+
+        // returns true if the graph was loaded as undirected, each edge stored once and going both ways
+        bool isUndirected() const { return undirected; }
+
+        // chooses the priority queue computeShortestPaths runs on. the bucket and delta-stepping engines fall back to
+        // INDEXED_HEAP if the graph has a negative cost, and DIAL_BUCKETS to RADIX_HEAP for very large costs
+        void setShortestPathEngine(ShortestPathEngine shortestPathEngineValue) { shortestPathEngine = shortestPathEngineValue; }
+
+        // sets the number of threads the DELTA_STEPPING and BORUVKA engines may use. 1 runs them on the calling thread
+        void setNumSearchThreads(int numSearchThreadsValue) { numSearchThreads = (numSearchThreadsValue < 1) ? 1 : numSearchThreadsValue; }
+
+        // sets the range of distances in one DELTA_STEPPING bucket. edges up to this cost are relaxed again
+        // each time a bucket changes, the rest once per bucket. 0 picks it from the largest cost and the
+        // average degree
+        void setDeltaSteppingBucketWidth(int bucketWidth) { deltaSteppingBucketWidth = (bucketWidth < 0) ? 0 : bucketWidth; }
+
+        // chooses the algorithm minimumSpanningTree runs. the result is the same on every engine.
+        // AUTOMATIC_SPANNING_TREE, the default, picks one from the number of edges per vertex
+        void setSpanningTreeEngine(SpanningTreeEngine spanningTreeEngineValue) { spanningTreeEngine = spanningTreeEngineValue; }
+
+        // sets how many of the trees computeShortestPaths grew most recently are kept to answer the same source
+        // again. each takes 12 bytes a vertex. 0 turns the cache off
+        void setShortestPathCacheCapacity(int numTrees) { shortestPathCache.setCapacity(numTrees); }
+
+        // returns the number of computeShortestPaths calls answered from the cache and the number that grew a tree
+        long long getShortestPathCacheHits() const { return shortestPathCache.hits(); }
+        long long getShortestPathCacheMisses() const { return shortestPathCache.misses(); }
+
+        // finds a shortest path from sourceVertexName to targetVertexName without searching the whole graph.
+        // BIDIRECTIONAL, LANDMARKS and CONTRACTION_HIERARCHY fall back to UNIDIRECTIONAL if the graph has a
+        // negative cost or is undirected, and LANDMARKS and CONTRACTION_HIERARCHY also do when their tables
+        // are not built
+        PointToPointPath shortestPath(const std::string& sourceVertexName, const std::string& targetVertexName,
+            PathQueryMode mode = UNIDIRECTIONAL);
+
+        // picks numLandmarks landmarks spread far apart and computes their distance tables for LANDMARKS
+        // queries. returns false if the graph is empty, has a negative cost or is undirected
+        bool buildLandmarks(int numLandmarks);
+
+        // returns the number of landmarks built or loaded with a snapshot
+        int getNumLandmarks() const { return (int)landmarkVertices.size(); }
+
+        // contracts the graph for CONTRACTION_HIERARCHY queries. takes far longer than a single search, so it
+        // pays off over many queries on a graph that does not change. returns false if the graph is empty,
+        // has a negative cost or is undirected
+        bool buildContractionHierarchy();
+
+        // returns true if a contraction hierarchy is built for the graph as it is
+        bool hasContractionHierarchy() const { return contractionHierarchy.isBuilt(); }
+
+        // orders the graph so addEdgeKeepingOrder can keep it ordered from then on. returns false if the
+        // graph has a cycle or is undirected
+        bool buildDynamicTopologicalOrder();
+
+        // returns true if a dynamic topological order is kept for the graph as it is
+        bool hasDynamicTopologicalOrder() const { return dynamicTopologicalOrder.isBuilt(); }
+
+        // finds a minimum spanning forest and keeps it up to date from then on: addEdge, removeEdge and
+        // updateEdgeCost swap edges in and out of it in amortized O(log V), or for a forest edge that is
+        // removed or gets dearer, in the degrees of the smaller half it leaves, instead of sorting every edge
+        // again. minimumSpanningTree then copies it out rather than running an engine
+        void buildDynamicSpanningTree();
+
+        // returns true if a minimum spanning forest is kept up to date for the graph
+        bool hasDynamicSpanningTree() const { return dynamicSpanningForest.isBuilt(); }
+
+        // returns the dynamic topological order, or an unsorted order if none is kept. it is a valid order
+        // but need not match topologicalSort's
+        TopologicalOrder dynamicTopologicalSort() const;
+
+        // returns the number of vertices in the graph
+        int getNumVertices() const { return numVertices; }
+
+        // returns the number of edges stored, counting each edge of an undirected graph once
+        int getNumEdges() const { return numEdges; }
+
+        // returns the name of a vertex. good until the graph changes
+        std::string_view getVertexName(int vertexIndex) const { return vertexNames.name(vertexIndex); }
+
+        // returns the vertex an edge goes to and its cost, given its position as in MinimumSpanningTree
+        int getEdgeTarget(int edgeIndex) const { return edgeTargets[edgeIndex]; }
+        int getEdgeCost(int edgeIndex) const { return edgeCosts[edgeIndex]; }
+
+        // computes a flat topological order of the vertices with Kahn's algorithm. an undirected graph with
+        // an edge has none
+        TopologicalOrder topologicalSort() const;
+
+        // computes a topological order grouped into levels, processing each level's edges on up to numThreads
+        // threads. the vertices of a level are in index order, so the result does not depend on numThreads
+        TopologicalOrder topologicalSortByLevels(int numThreads = ThreadPool::defaultNumThreads()) const;
+
+        // finds the strongly connected components with Tarjan's algorithm in O(V + E), keeping its own stack
+        // instead of recursing, so graphs with long paths do not overflow the call stack. on an undirected
+        // graph they are its connected components
+        StronglyConnectedComponents stronglyConnectedComponents() const;
+
+        // computes the strongly connected components and the DAG of the edges between them, in O(V + E).
+        // its components are numbered in topological order, so they can be run in that order even when
+        // topologicalSort fails
+        Condensation condensation() const;
+
+        // computes the shortest paths from startingVertexName to every vertex. a source asked for recently
+        // is answered from the cache without searching again
+        ShortestPathTree shortestPathTree(const std::string& startingVertexName);
+
+        // computes the shortest path tree of each source on numThreads threads and returns them in the
+        // order of sourceVertexNames. the graph must not change until it returns
+        std::vector<ShortestPathTree> computeShortestPathsBatch(const std::vector<std::string>& sourceVertexNames,
+            int numThreads = ThreadPool::defaultNumThreads());
+
+        // fills matrix with the shortest distance between every pair of vertices, numbered in the order they
+        // are listed in the graph file. keepPaths also keeps what matrix.path needs. takes O(V^3) time and
+        // O(V^2) memory, so it is meant for graphs of a few thousand vertices. allowSimd false forces the
+        // scalar kernel. an undirected graph's edges count both ways. returns false if the graph has a
+        // negative cycle or costs large enough to overflow
+        bool computeAllPairsDistances(DistanceMatrix& matrix, bool keepPaths = false, bool allowSimd = true) const;
+
+        // computes a minimum spanning tree on the chosen engine, treating the edges as undirected, or copies
+        // out the one buildDynamicSpanningTree keeps. on a graph that is not connected it is a spanning forest
+        MinimumSpanningTree minimumSpanningTree() const;
+
+        /* the formatting layer, in GraphOutput.cpp. these only print results computed above */
+        // prints the graph to cout using the same file format as fileName in readGraph. an undirected graph
+        // lists each edge once, so it reads back the same when loaded as UNDIRECTED
         void printGraph(); 
 
+        // prints a topological order, or that there is none
+        void printTopologicalSort(const TopologicalOrder& order);
+
+        // prints the levels of an order from topologicalSortByLevels, its number of levels and its widest level
+        void printTopologicalLevels(const TopologicalOrder& order);
+
+        // prints the components of a condensation in topological order, marking those that hold a cycle
+        void printCondensation(const Condensation& condensed);
+
+        // prints the path and cost to each vertex of a tree, or that its source does not exist
+        void printShortestPathTree(const ShortestPathTree& tree);
+
+        // prints the edges and total weight of a spanning tree
+        void printMinimumSpanningTree(const MinimumSpanningTree& spanningTree);
+
         // prints a topological sort of the graph or print error if sort not possible
         void computeTopologicalSort(); 
 
@@ -0,0 +1,186 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: GraphArray.h                                                                *
+ *                                                                                     *
+ *   Desc: header file for the array type that holds the large arrays of a graph.     *
+ *         the values are either owned by the array or borrowed from memory owned by   *
+ *         someone else, such as a mapped snapshot file, so a loaded snapshot can be   *
+ *         used in place without copying it.                                           *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef GRAPH_ARRAY_H_
+#define GRAPH_ARRAY_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<vector>
+#include<cstddef>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: GraphArray                                                                 *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        assign                                                                       *
+ *        borrow                                                                       *
+ *        makeOwned                                                                    *
+ *        isBorrowed                                                                   *
+ *        push_back                                                                    *
+ *        append                                                                       *
+ *        resize                                                                       *
+ *        reserve                                                                      *
+ *        clear                                                                        *
+ *        size                                                                         *
+ *        data                                                                         *
+ *        begin                                                                        *
+ *        end                                                                          *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         ownedValues                                                                 *
+ *         values                                                                      *
+ *         numValues                                                                   *
+ *-------------------------------------------------------------------------------------*/
+template<typename T>
+class GraphArray {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // the values when the array owns them. empty while the values are borrowed
+        std::vector<T> ownedValues;
+
+        // the first value, pointing into ownedValues or into borrowed memory
+        const T* values;
+
+        // the number of values
+        std::size_t numValues;
+
+    public:
+        // constructor
+        GraphArray() : values(nullptr), numValues(0) {}
+
+        // copies own their values unless the original was borrowing them
+        GraphArray(const GraphArray& other) : ownedValues(other.ownedValues), values(other.values), numValues(other.numValues) {
+            if (!other.isBorrowed()) {
+                values = ownedValues.data();
+            }
+        }
+        GraphArray(GraphArray&& other) noexcept : GraphArray() { *this = std::move(other); }
+        GraphArray& operator=(const GraphArray& other) {
+            if (this != &other) {
+                ownedValues = other.ownedValues;
+                numValues = other.numValues;
+                values = other.isBorrowed() ? other.values : ownedValues.data();
+            }
+            return *this;
+        }
+        GraphArray& operator=(GraphArray&& other) noexcept {
+            if (this != &other) {
+                bool otherBorrowed = other.isBorrowed();
+                ownedValues = std::move(other.ownedValues);
+                numValues = other.numValues;
+                values = otherBorrowed ? other.values : ownedValues.data();
+                other.ownedValues.clear();
+                other.values = nullptr;
+                other.numValues = 0;
+            }
+            return *this;
+        }
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // replaces the contents with numValuesValue copies of value, owned by the array
+        void assign(std::size_t numValuesValue, const T& value) {
+            ownedValues.assign(numValuesValue, value);
+            values = ownedValues.data();
+            numValues = numValuesValue;
+        }
+
+        // replaces the contents with the values in [first, last), owned by the array
+        void assign(const T* first, const T* last) {
+            ownedValues.assign(first, last);
+            values = ownedValues.data();
+            numValues = ownedValues.size();
+        }
+
+        // uses numValuesValue values at borrowedValues without copying them. the memory must
+        // outlive the array or the next call that replaces its contents
+        void borrow(const T* borrowedValues, std::size_t numValuesValue) {
+            std::vector<T>().swap(ownedValues);
+            values = borrowedValues;
+            numValues = numValuesValue;
+        }
+
+        // copies borrowed values so that the array owns them and they can be changed
+        void makeOwned() {
+            if (isBorrowed()) {
+                ownedValues.assign(values, values + numValues);
+                values = ownedValues.data();
+            }
+        }
+
+        // returns true if the values are borrowed
+        bool isBorrowed() const { return numValues != 0 && values != ownedValues.data(); }
+
+        // adds a value to the end, taking ownership of the values first if needed
+        void push_back(const T& value) {
+            makeOwned();
+            ownedValues.push_back(value);
+            values = ownedValues.data();
+            numValues++;
+        }
+
+        // adds count values to the end, taking ownership of the values first if needed
+        void append(const T* first, std::size_t count) {
+            makeOwned();
+            ownedValues.insert(ownedValues.end(), first, first + count);
+            values = ownedValues.data();
+            numValues += count;
+        }
+
+        // changes the number of values, filling new positions with value and taking ownership first if needed
+        void resize(std::size_t numValuesValue, const T& value) {
+            makeOwned();
+            ownedValues.resize(numValuesValue, value);
+            values = ownedValues.data();
+            numValues = numValuesValue;
+        }
+
+        // makes room for numValuesValue owned values
+        void reserve(std::size_t numValuesValue) {
+            makeOwned();
+            ownedValues.reserve(numValuesValue);
+            values = ownedValues.data();
+        }
+
+        // removes every value
+        void clear() {
+            ownedValues.clear();
+            values = ownedValues.data();
+            numValues = 0;
+        }
+
+        // element access. values may only be changed while the array owns them
+        const T& operator[](std::size_t index) const { return values[index]; }
+        T& operator[](std::size_t index) { return const_cast<T*>(values)[index]; }
+
+        // returns the number of values
+        std::size_t size() const { return numValues; }
+
+        // returns the first value
+        const T* data() const { return values; }
+
+        // iteration over the values
+        const T* begin() const { return values; }
+        const T* end() const { return values + numValues; }
+};
+
+
+#endif
@@ -0,0 +1,344 @@
+/*------------------------------------------------------------------------------------------------------------*
+ *                                                                                                            *
+ *   File: GraphOutput.cpp                                                                                    *
+ *                                                                                                            *
+ *   Desc: implementation file for the formatting layer of the graph class. the algorithms in Graph.cpp      *
+ *         return their results as structs of vertex and edge indices; the functions here turn those into    *
+ *         the text the menu prints, so a caller that only wants the results never pays for formatting.      *
+ *         the text goes through an OutputWriter, which formats into one large buffer and hands it to         *
+ *         std::cout's stream buffer in big writes, so printing keeps up with the algorithms.                 *
+ *                                                                                                            *
+ *   Author: Alex Lerch                                                                                       *
+ *                                                                                                            *
+ *   Functions:                                                                                               *
+ *      printGraph()  ...............................................  prints graph structure                 *
+ *      printTopologicalSort(TopologicalOrder)  .....................  prints sort to screen                  *
+ *      printTopologicalLevels(TopologicalOrder)  ...................  prints the sort level by level         *
+ *      printCondensation(Condensation)  ............................  prints the components in order         *
+ *      printShortestPathTree(ShortestPathTree)  ....................  prints the paths of a tree             *
+ *      printMinimumSpanningTree(MinimumSpanningTree)  ..............  prints the output for spanning tree    *
+ *      computeTopologicalSort()  ...................................  computes and prints the sort           *
+ *      computeShortestPaths(std::string)  ..........................  calculates and prints paths            *
+ *      computeMinimumSpanningTree()  ...............................  prints edges, weight of minimum tree   *
+ *                                                                                                            *
+ *------------------------------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include "Graph.h"
+#include "OutputWriter.h"
+#include<iostream>
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function implementations                                                          *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: printGraph()                                                       *
+ *                                                                                     *
+ *   description: prints the graph to std::cout using the same file format as          *
+ *                fileName in the readGraph(std::string) function. an undirected       *
+ *                graph lists each edge once, from the end it is stored under          *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::printGraph() {
+
+    // buffers the output on its way to std::cout
+    OutputWriter out(std::cout.rdbuf());
+
+    // print the number of vertices
+    out.write(numVertices);
+    out.write('\n');
+
+    // print the vertices with each vertex getting their own line
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        out.write(vertexNames.name(curIndex));
+        out.write('\n');
+    }
+
+    // print the number of edges
+    out.write(numEdges);
+    out.write('\n');
+
+    // print the edges with each edge getting their own line
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        std::string_view fromVertexName = vertexNames.name(curIndex);
+        for (int edge = edgesBegin(curIndex); edge < edgesEnd(curIndex); edge++) {
+            out.write(fromVertexName);
+            out.write(' ');
+            out.write(vertexNames.name(edgeTargets[edge]));
+            out.write(' ');
+            out.write(edgeCosts[edge]);
+            out.write('\n');
+        }
+    }
+
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: printTopologicalSort(TopologicalOrder)                             *
+ *                                                                                     *
+ *   description: prints a topological order to the screen, or an error message        *
+ *                indicating that a topological sort of the graph is not possible      *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::printTopologicalSort(const TopologicalOrder& order) {
+
+    // buffers the output on its way to std::cout
+    OutputWriter out(std::cout.rdbuf());
+
+    // the graph cannot be sorted and so a message indicating so is printed
+    if (!order.sorted) {
+        out.write("This graph cannot be topologically sorted.\n");
+        return;
+    }
+
+    // print out the title
+    out.write("Topological Sort:\n");
+
+    // print the vertices with an arrow after each but the last
+    for (size_t position = 0; position < order.vertexIndices.size(); position++) {
+        out.write(vertexNames.name(order.vertexIndices[position]));
+        out.write((position + 1 == order.vertexIndices.size()) ? "\n" : " --> ");
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: printTopologicalLevels(TopologicalOrder)                           *
+ *                                                                                     *
+ *   description: prints each level of an order from topologicalSortByLevels on its    *
+ *                own line, then the number of levels, which is the length of the      *
+ *                longest chain of dependencies, and the size of the widest level      *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::printTopologicalLevels(const TopologicalOrder& order) {
+
+    // buffers the output on its way to std::cout
+    OutputWriter out(std::cout.rdbuf());
+
+    // the graph cannot be sorted and so a message indicating so is printed
+    if (!order.sorted) {
+        out.write("This graph cannot be topologically sorted.\n");
+        return;
+    }
+
+    // print out the title
+    out.write("Topological Levels:\n");
+
+    // print each level with its vertices separated by spaces
+    for (int level = 0; level < order.numLevels(); level++) {
+        out.write("Level ");
+        out.write(level + 1);
+        out.write(':');
+        for (int position = order.levelOffsets[level]; position < order.levelOffsets[level + 1]; position++) {
+            out.write(' ');
+            out.write(vertexNames.name(order.vertexIndices[position]));
+        }
+        out.write('\n');
+    }
+
+    // print the length of the critical path and the most vertices that can run at once
+    out.write("Critical path length: ");
+    out.write(order.numLevels());
+    out.write(", widest level: ");
+    out.write(order.maxLevelWidth());
+    out.write('\n');
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: printCondensation(Condensation)                                    *
+ *                                                                                     *
+ *   description: prints each strongly connected component on its own line in         *
+ *                topological order, marking the ones that hold a cycle, then how      *
+ *                many components, cycles and edges between components there are      *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::printCondensation(const Condensation& condensed) {
+
+    // the components being printed
+    const StronglyConnectedComponents& components = condensed.components;
+
+    // buffers the output on its way to std::cout
+    OutputWriter out(std::cout.rdbuf());
+
+    // print out the title
+    out.write("Strongly Connected Components:\n");
+
+    // print each component with its vertices separated by spaces
+    for (int component = 0; component < components.numComponents(); component++) {
+        out.write("Component ");
+        out.write(component + 1);
+        out.write(':');
+        for (int position = components.componentOffsets[component]; position < components.componentOffsets[component + 1]; position++) {
+            out.write(' ');
+            out.write(vertexNames.name(components.vertexIndices[position]));
+        }
+        out.write(components.cyclic[component] ? " (cycle)\n" : "\n");
+    }
+
+    // print the size of the condensation
+    out.write("Components: ");
+    out.write(components.numComponents());
+    out.write(", with a cycle: ");
+    out.write(components.numCyclicComponents());
+    out.write(", edges between components: ");
+    out.write(condensed.numEdges());
+    out.write('\n');
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: printShortestPathTree(ShortestPathTree)                            *
+ *                                                                                     *
+ *   description: prints the path and cost from the source of a tree to each other     *
+ *                vertex, or that there is no path. each path is walked back from its  *
+ *                end into one reused vector of indices, and the names are printed     *
+ *                straight from the name table without being copied                    *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::printShortestPathTree(const ShortestPathTree& tree) {
+
+    /*-------------------------------------------------------------------------------------*
+     *   variables used                                                                    *
+     *-------------------------------------------------------------------------------------*/
+    // the vertices of the path being printed, the source first
+    std::vector<int> pathVertices;
+
+    // buffers the output on its way to std::cout
+    OutputWriter out(std::cout.rdbuf());
+
+    /*-------------------------------------------------------------------------------------*
+     *   print the output                                                                  *
+     *-------------------------------------------------------------------------------------*/
+    if (!tree.found || tree.sourceVertexIndex < 0 || tree.sourceVertexIndex >= numVertices || (int)tree.totalDistances.size() != numVertices) {
+        out.write("Vertex ");
+        out.write(tree.sourceVertexName);
+        out.write(" does not exist in this graph.\n");
+        return;
+    }
+
+    /* print label for output and go through each vertex to print out its path */
+    out.write("Shortest paths from ");
+    out.write(tree.sourceVertexName);
+    out.write(":\n");
+    for (int curIndex = 0; curIndex < numVertices; curIndex++) {
+        if (curIndex == tree.sourceVertexIndex) {
+            continue;
+        }
+
+        // if a path to the vertex has been found
+        if (tree.pathTo(curIndex, pathVertices)) {
+            for (size_t position = 0; position < pathVertices.size(); position++) {
+                out.write(vertexNames.name(pathVertices[position]));
+                out.write((position + 1 == pathVertices.size()) ? "" : " --> ");
+            }
+
+            // print weight of the path
+            out.write(" || Weight: ");
+            out.write(tree.totalDistances[curIndex]);
+            out.write('\n');
+        }
+        else {
+            out.write("No path from ");
+            out.write(tree.sourceVertexName);
+            out.write(" to ");
+            out.write(vertexNames.name(curIndex));
+            out.write(" found.\n");
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: printMinimumSpanningTree(MinimumSpanningTree)                      *
+ *                                                                                     *
+ *   description: prints the edges, edge weight, and total weight of a spanning tree   *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::printMinimumSpanningTree(const MinimumSpanningTree& spanningTree) {
+
+    // buffers the output on its way to std::cout
+    OutputWriter out(std::cout.rdbuf());
+
+    out.write("Minimum Spanning Tree:\n");
+
+    /* go through the spanning tree and print out the edges and their cost */
+    for (size_t position = 0; position < spanningTree.edgeIndices.size(); position++) {
+        int edge = spanningTree.edgeIndices[position];
+        out.write(vertexNames.name(spanningTree.fromVertexIndices[position]));
+        out.write(" -- ");
+        out.write(vertexNames.name(edgeTargets[edge]));
+        out.write(" || Weight: ");
+        out.write(edgeCosts[edge]);
+        out.write('\n');
+    }
+
+    // print out the total cost of the minimum spanning tree
+    out.write("Total Cost: ");
+    out.write(spanningTree.totalCost);
+    out.write('\n');
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: computeTopologicalSort()                                           *
+ *                                                                                     *
+ *   description: prints to standard output a topological sort of the graph or an      *
+ *                error message indicating that a topological sort of the graph is     *
+ *                not possible.                                                        *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::computeTopologicalSort() {
+
+    printTopologicalSort(topologicalSort());
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: computeShortestPaths(std::string)                                  *
+ *                                                                                     *
+ *   description: computes and prints out the path and cost from the parameter vertex  *
+ *                to each other reachable vertex in the graph.                         *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::computeShortestPaths(std::string startingVertexName) {
+
+    printShortestPathTree(shortestPathTree(startingVertexName));
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: computeMinimumSpanningTree()                                       *
+ *                                                                                     *
+ *   description: computes the minimum spanning tree, then prints the edges, edge      *
+ *                weight, and total weight of the tree.                                *
+ *                                                                                     *
+ *   precondition: the graph must be connected                                         *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void Graph::computeMinimumSpanningTree() {
+
+    printMinimumSpanningTree(minimumSpanningTree());
+}
@@ -0,0 +1,200 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: IndexedHeap.cpp                                                             *
+ *                                                                                     *
+ *   Desc: implementation file for an indexed 4-ary min heap                           *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *   Functions:                                                                        *
+ *      reset(int)  ....................  empties and resizes the heap                 *
+ *      clear()  .......................  empties the heap                             *
+ *      pushOrDecrease(int, int, int)  .  adds an item or lowers its key               *
+ *      pop()  .........................  removes the smallest entry                   *
+ *      moveUp(int)  ...................  restores the heap above a position           *
+ *      moveDown(int)  .................  restores the heap below a position           *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include "IndexedHeap.h"
+
+/*-------------------------------------------------------------------------------------*
+ *   constants                                                                         *
+ *-------------------------------------------------------------------------------------*/
+const int HEAP_ARITY = 4; // the number of children of each entry. a wider heap is shallower and its children sit together in memory
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function implementations                                                          *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: reset(int)                                                         *
+ *                                                                                     *
+ *   description: empties the heap and sizes the position map for numItems items      *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void IndexedHeap::reset(int numItems) {
+
+    entries.clear();
+    entries.reserve(numItems);
+    positions.assign(numItems, -1);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: clear()                                                            *
+ *                                                                                     *
+ *   description: empties the heap without touching the position map of items that    *
+ *                are not in it, so a heap can be reused cheaply by a search that only *
+ *                reached a few items                                                  *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void IndexedHeap::clear() {
+
+    for (const HeapEntry& curEntry : entries) {
+        positions[curEntry.item] = -1;
+    }
+    entries.clear();
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: pushOrDecrease(int, int, int)                                      *
+ *                                                                                     *
+ *   description: adds item with the key (priority, tieBreak). if item is already in   *
+ *                the heap its key is replaced only when the new key is smaller.       *
+ *                                                                                     *
+ *   returns: true if the item was added or its key was lowered. false otherwise       *
+ *-------------------------------------------------------------------------------------*/
+bool IndexedHeap::pushOrDecrease(int item, int priority, int tieBreak) {
+
+    // the entry being added
+    HeapEntry newEntry(priority, tieBreak, item);
+
+    if (positions[item] == -1) {
+        positions[item] = (int)entries.size();
+        entries.push_back(newEntry);
+    }
+    else if (newEntry < entries[positions[item]]) {
+        entries[positions[item]] = newEntry;
+    }
+    else {
+        return false;
+    }
+
+    moveUp(positions[item]);
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: pop()                                                              *
+ *                                                                                     *
+ *   description: removes the entry with the smallest key. the last entry takes its    *
+ *                place and is moved down.                                             *
+ *                                                                                     *
+ *   precondition: the heap must not be empty                                          *
+ *                                                                                     *
+ *   returns: the item of the removed entry                                            *
+ *-------------------------------------------------------------------------------------*/
+int IndexedHeap::pop() {
+
+    // the item being removed
+    int smallestItem = entries[0].item;
+
+    positions[smallestItem] = -1;
+    if (entries.size() > 1) {
+        entries[0] = entries.back();
+        positions[entries[0].item] = 0;
+        entries.pop_back();
+        moveDown(0);
+    }
+    else {
+        entries.pop_back();
+    }
+
+    return smallestItem;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: moveUp(int)                                                        *
+ *                                                                                     *
+ *   description: moves the entry at position toward the root while it is smaller     *
+ *                than its parent. the entry is held aside and written once.           *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void IndexedHeap::moveUp(int position) {
+
+    // the entry being moved
+    HeapEntry movingEntry = entries[position];
+
+    while (position > 0) {
+        int parent = (position - 1) / HEAP_ARITY;
+        if ( !(movingEntry < entries[parent]) ) {
+            break;
+        }
+        entries[position] = entries[parent];
+        positions[entries[position].item] = position;
+        position = parent;
+    }
+
+    entries[position] = movingEntry;
+    positions[movingEntry.item] = position;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: moveDown(int)                                                      *
+ *                                                                                     *
+ *   description: moves the entry at position toward the leaves while one of its      *
+ *                children is smaller. the entry is held aside and written once.       *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void IndexedHeap::moveDown(int position) {
+
+    // the entry being moved
+    HeapEntry movingEntry = entries[position];
+
+    // the number of entries in the heap
+    int numEntries = (int)entries.size();
+
+    while (true) {
+        int firstChild = HEAP_ARITY * position + 1;
+        if (firstChild >= numEntries) {
+            break;
+        }
+
+        // find the smallest child
+        int smallestChild = firstChild;
+        int lastChild = (firstChild + HEAP_ARITY < numEntries) ? firstChild + HEAP_ARITY : numEntries;
+        for (int child = firstChild + 1; child < lastChild; child++) {
+            if (entries[child] < entries[smallestChild]) {
+                smallestChild = child;
+            }
+        }
+
+        if ( !(entries[smallestChild] < movingEntry) ) {
+            break;
+        }
+        entries[position] = entries[smallestChild];
+        positions[entries[position].item] = position;
+        position = smallestChild;
+    }
+
+    entries[position] = movingEntry;
+    positions[movingEntry.item] = position;
+}
@@ -0,0 +1,131 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: IndexedHeap.h                                                               *
+ *                                                                                     *
+ *   Desc: header file for an indexed 4-ary min heap of the items 0 to numItems - 1.   *
+ *         each item is in the heap at most once and a position map lets its key be   *
+ *         lowered in place, so the heap never holds more than numItems entries.       *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef INDEXED_HEAP_H_
+#define INDEXED_HEAP_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<vector>
+#include<tuple>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: IndexedHeap                                                                *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        reset                                                                        *
+ *        clear                                                                        *
+ *        empty                                                                        *
+ *        size                                                                         *
+ *        contains                                                                     *
+ *        topPriority                                                                  *
+ *        pushOrDecrease                                                               *
+ *        pop                                                                          *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private structs:                                                               *
+ *         HeapEntry                                                                   *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         entries                                                                     *
+ *         positions                                                                   *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         moveUp                                                                      *
+ *         moveDown                                                                    *
+ *-------------------------------------------------------------------------------------*/
+class IndexedHeap {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private structs                                                                   *
+         *-------------------------------------------------------------------------------------*/
+        /* an item and its key. entries are ordered by (priority, tieBreak, item) */
+        struct HeapEntry {
+            public:
+                /* data members */
+                // the main part of the key
+                int priority;
+
+                // decides between entries with the same priority
+                int tieBreak;
+
+                // the item this entry belongs to
+                int item;
+
+                /* operator overload to compare the keys of two entries */
+                bool operator<(const HeapEntry& rhs) const {
+                    return std::tie(priority, tieBreak, item) < std::tie(rhs.priority, rhs.tieBreak, rhs.item);
+                }
+
+                /* constructor */
+                HeapEntry(int priorityValue = 0, int tieBreakValue = 0, int itemValue = -1)
+                    : priority(priorityValue), tieBreak(tieBreakValue), item(itemValue) {}
+        };
+
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // the heap. the children of entries[i] are entries[4i + 1] through entries[4i + 4]
+        std::vector<HeapEntry> entries;
+
+        // where each item is in entries, or -1 if it is not in the heap
+        std::vector<int> positions;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // moves the entry at position up until its parent is smaller
+        void moveUp(int position);
+
+        // moves the entry at position down until its children are larger
+        void moveDown(int position);
+
+    public:
+        // constructor
+        IndexedHeap(int numItems = 0) { reset(numItems); }
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // empties the heap and makes room for the items 0 to numItems - 1
+        void reset(int numItems);
+
+        // empties the heap in time proportional to the entries left in it, keeping its size
+        void clear();
+
+        // returns true if the heap has no entries
+        bool empty() const { return entries.empty(); }
+
+        // returns the number of entries in the heap
+        int size() const { return (int)entries.size(); }
+
+        // returns true if item is in the heap
+        bool contains(int item) const { return positions[item] != -1; }
+
+        // returns the priority of the entry with the smallest key
+        // precondition: the heap must not be empty
+        int topPriority() const { return entries[0].priority; }
+
+        // adds item with the key passed, or lowers its key if it is already in the heap with a larger one.
+        // returns true if the heap changed
+        bool pushOrDecrease(int item, int priority, int tieBreak);
+
+        // removes the entry with the smallest key and returns its item
+        // precondition: the heap must not be empty
+        int pop();
+};
+
+
+#endif
@@ -0,0 +1,144 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: LruCache.h                                                                  *
+ *                                                                                     *
+ *   Desc: header file for a bounded cache that keeps the values most recently used   *
+ *         and evicts the least recently used one once it is full. a hash map finds    *
+ *         an entry and a list keeps the entries in order of use, so a lookup and an   *
+ *         insert are both O(1). counts its hits and misses.                           *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef LRU_CACHE_H_
+#define LRU_CACHE_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<list>
+#include<unordered_map>
+#include<utility>
+#include<functional>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: LruCache                                                                   *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        find                                                                         *
+ *        insert                                                                       *
+ *        clear                                                                        *
+ *        setCapacity                                                                  *
+ *        capacity                                                                     *
+ *        size                                                                         *
+ *        hits                                                                         *
+ *        misses                                                                       *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         entries                                                                     *
+ *         positions                                                                   *
+ *         maxEntries                                                                  *
+ *         numHits                                                                     *
+ *         numMisses                                                                   *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         evictToCapacity                                                             *
+ *-------------------------------------------------------------------------------------*/
+template<typename Key, typename Value, typename KeyHash = std::hash<Key> >
+class LruCache {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // the cached keys and values, the most recently used first
+        std::list< std::pair<Key, Value> > entries;
+
+        // where each cached key is in entries
+        std::unordered_map<Key, typename std::list< std::pair<Key, Value> >::iterator, KeyHash> positions;
+
+        // the most entries the cache keeps. 0 turns the cache off
+        int maxEntries;
+
+        // the number of finds that found their key and that did not
+        long long numHits;
+        long long numMisses;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // drops the least recently used entries until there are at most maxEntries
+        void evictToCapacity() {
+            while ((int)entries.size() > maxEntries) {
+                positions.erase(entries.back().first);
+                entries.pop_back();
+            }
+        }
+
+    public:
+        // constructor
+        LruCache(int maxEntriesValue = 0) : maxEntries((maxEntriesValue < 0) ? 0 : maxEntriesValue), numHits(0), numMisses(0) {}
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // returns the value cached for key, marking it the most recently used, or nullptr if it is not cached.
+        // the pointer is good until the next insert, clear or setCapacity
+        const Value* find(const Key& key) {
+            auto position = positions.find(key);
+            if (position == positions.end()) {
+                numMisses++;
+                return nullptr;
+            }
+            numHits++;
+            entries.splice(entries.begin(), entries, position->second);
+            return &position->second->second;
+        }
+
+        // caches value for key as the most recently used, replacing any value already cached for it and
+        // evicting the least recently used entry if the cache is full. does nothing while the cache is off
+        void insert(const Key& key, Value value) {
+            if (maxEntries == 0) {
+                return;
+            }
+            auto position = positions.find(key);
+            if (position != positions.end()) {
+                position->second->second = std::move(value);
+                entries.splice(entries.begin(), entries, position->second);
+                return;
+            }
+            entries.emplace_front(key, std::move(value));
+            positions[key] = entries.begin();
+            evictToCapacity();
+        }
+
+        // drops every entry, keeping the counters
+        void clear() {
+            entries.clear();
+            positions.clear();
+        }
+
+        // changes the most entries the cache keeps, evicting the least recently used ones beyond it. 0 turns it off
+        void setCapacity(int maxEntriesValue) {
+            maxEntries = (maxEntriesValue < 0) ? 0 : maxEntriesValue;
+            evictToCapacity();
+        }
+
+        // returns the most entries the cache keeps
+        int capacity() const { return maxEntries; }
+
+        // returns the number of entries cached
+        int size() const { return (int)entries.size(); }
+
+        // returns the number of finds that found their key
+        long long hits() const { return numHits; }
+
+        // returns the number of finds that did not find their key
+        long long misses() const { return numMisses; }
+};
+
+
+#endif
@@ -0,0 +1,95 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: MappedFile.cpp                                                              *
+ *                                                                                     *
+ *   Desc: implementation file for a read-only memory mapping of a whole file          *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *   Functions:                                                                        *
+ *      open(std::string, bool)  .......  maps a file                                  *
+ *      close()  .......................  releases the mapping                         *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include "MappedFile.h"
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<fcntl.h>
+#include<unistd.h>
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function implementations                                                          *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: open(std::string, bool)                                            *
+ *                                                                                     *
+ *   description: maps the whole of fileName read-only. an empty file is a valid      *
+ *                mapping of size zero.                                                *
+ *                                                                                     *
+ *   returns: true if the file could be mapped. false otherwise                        *
+ *-------------------------------------------------------------------------------------*/
+bool MappedFile::open(const std::string& fileName, bool sequentialAccess) {
+
+    // variables used
+    int fileDescriptor; // the open file
+    struct stat fileStatus; // used to get the size of the file
+    void* mapping; // the new mapping
+
+    close();
+
+    fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+    if (fileDescriptor == -1) {
+        return false;
+    }
+
+    // only regular files can be mapped
+    if (fstat(fileDescriptor, &fileStatus) == -1 || !S_ISREG(fileStatus.st_mode)) {
+        ::close(fileDescriptor);
+        return false;
+    }
+
+    // mmap rejects a length of zero, so an empty file maps to nothing
+    if (fileStatus.st_size == 0) {
+        ::close(fileDescriptor);
+        return true;
+    }
+
+    mapping = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+    // the mapping stays valid after the descriptor is closed
+    ::close(fileDescriptor);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    // let the kernel read ahead when the file is read front to back
+    madvise(mapping, fileStatus.st_size, sequentialAccess ? MADV_SEQUENTIAL : MADV_RANDOM);
+
+    mappedData = (char*)mapping;
+    mappedSize = fileStatus.st_size;
+    return true;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: close()                                                            *
+ *                                                                                     *
+ *   description: releases the mapping if there is one                                 *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void MappedFile::close() {
+
+    if (mappedData != nullptr) {
+        munmap(mappedData, mappedSize);
+        mappedData = nullptr;
+    }
+    mappedSize = 0;
+}
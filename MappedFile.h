@@ -0,0 +1,77 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: MappedFile.h                                                                *
+ *                                                                                     *
+ *   Desc: header file for a read-only memory mapping of a whole file. the mapping     *
+ *         is released when the object is destroyed.                                   *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<string>
+#include<cstddef>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: MappedFile                                                                 *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        open                                                                         *
+ *        close                                                                        *
+ *        data                                                                         *
+ *        size                                                                         *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         mappedData                                                                  *
+ *         mappedSize                                                                  *
+ *-------------------------------------------------------------------------------------*/
+class MappedFile {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // the first byte of the mapping, or nullptr if nothing is mapped
+        char* mappedData;
+
+        // the number of bytes mapped
+        std::size_t mappedSize;
+
+    public:
+        // constructor
+        MappedFile() : mappedData(nullptr), mappedSize(0) {}
+
+        // destructor
+        ~MappedFile() { close(); }
+
+        // a mapping has one owner
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // maps fileName read-only, replacing any current mapping. sequentialAccess tells the kernel the
+        // file will be read front to back. returns false if it could not be mapped
+        bool open(const std::string& fileName, bool sequentialAccess = true);
+
+        // releases the mapping
+        void close();
+
+        // returns the first byte of the file
+        const char* data() const { return mappedData; }
+
+        // returns the number of bytes in the file
+        std::size_t size() const { return mappedSize; }
+};
+
+
+#endif
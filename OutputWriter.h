@@ -0,0 +1,128 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: OutputWriter.h                                                              *
+ *                                                                                     *
+ *   Desc: header file for a buffered text sink for large outputs. text and numbers    *
+ *         are formatted straight into one large buffer, the numbers with              *
+ *         std::to_chars instead of a stream's locale-aware formatting, and the        *
+ *         buffer is handed to the target stream buffer in a single write when it      *
+ *         fills. it writes the same bytes operator<< would.                           *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef OUTPUT_WRITER_H_
+#define OUTPUT_WRITER_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<vector>
+#include<string_view>
+#include<streambuf>
+#include<cstring>
+#include<charconv>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: OutputWriter                                                               *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        write                                                                        *
+ *        flush                                                                        *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         target                                                                      *
+ *         buffer                                                                      *
+ *         numBuffered                                                                 *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         writeInteger                                                                *
+ *-------------------------------------------------------------------------------------*/
+class OutputWriter {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // where the text goes when the buffer is flushed
+        std::streambuf* target;
+
+        // the text not yet flushed, in its first numBuffered characters
+        std::vector<char> buffer;
+        size_t numBuffered;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // formats an integer of any type into the buffer
+        template<typename Integer>
+        void writeInteger(Integer value) {
+            // the longest integer is 20 digits and a sign
+            const size_t MAX_INTEGER_CHARS = 21;
+            if (buffer.size() - numBuffered < MAX_INTEGER_CHARS) {
+                flush();
+            }
+            numBuffered = std::to_chars(buffer.data() + numBuffered, buffer.data() + buffer.size(), value).ptr - buffer.data();
+        }
+
+    public:
+        // the size of the buffer unless the constructor is given another
+        static const size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+        // constructor
+        OutputWriter(std::streambuf* targetValue, size_t bufferSize = DEFAULT_BUFFER_SIZE)
+            : target(targetValue), buffer((bufferSize < 64) ? 64 : bufferSize), numBuffered(0) {}
+
+        // destructor. flushes what is left
+        ~OutputWriter() { flush(); }
+
+        // an OutputWriter owns its buffer and is not copied
+        OutputWriter(const OutputWriter&) = delete;
+        OutputWriter& operator=(const OutputWriter&) = delete;
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // appends text. text longer than the buffer is written through without being copied
+        void write(std::string_view text) {
+            if (buffer.size() - numBuffered < text.size()) {
+                flush();
+                if (text.size() > buffer.size()) {
+                    target->sputn(text.data(), (std::streamsize)text.size());
+                    return;
+                }
+            }
+            std::memcpy(buffer.data() + numBuffered, text.data(), text.size());
+            numBuffered += text.size();
+        }
+
+        // appends one character
+        void write(char character) {
+            if (numBuffered == buffer.size()) {
+                flush();
+            }
+            buffer[numBuffered++] = character;
+        }
+
+        // appends text that ends at its first null character
+        void write(const char* text) { write(std::string_view(text)); }
+
+        // appends an integer in decimal
+        void write(int value) { writeInteger(value); }
+        void write(unsigned int value) { writeInteger(value); }
+        void write(long long value) { writeInteger(value); }
+
+        // hands the buffered text to the target stream buffer in one write
+        void flush() {
+            if (numBuffered > 0) {
+                target->sputn(buffer.data(), (std::streamsize)numBuffered);
+                numBuffered = 0;
+            }
+        }
+};
+
+
+#endif
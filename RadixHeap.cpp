@@ -0,0 +1,193 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: RadixHeap.cpp                                                               *
+ *                                                                                     *
+ *   Desc: implementation file for a monotone radix heap                               *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *   Functions:                                                                        *
+ *      reset(int)  ....................  empties the queue                            *
+ *      link(int, int)  ................  adds an item to a bucket                     *
+ *      unlink(int)  ...................  takes an item out of its bucket              *
+ *      pushOrDecrease(int, int)  ......  queues an item or changes its key            *
+ *      remove(int)  ...................  takes an item out of the queue               *
+ *      popMinimumLevel(vector<int>)  ..  removes the items with the smallest key      *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include "RadixHeap.h"
+
+/*-------------------------------------------------------------------------------------*
+ *   constants                                                                         *
+ *-------------------------------------------------------------------------------------*/
+const int NUM_RADIX_BUCKETS = 33; // bucket 0 for keys equal to the last level, then one per differing bit
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function implementations                                                          *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: reset(int)                                                         *
+ *                                                                                     *
+ *   description: empties the queue and sizes it for numItems items                    *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void RadixHeap::reset(int numItems) {
+
+    bucketHeads.assign(NUM_RADIX_BUCKETS, -1);
+    nextInBucket.assign(numItems, -1);
+    prevInBucket.assign(numItems, -1);
+    bucketOf.assign(numItems, -1);
+    keys.assign(numItems, 0);
+    numQueuedItems = 0;
+    lastKey = 0;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: link(int, int)                                                     *
+ *                                                                                     *
+ *   description: adds item to the front of bucket's list                              *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void RadixHeap::link(int item, int bucket) {
+
+    prevInBucket[item] = -1;
+    nextInBucket[item] = bucketHeads[bucket];
+    if (bucketHeads[bucket] != -1) {
+        prevInBucket[bucketHeads[bucket]] = item;
+    }
+    bucketHeads[bucket] = item;
+    bucketOf[item] = bucket;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: unlink(int)                                                        *
+ *                                                                                     *
+ *   description: takes a queued item out of its bucket's list                         *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void RadixHeap::unlink(int item) {
+
+    if (prevInBucket[item] != -1) {
+        nextInBucket[prevInBucket[item]] = nextInBucket[item];
+    }
+    else {
+        bucketHeads[bucketOf[item]] = nextInBucket[item];
+    }
+    if (nextInBucket[item] != -1) {
+        prevInBucket[nextInBucket[item]] = prevInBucket[item];
+    }
+    bucketOf[item] = -1;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: pushOrDecrease(int, int)                                           *
+ *                                                                                     *
+ *   description: queues item with key. an item already queued is moved to the        *
+ *                bucket of its new key.                                               *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void RadixHeap::pushOrDecrease(int item, int key) {
+
+    // the bucket the key belongs in
+    int bucket = bucketFor((unsigned int)key);
+
+    if (bucketOf[item] == -1) {
+        numQueuedItems++;
+    }
+    else if (bucketOf[item] != bucket) {
+        unlink(item);
+    }
+    else {
+        keys[item] = (unsigned int)key;
+        return;
+    }
+
+    keys[item] = (unsigned int)key;
+    link(item, bucket);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: remove(int)                                                        *
+ *                                                                                     *
+ *   description: takes item out of the queue. does nothing if it is not queued        *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void RadixHeap::remove(int item) {
+
+    if (bucketOf[item] != -1) {
+        unlink(item);
+        numQueuedItems--;
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: popMinimumLevel(vector<int>)                                       *
+ *                                                                                     *
+ *   description: moves the items whose key is the smallest into level. if bucket 0 is *
+ *                empty the first bucket that is not is split: its smallest key        *
+ *                becomes lastKey and its items move to lower buckets, which puts the  *
+ *                items with that key in bucket 0.                                     *
+ *                                                                                     *
+ *   precondition: the queue must not be empty                                         *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void RadixHeap::popMinimumLevel(std::vector<int>& level) {
+
+    level.clear();
+
+    if (bucketHeads[0] == -1) {
+
+        // the first bucket with items in it
+        int bucket = 1;
+        while (bucketHeads[bucket] == -1) {
+            bucket++;
+        }
+
+        // find the smallest key in the bucket
+        unsigned int smallestKey = keys[bucketHeads[bucket]];
+        for (int item = bucketHeads[bucket]; item != -1; item = nextInBucket[item]) {
+            if (keys[item] < smallestKey) {
+                smallestKey = keys[item];
+            }
+        }
+
+        // spread the bucket's items over the lower buckets
+        int item = bucketHeads[bucket];
+        bucketHeads[bucket] = -1;
+        lastKey = smallestKey;
+        while (item != -1) {
+            int nextItem = nextInBucket[item];
+            link(item, bucketFor(keys[item]));
+            item = nextItem;
+        }
+    }
+
+    for (int item = bucketHeads[0]; item != -1; item = nextInBucket[item]) {
+        level.push_back(item);
+        bucketOf[item] = -1;
+    }
+    numQueuedItems -= (int)level.size();
+    bucketHeads[0] = -1;
+}
@@ -0,0 +1,118 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: RadixHeap.h                                                                 *
+ *                                                                                     *
+ *   Desc: header file for a monotone radix heap of the items 0 to numItems - 1 with   *
+ *         non-negative int keys. an item is kept in the bucket numbered by the        *
+ *         highest bit where its key differs from the last level popped, so each item  *
+ *         only ever moves to lower buckets and operations are O(1) amortized over     *
+ *         the 33 buckets. no key may be below the last level popped.                  *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef RADIX_HEAP_H_
+#define RADIX_HEAP_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<vector>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: RadixHeap                                                                  *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        reset                                                                        *
+ *        empty                                                                        *
+ *        contains                                                                     *
+ *        pushOrDecrease                                                               *
+ *        remove                                                                       *
+ *        popMinimumLevel                                                              *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         bucketHeads                                                                 *
+ *         nextInBucket                                                                *
+ *         prevInBucket                                                                *
+ *         bucketOf                                                                    *
+ *         keys                                                                        *
+ *         numQueuedItems                                                              *
+ *         lastKey                                                                     *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         bucketFor                                                                   *
+ *         link                                                                        *
+ *         unlink                                                                      *
+ *-------------------------------------------------------------------------------------*/
+class RadixHeap {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // the first item of each bucket's list or -1. bucket 0 holds the keys equal to lastKey
+        std::vector<int> bucketHeads;
+
+        // the next and previous items in the same bucket, or -1 at the ends of the list
+        std::vector<int> nextInBucket;
+        std::vector<int> prevInBucket;
+
+        // the bucket each item is in, or -1 if it is not queued
+        std::vector<int> bucketOf;
+
+        // the key of each queued item
+        std::vector<unsigned int> keys;
+
+        // the number of items queued
+        int numQueuedItems;
+
+        // the key of the last level popped
+        unsigned int lastKey;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // returns the bucket a key belongs in relative to lastKey
+        int bucketFor(unsigned int key) const {
+            return (key == lastKey) ? 0 : 32 - __builtin_clz(key ^ lastKey);
+        }
+
+        // adds item to the front of a bucket's list
+        void link(int item, int bucket);
+
+        // takes item out of its bucket's list
+        void unlink(int item);
+
+    public:
+        // constructor
+        RadixHeap(int numItems = 0) { reset(numItems); }
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // empties the queue, sizes it for numItems items and sets the last level popped to 0
+        void reset(int numItems);
+
+        // returns true if no items are queued
+        bool empty() const { return numQueuedItems == 0; }
+
+        // returns true if item is queued
+        bool contains(int item) const { return bucketOf[item] != -1; }
+
+        // queues item with key, or moves it to key if it is queued with a different one.
+        // precondition: key must not be below the last level popped
+        void pushOrDecrease(int item, int key);
+
+        // takes item out of the queue if it is queued
+        void remove(int item);
+
+        // moves every item with the smallest key into level, in no particular order
+        // precondition: the queue must not be empty
+        void popMinimumLevel(std::vector<int>& level);
+};
+
+
+#endif
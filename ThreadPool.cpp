@@ -0,0 +1,223 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: ThreadPool.cpp                                                              *
+ *                                                                                     *
+ *   Desc: implementation file for a fixed size pool of worker threads                 *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *   Functions:                                                                        *
+ *      ThreadPool(int)  ...............  starts the workers                           *
+ *      ~ThreadPool()  .................  stops and joins the workers                  *
+ *      workerLoop(int)  ...............  runs tasks on a worker                       *
+ *      takeTask(int, function)  .......  takes or steals a task                       *
+ *      submit(function)  ..............  queues a task                                *
+ *      wait()  ........................  waits for every task to finish               *
+ *      currentWorkerIndex()  ..........  finds the worker running the caller          *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include "ThreadPool.h"
+
+/*-------------------------------------------------------------------------------------*
+ *   thread local variables                                                            *
+ *-------------------------------------------------------------------------------------*/
+thread_local const ThreadPool* runningPool = nullptr; // the pool whose worker is this thread, if any
+thread_local int runningWorkerIndex = -1;             // the index of this thread in runningPool
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function implementations                                                          *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: ThreadPool(int)                                                    *
+ *                                                                                     *
+ *   description: constructor. starts numThreadsValue worker threads, at least one,    *
+ *                each with an empty queue                                             *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+ThreadPool::ThreadPool(int numThreadsValue) : nextQueueIndex(0), numQueuedTasks(0), numUnfinishedTasks(0), stopping(false) {
+
+    if (numThreadsValue < 1) {
+        numThreadsValue = 1;
+    }
+
+    // every queue exists before any worker can look for one to steal from
+    for (int i = 0; i < numThreadsValue; i++) {
+        workerQueues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (int i = 0; i < numThreadsValue; i++) {
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: ~ThreadPool()                                                      *
+ *                                                                                     *
+ *   description: destructor. lets the queued tasks finish, then joins the workers     *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+ThreadPool::~ThreadPool() {
+
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: workerLoop(int)                                                    *
+ *                                                                                     *
+ *   description: runs tasks from its own queue or stolen from the others, and sleeps  *
+ *                while every queue is empty, until the pool is stopping               *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void ThreadPool::workerLoop(int workerIndex) {
+
+    // the task being run
+    std::function<void()> task;
+
+    runningPool = this;
+    runningWorkerIndex = workerIndex;
+
+    while (true) {
+
+        if (takeTask(workerIndex, task)) {
+
+            // run the task without holding any lock
+            task();
+            task = nullptr;
+
+            // report that the task is done
+            std::lock_guard<std::mutex> lock(poolMutex);
+            numUnfinishedTasks--;
+            if (numUnfinishedTasks == 0) {
+                allTasksDone.notify_all();
+            }
+            continue;
+        }
+
+        // wait for a task or for the pool to stop
+        std::unique_lock<std::mutex> lock(poolMutex);
+        taskAvailable.wait(lock, [this] { return stopping || numQueuedTasks > 0; });
+        if (stopping && numQueuedTasks == 0) {
+            return;
+        }
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: takeTask(int, function)                                            *
+ *                                                                                     *
+ *   description: pops the newest task of worker workerIndex's own queue, whose data   *
+ *                is the likeliest to still be in its cache. failing that it steals    *
+ *                the oldest task of the next queue that has one, which takes the work *
+ *                its owner would get to last                                          *
+ *                                                                                     *
+ *   returns: true if a task was taken and stored in task                              *
+ *-------------------------------------------------------------------------------------*/
+bool ThreadPool::takeTask(int workerIndex, std::function<void()>& task) {
+
+    // the number of queues
+    int numQueues = (int)workerQueues.size();
+
+    for (int offset = 0; offset < numQueues; offset++) {
+        WorkerQueue& queue = *workerQueues[(workerIndex + offset) % numQueues];
+        std::lock_guard<std::mutex> lock(queue.queueMutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+
+        if (offset == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        numQueuedTasks--;
+        return true;
+    }
+
+    return false;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: submit(function)                                                   *
+ *                                                                                     *
+ *   description: queues a task on the submitting worker's own queue or, from outside  *
+ *                the pool, on the next queue in turn, then wakes a sleeping worker    *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void ThreadPool::submit(std::function<void()> task) {
+
+    // the queue the task goes on
+    int queueIndex = currentWorkerIndex();
+    if (queueIndex == -1) {
+        queueIndex = (int)(nextQueueIndex++ % workerQueues.size());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(workerQueues[queueIndex]->queueMutex);
+        workerQueues[queueIndex]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        numQueuedTasks++;
+        numUnfinishedTasks++;
+    }
+    taskAvailable.notify_one();
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: wait()                                                             *
+ *                                                                                     *
+ *   description: blocks until every submitted task has finished running               *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void ThreadPool::wait() {
+
+    std::unique_lock<std::mutex> lock(poolMutex);
+    allTasksDone.wait(lock, [this] { return numUnfinishedTasks == 0; });
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: currentWorkerIndex()                                               *
+ *                                                                                     *
+ *   description: each worker records its pool and index in thread local variables    *
+ *                when it starts                                                       *
+ *                                                                                     *
+ *   returns: the index of the calling worker, or -1 if the caller is not a worker of  *
+ *            this pool                                                                *
+ *-------------------------------------------------------------------------------------*/
+int ThreadPool::currentWorkerIndex() const {
+
+    return (runningPool == this) ? runningWorkerIndex : -1;
+}
@@ -0,0 +1,155 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: ThreadPool.h                                                                *
+ *                                                                                     *
+ *   Desc: header file for a fixed size pool of worker threads that run submitted      *
+ *         tasks. used by the Graph class to spread loading and algorithms over        *
+ *         several cores. each worker has its own deque of tasks: it takes work from   *
+ *         the back of its own and, once that is empty, steals from the front of the   *
+ *         others', so uneven tasks still keep every worker busy without one shared    *
+ *         queue for them all to fight over.                                           *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<vector>
+#include<deque>
+#include<memory>
+#include<atomic>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<functional>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: ThreadPool                                                                 *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        submit                                                                       *
+ *        wait                                                                         *
+ *        numThreads                                                                   *
+ *        currentWorkerIndex                                                           *
+ *        defaultNumThreads                                                            *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private structs:                                                               *
+ *         WorkerQueue                                                                 *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         workers                                                                     *
+ *         workerQueues                                                                *
+ *         nextQueueIndex                                                              *
+ *         numQueuedTasks                                                              *
+ *         poolMutex                                                                   *
+ *         taskAvailable                                                               *
+ *         allTasksDone                                                                *
+ *         numUnfinishedTasks                                                          *
+ *         stopping                                                                    *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         workerLoop                                                                  *
+ *         takeTask                                                                    *
+ *-------------------------------------------------------------------------------------*/
+class ThreadPool {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private structs                                                                   *
+         *-------------------------------------------------------------------------------------*/
+        /* the tasks waiting for one worker. its owner works at the back, thieves at the front */
+        struct WorkerQueue {
+            public:
+                /* data members */
+                // the tasks, the newest at the back
+                std::deque< std::function<void()> > tasks;
+
+                // guards tasks
+                std::mutex queueMutex;
+        };
+
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // the worker threads
+        std::vector<std::thread> workers;
+
+        // the task queue of each worker
+        std::vector< std::unique_ptr<WorkerQueue> > workerQueues;
+
+        // the queue the next task submitted from outside the pool goes to, so they are dealt round robin
+        std::atomic<unsigned int> nextQueueIndex;
+
+        // the number of tasks sitting in the queues. only raised while holding poolMutex so a worker
+        // going to sleep cannot miss one
+        std::atomic<int> numQueuedTasks;
+
+        // guards numUnfinishedTasks and stopping, and the sleeping of idle workers
+        std::mutex poolMutex;
+
+        // signalled when a task is submitted or the pool is stopping
+        std::condition_variable taskAvailable;
+
+        // signalled when numUnfinishedTasks drops to zero
+        std::condition_variable allTasksDone;
+
+        // the number of tasks submitted that have not finished running
+        int numUnfinishedTasks;
+
+        // set by the destructor to make the workers exit
+        bool stopping;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // runs tasks on worker workerIndex until the pool is stopping
+        void workerLoop(int workerIndex);
+
+        // takes a task from the back of worker workerIndex's queue, or steals one from the front of
+        // another's. returns false if every queue is empty
+        bool takeTask(int workerIndex, std::function<void()>& task);
+
+    public:
+        // constructor. starts numThreadsValue workers (at least one)
+        ThreadPool(int numThreadsValue = defaultNumThreads());
+
+        // destructor. waits for the running tasks, then joins the workers
+        ~ThreadPool();
+
+        // a pool owns its threads
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // queues a task to be run by one of the workers. a task submitted by a worker of this pool goes on
+        // that worker's own queue, where it runs next unless another worker steals it first
+        void submit(std::function<void()> task);
+
+        // blocks until every submitted task has finished
+        void wait();
+
+        // returns the number of worker threads
+        int numThreads() const { return (int)workers.size(); }
+
+        // returns the index, 0 to numThreads() - 1, of the worker of this pool running the calling task,
+        // or -1 if the caller is not one. lets tasks keep scratch space per worker instead of per task
+        int currentWorkerIndex() const;
+
+        // returns the number of hardware threads, or 1 if it is unknown
+        static int defaultNumThreads() {
+            unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            return (hardwareThreads == 0) ? 1 : (int)hardwareThreads;
+        }
+};
+
+
+#endif
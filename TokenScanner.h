@@ -0,0 +1,137 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: TokenScanner.h                                                              *
+ *                                                                                     *
+ *   Desc: header file for a scanner that splits a range of characters into           *
+ *         whitespace separated tokens and integers. tokens are returned as views      *
+ *         into the range, so nothing is copied and no stream or locale is involved.   *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef TOKEN_SCANNER_H_
+#define TOKEN_SCANNER_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<string_view>
+#include<climits>
+
+/*-------------------------------------------------------------------------------------*
+ *   class: TokenScanner                                                               *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        nextToken                                                                    *
+ *        nextInt                                                                      *
+ *        position                                                                     *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         curPosition                                                                 *
+ *         endPosition                                                                 *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         isWhitespace                                                                *
+ *         skipWhitespace                                                              *
+ *-------------------------------------------------------------------------------------*/
+class TokenScanner {
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // the next character to be scanned
+        const char* curPosition;
+
+        // one past the last character that may be scanned
+        const char* endPosition;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // returns true for the characters that separate tokens
+        static bool isWhitespace(char curChar) {
+            return curChar == ' ' || curChar == '\n' || curChar == '\r' || curChar == '\t' || curChar == '\v' || curChar == '\f';
+        }
+
+        // moves curPosition to the start of the next token
+        void skipWhitespace() {
+            while (curPosition != endPosition && isWhitespace(*curPosition)) {
+                curPosition++;
+            }
+        }
+
+    public:
+        // constructor
+        TokenScanner(const char* beginValue, const char* endValue)
+            : curPosition(beginValue), endPosition(endValue) {}
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // sets token to the next token. returns false if there are no tokens left
+        bool nextToken(std::string_view& token) {
+
+            // the first character of the token
+            const char* tokenStart;
+
+            skipWhitespace();
+            tokenStart = curPosition;
+            while (curPosition != endPosition && !isWhitespace(*curPosition)) {
+                curPosition++;
+            }
+
+            token = std::string_view(tokenStart, curPosition - tokenStart);
+            return curPosition != tokenStart;
+        }
+
+        // sets value to the next token read as a decimal int. returns false if the next token
+        // is missing, is not a whole number or does not fit in an int
+        bool nextInt(int& value) {
+
+            // the value read so far, kept wider than int to catch overflow
+            long long total = 0;
+
+            // true if the number has a minus sign
+            bool negative = false;
+
+            // the first digit of the number
+            const char* digitsStart;
+
+            skipWhitespace();
+            if (curPosition != endPosition && (*curPosition == '-' || *curPosition == '+')) {
+                negative = (*curPosition == '-');
+                curPosition++;
+            }
+
+            digitsStart = curPosition;
+            while (curPosition != endPosition && *curPosition >= '0' && *curPosition <= '9') {
+                total = total * 10 + (*curPosition - '0');
+                if (total > (long long)INT_MAX + 1) {
+                    return false;
+                }
+                curPosition++;
+            }
+
+            // there must be at least one digit and the token must end after the digits
+            if (curPosition == digitsStart || (curPosition != endPosition && !isWhitespace(*curPosition))) {
+                return false;
+            }
+
+            total = negative ? -total : total;
+            if (total > INT_MAX) {
+                return false;
+            }
+            value = (int)total;
+            return true;
+        }
+
+        // returns the next character to be scanned
+        const char* position() const { return curPosition; }
+};
+
+
+#endif
@@ -0,0 +1,214 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: VertexNameTable.cpp                                                         *
+ *                                                                                     *
+ *   Desc: implementation file for the vertex name dictionary used by the Graph class  *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *   Functions:                                                                        *
+ *      hashName(string_view)  .........  hashes a name without allocating             *
+ *      rebuildSlots(int)  .............  resizes and refills the hash table           *
+ *      clear()  .......................  removes every name                           *
+ *      reserve(int)  ..................  makes room for a number of names             *
+ *      insert(string_view)  ...........  adds a name                                  *
+ *      find(string_view)  .............  looks up the index of a name                 *
+ *      borrow(...)  ...................  uses saved arrays without copying them       *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include "VertexNameTable.h"
+
+/*-------------------------------------------------------------------------------------*
+ *   constants                                                                         *
+ *-------------------------------------------------------------------------------------*/
+const unsigned int FNV_OFFSET_BASIS = 2166136261u; // starting value of the FNV-1a hash
+const unsigned int FNV_PRIME = 16777619u; // multiplier of the FNV-1a hash
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function implementations                                                          *
+ *-------------------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: hashName(string_view)                                              *
+ *                                                                                     *
+ *   description: computes the FNV-1a hash of a name straight from its characters      *
+ *                                                                                     *
+ *   returns: the hash of the name                                                     *
+ *-------------------------------------------------------------------------------------*/
+unsigned int VertexNameTable::hashName(std::string_view nameToHash) {
+
+    unsigned int hash = FNV_OFFSET_BASIS;
+
+    for (char curChar : nameToHash) {
+        hash = (hash ^ (unsigned char)curChar) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: rebuildSlots(int)                                                  *
+ *                                                                                     *
+ *   description: resizes the hash table so that numNames names keep it at most half  *
+ *                full, then reinserts every name already in the table                 *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void VertexNameTable::rebuildSlots(int numNames) {
+
+    // the new number of slots
+    unsigned int numSlots = 16;
+
+    while (numSlots < 2u * (unsigned int)numNames) {
+        numSlots *= 2;
+    }
+
+    slots.assign(numSlots, Slot());
+    slotMask = numSlots - 1;
+
+    // reinsert the names with linear probing
+    for (int curIndex = 0; curIndex < size(); curIndex++) {
+        unsigned int hash = hashName(name(curIndex));
+        unsigned int position = hash & slotMask;
+        while (slots[position].vertexIndex != -1) {
+            position = (position + 1) & slotMask;
+        }
+        slots[position] = Slot(hash, curIndex, nameOffsets[curIndex], nameOffsets[curIndex + 1] - nameOffsets[curIndex]);
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: clear()                                                            *
+ *                                                                                     *
+ *   description: removes every name from the table                                    *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void VertexNameTable::clear() {
+
+    nameBlob.clear();
+    nameOffsets.assign(1, 0);
+    rebuildSlots(0);
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: borrow(const char*, size_t, const int*, int, const Slot*, size_t)  *
+ *                                                                                     *
+ *   description: replaces the table with arrays saved from another table, such as     *
+ *                the ones in a mapped snapshot, without copying them                  *
+ *                                                                                     *
+ *   precondition: numSlotsValue must be a power of two and the arrays must have been  *
+ *                 produced by nameBlobData, nameOffsetsData and slotsData             *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void VertexNameTable::borrow(const char* nameBlobValue, std::size_t nameBlobSizeValue, const int* nameOffsetsValue, int numNames,
+    const Slot* slotsValue, std::size_t numSlotsValue) {
+
+    nameBlob.borrow(nameBlobValue, nameBlobSizeValue);
+    nameOffsets.borrow(nameOffsetsValue, numNames + 1);
+    slots.borrow(slotsValue, numSlotsValue);
+    slotMask = (unsigned int)numSlotsValue - 1;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: reserve(int)                                                       *
+ *                                                                                     *
+ *   description: makes room for numNames names so that inserting them does not       *
+ *                rehash. called with the vertex count before the names are read.      *
+ *                                                                                     *
+ *   returns: n/a                                                                      *
+ *-------------------------------------------------------------------------------------*/
+void VertexNameTable::reserve(int numNames) {
+
+    nameOffsets.reserve(numNames + 1);
+
+    if (2u * (unsigned int)numNames > slots.size()) {
+        rebuildSlots(numNames);
+    }
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: insert(string_view)                                                *
+ *                                                                                     *
+ *   description: adds a name to the end of the table                                  *
+ *                                                                                     *
+ *   returns: the index given to the name, or -1 if the name is already in the table  *
+ *-------------------------------------------------------------------------------------*/
+int VertexNameTable::insert(std::string_view nameToInsert) {
+
+    // the hash of the new name
+    unsigned int hash = hashName(nameToInsert);
+
+    // the slot being probed
+    unsigned int position = hash & slotMask;
+
+    // the index the new name will get
+    int newIndex = size();
+
+    // the slots are about to change, so they must not be borrowed
+    slots.makeOwned();
+
+    // probe until an empty slot is found, rejecting duplicates on the way
+    while (slots[position].vertexIndex != -1) {
+        if (slots[position].holds(hash, nameToInsert, nameBlob.data())) {
+            return -1;
+        }
+        position = (position + 1) & slotMask;
+    }
+
+    // store the name and claim the slot
+    slots[position] = Slot(hash, newIndex, (int)nameBlob.size(), (int)nameToInsert.size());
+    nameBlob.append(nameToInsert.data(), nameToInsert.size());
+    nameOffsets.push_back((int)nameBlob.size());
+
+    // keep the table at most half full
+    if (2u * (unsigned int)size() > slots.size()) {
+        rebuildSlots(size());
+    }
+
+    return newIndex;
+}
+
+
+
+/*-------------------------------------------------------------------------------------*
+ *   function name: find(string_view)                                                  *
+ *                                                                                     *
+ *   description: looks up the index of a name                                         *
+ *                                                                                     *
+ *   returns: the index of the name, or -1 if the name is not in the table             *
+ *-------------------------------------------------------------------------------------*/
+int VertexNameTable::find(std::string_view nameToFind) const {
+
+    // the hash of the name being looked up
+    unsigned int hash = hashName(nameToFind);
+
+    // the slot being probed
+    unsigned int position = hash & slotMask;
+
+    // probe until the name or an empty slot is found
+    while (slots[position].vertexIndex != -1) {
+        if (slots[position].holds(hash, nameToFind, nameBlob.data())) {
+            return slots[position].vertexIndex;
+        }
+        position = (position + 1) & slotMask;
+    }
+
+    return -1;
+}
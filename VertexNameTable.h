@@ -0,0 +1,157 @@
+/*-------------------------------------------------------------------------------------*
+ *                                                                                     *
+ *   File: VertexNameTable.h                                                           *
+ *                                                                                     *
+ *   Desc: header file for the vertex name dictionary used by the Graph class. names   *
+ *         are stored back to back in one character blob and indexed by an            *
+ *         open-addressed hash table, so lookups hash the caller's characters          *
+ *         directly and never allocate.                                                *
+ *                                                                                     *
+ *   Author: Alex Lerch                                                                *
+ *                                                                                     *
+ *-------------------------------------------------------------------------------------*/
+#ifndef VERTEX_NAME_TABLE_H_
+#define VERTEX_NAME_TABLE_H_
+
+/*-------------------------------------------------------------------------------------*
+ *   header files                                                                      *
+ *-------------------------------------------------------------------------------------*/
+#include<vector>
+#include<string>
+#include<string_view>
+#include<cstddef>
+#include "GraphArray.h"
+
+/*-------------------------------------------------------------------------------------*
+ *   class: VertexNameTable                                                            *
+ *                                                                                     *
+ *   public:                                                                           *
+ *                                                                                     *
+ *      public structs:                                                                *
+ *         Slot                                                                        *
+ *                                                                                     *
+ *      public functions:                                                              *
+ *        clear                                                                        *
+ *        reserve                                                                      *
+ *        insert                                                                       *
+ *        find                                                                         *
+ *        name                                                                         *
+ *        size                                                                         *
+ *        borrow                                                                       *
+ *        nameBlobData                                                                 *
+ *        nameBlobSize                                                                 *
+ *        nameOffsetsData                                                              *
+ *        slotsData                                                                    *
+ *        numSlots                                                                     *
+ *                                                                                     *
+ *   private:                                                                          *
+ *                                                                                     *
+ *      private data members:                                                          *
+ *         nameBlob                                                                    *
+ *         nameOffsets                                                                 *
+ *         slots                                                                       *
+ *         slotMask                                                                    *
+ *                                                                                     *
+ *      private member functions:                                                      *
+ *         hashName                                                                    *
+ *         rebuildSlots                                                                *
+ *-------------------------------------------------------------------------------------*/
+class VertexNameTable {
+    public:
+        /*-------------------------------------------------------------------------------------*
+         *   public structs                                                                    *
+         *-------------------------------------------------------------------------------------*/
+        /* one entry of the open-addressed hash table. public so that snapshots can store the table as is */
+        struct Slot {
+            public:
+                /* data members */
+                // the full hash of the name, checked before the names are compared
+                unsigned int hash;
+
+                // the index of the vertex stored in this slot or -1 if the slot is empty
+                int vertexIndex;
+
+                // where the name starts in nameBlob. kept here so a probe only touches the slot and the blob
+                int nameStart;
+
+                // the number of characters in the name
+                int nameLength;
+
+                /* constructor */
+                Slot(unsigned int hashValue = 0, int vertexIndexValue = -1, int nameStartValue = 0, int nameLengthValue = 0)
+                    : hash(hashValue), vertexIndex(vertexIndexValue), nameStart(nameStartValue), nameLength(nameLengthValue) {}
+
+                // returns true if this slot holds nameToMatch
+                bool holds(unsigned int hashToMatch, std::string_view nameToMatch, const char* blob) const {
+                    return hash == hashToMatch && nameLength == (int)nameToMatch.size()
+                        && std::string_view(blob + nameStart, nameLength) == nameToMatch;
+                }
+        };
+
+    private:
+        /*-------------------------------------------------------------------------------------*
+         *   private data members                                                              *
+         *-------------------------------------------------------------------------------------*/
+        // the characters of every name, back to back in index order
+        GraphArray<char> nameBlob;
+
+        // where each name starts in nameBlob. has size() + 1 entries
+        GraphArray<int> nameOffsets;
+
+        // the hash table. its size is always a power of two
+        GraphArray<Slot> slots;
+
+        // slots.size() - 1, used to wrap a hash into the table
+        unsigned int slotMask;
+
+        /*-------------------------------------------------------------------------------------*
+         *   private member functions                                                          *
+         *-------------------------------------------------------------------------------------*/
+        // returns the FNV-1a hash of a name
+        static unsigned int hashName(std::string_view nameToHash);
+
+        // resizes the hash table to hold at least numNames names and reinserts every name
+        void rebuildSlots(int numNames);
+
+    public:
+        // constructor
+        VertexNameTable() { clear(); }
+
+        /*-------------------------------------------------------------------------------------*
+         *   public member functions                                                           *
+         *-------------------------------------------------------------------------------------*/
+        // removes every name from the table
+        void clear();
+
+        // makes room for numNames names without rehashing
+        void reserve(int numNames);
+
+        // adds a name and returns its index, or -1 if the name is already in the table
+        int insert(std::string_view nameToInsert);
+
+        // returns the index of a name, or -1 if the name is not in the table
+        int find(std::string_view nameToFind) const;
+
+        // returns the name stored at an index
+        std::string_view name(int vertexIndex) const {
+            return std::string_view(nameBlob.data() + nameOffsets[vertexIndex], nameOffsets[vertexIndex + 1] - nameOffsets[vertexIndex]);
+        }
+
+        // returns the number of names in the table
+        int size() const { return (int)nameOffsets.size() - 1; }
+
+        // uses arrays saved from another table without copying them. the memory must outlive the table
+        // or the next insert, which copies the arrays before changing them
+        void borrow(const char* nameBlobValue, std::size_t nameBlobSizeValue, const int* nameOffsetsValue, int numNames,
+            const Slot* slotsValue, std::size_t numSlotsValue);
+
+        // the arrays behind the table, used to save snapshots
+        const char* nameBlobData() const { return nameBlob.data(); }
+        std::size_t nameBlobSize() const { return nameBlob.size(); }
+        const int* nameOffsetsData() const { return nameOffsets.data(); }
+        const Slot* slotsData() const { return slots.data(); }
+        std::size_t numSlots() const { return slots.size(); }
+};
+
+
+#endif
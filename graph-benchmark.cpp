@@ -0,0 +1,422 @@
+/* benchmark driver for the graph class */
+
+#include<iostream>
+#include<fstream>
+#include<string>
+#include<chrono>
+#include<random>
+#include<algorithm>
+#include<cstdlib>
+#include<sys/resource.h>
+#include<sys/stat.h>
+#ifdef __GLIBC__
+#include<malloc.h>
+#endif
+#include "Graph.h"
+
+/*
+    usage: graph-benchmark [numVertices] [numEdges] [fileName]
+
+    writes a random graph with the requested size to fileName (in the readGraph text format),
+    then times loading it, saving and mapping a snapshot of it (fileName.snap), and running each
+    of the graph algorithms on the mapped snapshot. computeShortestPaths is run once per engine,
+    with the memory it needs on top of the graph and with the tree cache off, then once more from
+    the cache, and computeShortestPathsBatch and the Boruvka spanning tree are run on one thread
+    and on every core to show how they scale. a separate small dense graph (fileName.dense)
+    compares computeAllPairsDistances, with and without the AVX2 kernel, against a batch of
+    shortest path trees from every vertex. a stream of edge insertions into a DAG compares
+    addEdgeKeepingOrder against sorting the whole graph again, and Kruskal's and Prim's spanning
+    tree engines are timed on graphs (fileName.crossover) of one size and growing density to show
+    where Prim's algorithm starts to win. a graph with every edge listed both ways
+    (fileName.symmetric) is loaded as given and with DETECT_DIRECTION, which folds each pair into
+    one stored edge, comparing the edges stored, the load and the spanning tree. a stream of edge
+    insertions, removals and cost changes is applied to the graph with a minimum spanning tree
+    kept up to date by buildDynamicSpanningTree, against computing the tree again after an edit.
+    algorithm output is sent to /dev/null so only the computation and formatting are measured.
+*/
+
+// writes a random graph with numVertices vertices and numEdges edges to fileName. bothWays also
+// lists each edge from its other end with the same cost, doubling the edges written, and keeps
+// loops out so each listed edge has its mirror
+void writeRandomGraph(std::string fileName, int numVertices, int numEdges, bool bothWays = false) {
+
+    std::mt19937 generator(279);
+    std::uniform_int_distribution<int> vertexDistribution(0, numVertices - 1);
+    std::uniform_int_distribution<int> costDistribution(1, 5000);
+    std::ofstream outfile(fileName);
+
+    outfile << numVertices << "\n";
+    for (int i = 0; i < numVertices; i++) {
+        outfile << "v" << i << "\n";
+    }
+
+    // chain the vertices together first so the graph is connected
+    outfile << (bothWays ? 2 * numEdges : numEdges) << "\n";
+    for (int i = 0; i < numEdges; i++) {
+        int fromIndex = (i < numVertices - 1) ? i : vertexDistribution(generator);
+        int toIndex = (i < numVertices - 1) ? i + 1 : vertexDistribution(generator);
+        if (bothWays && toIndex == fromIndex) {
+            toIndex = (fromIndex + 1) % numVertices;
+        }
+        int cost = costDistribution(generator);
+        outfile << "v" << fromIndex << " v" << toIndex << " " << cost << "\n";
+        if (bothWays) {
+            outfile << "v" << toIndex << " v" << fromIndex << " " << cost << "\n";
+        }
+    }
+}
+
+// returns the peak resident set size of the process in megabytes
+double peakMemoryMegabytes() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+// returns the value in kilobytes of a field of /proc/self/status, or 0 where that file does not exist
+double processStatusKilobytes(const std::string& fieldName) {
+    std::ifstream statusFile("/proc/self/status");
+    std::string line;
+    while (std::getline(statusFile, line)) {
+        if (line.compare(0, fieldName.size() + 1, fieldName + ":") == 0) {
+            return std::atof(line.c_str() + fieldName.size() + 1);
+        }
+    }
+    return 0;
+}
+
+// returns freed memory to the system and resets the peak resident set size to the current one,
+// so that the next phase can be measured on its own. only has an effect on linux
+void resetPeakMemory() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+// returns the size of fileName in megabytes
+double fileSizeMegabytes(std::string fileName) {
+    struct stat fileStatus;
+    stat(fileName.c_str(), &fileStatus);
+    return fileStatus.st_size / (1024.0 * 1024.0);
+}
+
+// returns the number of milliseconds since start
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+
+    int numVertices = (argc > 1) ? std::atoi(argv[1]) : 200000;
+    int numEdges = (argc > 2) ? std::atoi(argv[2]) : 2000000;
+    std::string fileName = (argc > 3) ? argv[3] : "benchmark-graph.txt";
+    std::chrono::steady_clock::time_point start;
+    Graph graph;
+
+    writeRandomGraph(fileName, numVertices, numEdges);
+    std::cout << "graph: " << numVertices << " vertices, " << numEdges << " edges" << std::endl;
+    double baselineMemory = peakMemoryMegabytes();
+
+    // send algorithm output to /dev/null while timing
+    std::streambuf* consoleBuffer = std::cout.rdbuf();
+    std::ofstream nullStream("/dev/null");
+
+    start = std::chrono::steady_clock::now();
+    graph.readGraph(fileName);
+    double loadTime = millisecondsSince(start);
+    std::cout << "readGraph: " << loadTime << " ms (" << fileSizeMegabytes(fileName) / (loadTime / 1000.0)
+        << " MB/s), peak memory +" << (peakMemoryMegabytes() - baselineMemory) << " MB" << std::endl;
+
+    // save a snapshot of the graph and time mapping it back in
+    std::string snapshotFileName = fileName + ".snap";
+    start = std::chrono::steady_clock::now();
+    graph.saveSnapshot(snapshotFileName);
+    std::cout << "saveSnapshot: " << millisecondsSince(start) << " ms" << std::endl;
+    start = std::chrono::steady_clock::now();
+    graph.loadSnapshot(snapshotFileName);
+    std::cout << "loadSnapshot: " << millisecondsSince(start) << " ms" << std::endl;
+
+    // time each shortest path engine along with the memory it needs beyond the loaded graph
+    const int numEngines = 5;
+    const Graph::ShortestPathEngine engines[numEngines] = { Graph::DIAL_BUCKETS, Graph::RADIX_HEAP, Graph::INDEXED_HEAP, Graph::LAZY_BINARY_HEAP,
+        Graph::DELTA_STEPPING };
+    const char* engineNames[numEngines] = { "Dial buckets", "radix heap", "indexed 4-ary heap", "lazy binary heap", "delta-stepping" };
+    double shortestPathsTimes[numEngines];
+    double shortestPathsMemory[numEngines];
+    std::cout.rdbuf(nullStream.rdbuf());
+    graph.setShortestPathCacheCapacity(0);
+    graph.computeShortestPaths("v0"); // faults in the mapped snapshot so neither engine is charged for it
+    for (int engine = 0; engine < numEngines; engine++) {
+        graph.setShortestPathEngine(engines[engine]);
+        resetPeakMemory();
+        double memoryBefore = processStatusKilobytes("VmRSS");
+        start = std::chrono::steady_clock::now();
+        graph.computeShortestPaths("v0");
+        shortestPathsTimes[engine] = millisecondsSince(start);
+        shortestPathsMemory[engine] = (processStatusKilobytes("VmHWM") - memoryBefore) / 1024.0;
+    }
+    graph.setShortestPathEngine(Graph::AUTOMATIC);
+
+    // time the same source again once its tree is cached, which leaves only the printing
+    graph.setShortestPathCacheCapacity(Graph::DEFAULT_SHORTEST_PATH_CACHE_CAPACITY);
+    graph.computeShortestPaths("v0");
+    start = std::chrono::steady_clock::now();
+    graph.computeShortestPaths("v0");
+    double cachedShortestPathsTime = millisecondsSince(start);
+
+    // time a batch of shortest path trees on one thread and on every core
+    const int numBatchSources = 64;
+    std::vector<std::string> batchSources;
+    for (int i = 0; i < numBatchSources; i++) {
+        batchSources.push_back("v" + std::to_string((int)((long long)i * numVertices / numBatchSources)));
+    }
+    int batchThreads = ThreadPool::defaultNumThreads();
+    start = std::chrono::steady_clock::now();
+    graph.computeShortestPathsBatch(batchSources, 1);
+    double serialBatchTime = millisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    graph.computeShortestPathsBatch(batchSources, batchThreads);
+    double parallelBatchTime = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    graph.computeTopologicalSort();
+    double topologicalSortTime = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    graph.printGraph();
+    double printGraphTime = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    graph.computeMinimumSpanningTree();
+    double spanningTreeTime = millisecondsSince(start);
+
+    // time the spanning tree again without printing it
+    start = std::chrono::steady_clock::now();
+    graph.minimumSpanningTree();
+    double spanningTreeComputeTime = millisecondsSince(start);
+
+    // time the Boruvka engine on one thread and on every core
+    graph.setSpanningTreeEngine(Graph::BORUVKA);
+    graph.setNumSearchThreads(1);
+    start = std::chrono::steady_clock::now();
+    graph.minimumSpanningTree();
+    double serialBoruvkaTime = millisecondsSince(start);
+    graph.setNumSearchThreads(batchThreads);
+    start = std::chrono::steady_clock::now();
+    graph.minimumSpanningTree();
+    double parallelBoruvkaTime = millisecondsSince(start);
+    graph.setSpanningTreeEngine(Graph::AUTOMATIC_SPANNING_TREE);
+
+    // time Kruskal's and Prim's algorithms on graphs of one size and growing density to show where they cross
+    const int numCrossoverVertices = 20000;
+    const int numCrossoverDensities = 6;
+    const int crossoverDegrees[numCrossoverDensities] = { 4, 8, 16, 32, 64, 128 };
+    double kruskalTimes[numCrossoverDensities];
+    double primTimes[numCrossoverDensities];
+    std::string crossoverFileName = fileName + ".crossover";
+    for (int density = 0; density < numCrossoverDensities; density++) {
+        writeRandomGraph(crossoverFileName, numCrossoverVertices, numCrossoverVertices * crossoverDegrees[density]);
+        Graph crossoverGraph;
+        crossoverGraph.readGraph(crossoverFileName);
+        crossoverGraph.setSpanningTreeEngine(Graph::KRUSKAL);
+        start = std::chrono::steady_clock::now();
+        crossoverGraph.minimumSpanningTree();
+        kruskalTimes[density] = millisecondsSince(start);
+        crossoverGraph.setSpanningTreeEngine(Graph::PRIM);
+        start = std::chrono::steady_clock::now();
+        crossoverGraph.minimumSpanningTree();
+        primTimes[density] = millisecondsSince(start);
+    }
+
+    // load a graph listing every edge both ways as given and folded into undirected edges
+    const int numSymmetricLoads = 2;
+    const Graph::EdgeDirection symmetricDirections[numSymmetricLoads] = { Graph::DIRECTED, Graph::DETECT_DIRECTION };
+    const char* symmetricDirectionNames[numSymmetricLoads] = { "directed", "detected undirected" };
+    int symmetricEdgesStored[numSymmetricLoads];
+    double symmetricLoadTimes[numSymmetricLoads];
+    double symmetricLoadMemory[numSymmetricLoads];
+    double symmetricSpanningTreeTimes[numSymmetricLoads];
+    std::string symmetricFileName = fileName + ".symmetric";
+    writeRandomGraph(symmetricFileName, numVertices, numEdges / 2, true);
+    for (int load = 0; load < numSymmetricLoads; load++) {
+        Graph symmetricGraph;
+        symmetricGraph.setLoadDirection(symmetricDirections[load]);
+        resetPeakMemory();
+        double memoryBefore = processStatusKilobytes("VmRSS");
+        start = std::chrono::steady_clock::now();
+        symmetricGraph.readGraph(symmetricFileName);
+        symmetricLoadTimes[load] = millisecondsSince(start);
+        resetPeakMemory();
+        symmetricLoadMemory[load] = (processStatusKilobytes("VmRSS") - memoryBefore) / 1024.0;
+        symmetricEdgesStored[load] = symmetricGraph.getNumEdges();
+        start = std::chrono::steady_clock::now();
+        symmetricGraph.minimumSpanningTree();
+        symmetricSpanningTreeTimes[load] = millisecondsSince(start);
+    }
+
+    // apply a stream of edits to a graph keeping its minimum spanning tree up to date: cost changes of the
+    // chain edges writeRandomGraph starts with, new random edges, and removals of the edges added
+    const int numTreeUpdates = 30000;
+    std::vector<int> updateKinds, updateCosts;
+    std::vector<std::string> updateFromNames, updateToNames;
+    std::vector<int> addedUpdates;
+    std::mt19937 updateGenerator(279);
+    std::uniform_int_distribution<int> updateVertexDistribution(0, numVertices - 2);
+    std::uniform_int_distribution<int> updateCostDistribution(1, 5000);
+    for (int i = 0; i < numTreeUpdates; i++) {
+        int kind = (i % 3 == 2 && addedUpdates.empty()) ? 1 : i % 3;
+        updateKinds.push_back(kind);
+        updateCosts.push_back(updateCostDistribution(updateGenerator));
+        if (kind == 0) {
+            int fromIndex = updateVertexDistribution(updateGenerator);
+            updateFromNames.push_back("v" + std::to_string(fromIndex));
+            updateToNames.push_back("v" + std::to_string(fromIndex + 1));
+        }
+        else if (kind == 1) {
+            addedUpdates.push_back(i);
+            updateFromNames.push_back("v" + std::to_string(updateVertexDistribution(updateGenerator)));
+            updateToNames.push_back("v" + std::to_string(updateVertexDistribution(updateGenerator)));
+        }
+        else {
+            int added = addedUpdates[updateGenerator() % addedUpdates.size()];
+            updateFromNames.push_back(updateFromNames[added]);
+            updateToNames.push_back(updateToNames[added]);
+        }
+    }
+    auto applyTreeUpdate = [&](Graph& updatedGraph, int i) {
+        if (updateKinds[i] == 0) {
+            updatedGraph.updateEdgeCost(updateFromNames[i], updateToNames[i], updateCosts[i]);
+        }
+        else if (updateKinds[i] == 1) {
+            updatedGraph.addEdge(updateFromNames[i], updateToNames[i], updateCosts[i]);
+        }
+        else {
+            updatedGraph.removeEdge(updateFromNames[i], updateToNames[i]);
+        }
+    };
+    Graph dynamicTreeGraph;
+    dynamicTreeGraph.readGraph(fileName);
+    start = std::chrono::steady_clock::now();
+    dynamicTreeGraph.buildDynamicSpanningTree();
+    double dynamicTreeBuildTime = millisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numTreeUpdates; i++) {
+        applyTreeUpdate(dynamicTreeGraph, i);
+    }
+    double dynamicTreeUpdateTime = millisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    Graph::MinimumSpanningTree dynamicTree = dynamicTreeGraph.minimumSpanningTree();
+    double dynamicTreeCopyTime = millisecondsSince(start);
+    Graph recomputedTreeGraph;
+    recomputedTreeGraph.readGraph(fileName);
+    for (int i = 0; i < numTreeUpdates; i++) {
+        applyTreeUpdate(recomputedTreeGraph, i);
+    }
+    start = std::chrono::steady_clock::now();
+    Graph::MinimumSpanningTree recomputedTree = recomputedTreeGraph.minimumSpanningTree();
+    double recomputedTreeTime = millisecondsSince(start);
+    bool dynamicTreeMatches = (dynamicTree.totalCost == recomputedTree.totalCost && dynamicTree.edgeIndices == recomputedTree.edgeIndices);
+
+    // compare the all pairs distances of a small dense graph against a shortest path tree from every vertex
+    const int numDenseVertices = 1000;
+    const int numDenseEdges = 50000;
+    std::string denseFileName = fileName + ".dense";
+    writeRandomGraph(denseFileName, numDenseVertices, numDenseEdges);
+    Graph denseGraph;
+    denseGraph.readGraph(denseFileName);
+    DistanceMatrix matrix;
+    start = std::chrono::steady_clock::now();
+    denseGraph.computeAllPairsDistances(matrix, false, false);
+    double scalarAllPairsTime = millisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    denseGraph.computeAllPairsDistances(matrix, false, true);
+    double simdAllPairsTime = millisecondsSince(start);
+    bool simdUsed = matrix.usedSimdKernel();
+    std::vector<std::string> denseSources;
+    for (int i = 0; i < numDenseVertices; i++) {
+        denseSources.push_back("v" + std::to_string(i));
+    }
+    start = std::chrono::steady_clock::now();
+    denseGraph.computeShortestPathsBatch(denseSources, 1);
+    double denseBatchTime = millisecondsSince(start);
+
+    // stream edges into a DAG whose hidden order is a shuffle of the vertices, so most insertions
+    // disagree with the order kept so far, against sorting the whole DAG once
+    const int numDagVertices = 100000;
+    const int numDagEdges = 300000;
+    std::string dagFileName = fileName + ".dag";
+    {
+        std::ofstream dagFile(dagFileName);
+        dagFile << numDagVertices << "\n";
+        for (int i = 0; i < numDagVertices; i++) {
+            dagFile << "v" << i << "\n";
+        }
+        dagFile << 0 << "\n";
+    }
+    Graph dagGraph;
+    dagGraph.readGraph(dagFileName);
+    std::vector<int> hiddenOrder(numDagVertices);
+    for (int i = 0; i < numDagVertices; i++) {
+        hiddenOrder[i] = i;
+    }
+    std::mt19937 dagGenerator(279);
+    std::shuffle(hiddenOrder.begin(), hiddenOrder.end(), dagGenerator);
+    std::uniform_int_distribution<int> rankDistribution(0, numDagVertices - 2);
+    std::vector<std::string> dagFromNames, dagToNames;
+    for (int i = 0; i < numDagEdges; i++) {
+        int fromRank = rankDistribution(dagGenerator);
+        int toRank = fromRank + 1 + (int)(dagGenerator() % (numDagVertices - 1 - fromRank));
+        dagFromNames.push_back("v" + std::to_string(hiddenOrder[fromRank]));
+        dagToNames.push_back("v" + std::to_string(hiddenOrder[toRank]));
+    }
+    std::vector<int> cycleVertexIndices;
+    int numRejectedEdges = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numDagEdges; i++) {
+        numRejectedEdges += !dagGraph.addEdgeKeepingOrder(dagFromNames[i], dagToNames[i], 1, cycleVertexIndices);
+    }
+    double dynamicOrderTime = millisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    dagGraph.topologicalSort();
+    double dagSortTime = millisecondsSince(start);
+    std::cout.rdbuf(consoleBuffer);
+
+    for (int engine = 0; engine < numEngines; engine++) {
+        std::cout << "computeShortestPaths (" << engineNames[engine] << "): " << shortestPathsTimes[engine]
+            << " ms, peak memory +" << shortestPathsMemory[engine] << " MB" << std::endl;
+    }
+    std::cout << "computeShortestPaths (cached): " << cachedShortestPathsTime << " ms, " << graph.getShortestPathCacheHits()
+        << " hits, " << graph.getShortestPathCacheMisses() << " misses" << std::endl;
+    std::cout << "computeShortestPathsBatch (" << numBatchSources << " sources): " << serialBatchTime << " ms on 1 thread, "
+        << parallelBatchTime << " ms on " << batchThreads << " threads (" << serialBatchTime / parallelBatchTime << "x)" << std::endl;
+    std::cout << "computeAllPairsDistances (" << numDenseVertices << " vertices, " << numDenseEdges << " edges): "
+        << scalarAllPairsTime << " ms scalar, " << simdAllPairsTime << " ms " << (simdUsed ? "AVX2" : "scalar (no AVX2)")
+        << ", vs computeShortestPathsBatch from every vertex on 1 thread: " << denseBatchTime << " ms" << std::endl;
+    std::cout << "computeTopologicalSort: " << topologicalSortTime << " ms" << std::endl;
+    std::cout << "addEdgeKeepingOrder (" << numDagEdges << " edges into " << numDagVertices << " vertices, " << numRejectedEdges
+        << " rejected): " << 1000.0 * dynamicOrderTime / numDagEdges << " us per edge, vs topologicalSort of the final DAG: "
+        << dagSortTime << " ms per sort" << std::endl;
+    std::cout << "printGraph: " << printGraphTime << " ms" << std::endl;
+    std::cout << "computeMinimumSpanningTree: " << spanningTreeTime << " ms, of which " << spanningTreeComputeTime
+        << " ms computing it" << std::endl;
+    std::cout << "minimumSpanningTree (Boruvka): " << serialBoruvkaTime << " ms on 1 thread, " << parallelBoruvkaTime << " ms on "
+        << batchThreads << " threads" << std::endl;
+    for (int density = 0; density < numCrossoverDensities; density++) {
+        std::cout << "minimumSpanningTree (" << numCrossoverVertices << " vertices, " << crossoverDegrees[density]
+            << " edges per vertex): Kruskal " << kruskalTimes[density] << " ms, Prim " << primTimes[density] << " ms" << std::endl;
+    }
+    std::cout << "buildDynamicSpanningTree: " << dynamicTreeBuildTime << " ms, then " << numTreeUpdates << " edits: "
+        << 1000.0 * dynamicTreeUpdateTime / numTreeUpdates << " us per edit, " << dynamicTreeCopyTime
+        << " ms to copy the tree out, vs minimumSpanningTree after an edit: " << recomputedTreeTime << " ms ("
+        << (dynamicTreeMatches ? "same tree" : "DIFFERENT TREE") << ")" << std::endl;
+    for (int load = 0; load < numSymmetricLoads; load++) {
+        std::cout << "readGraph (" << 2 * (numEdges / 2) << " edges listed both ways, " << symmetricDirectionNames[load] << "): "
+            << symmetricEdgesStored[load] << " edges stored, " << symmetricLoadTimes[load] << " ms, resident +"
+            << symmetricLoadMemory[load] << " MB, minimumSpanningTree " << symmetricSpanningTreeTimes[load] << " ms" << std::endl;
+    }
+}
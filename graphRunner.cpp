@@ -1,156 +1,371 @@
-//IT 279 F2020 - Nick Dunne and Alex Lerch
-//Short program to handle the menu interface to the Graph class
-#include "Graph.h"
-#include "TextMenu.h"
-#include <iostream>
-#include <string>
-
-//Prints a short welcome message to the user
-void printWelcomeMessage();
-
-//Executes the program with the given menu and graph
-void handleMenu(TextMenu &menu, Graph &graph);
-
-//Input the file into the graph for the user
-void readFileIntoGraph(Graph &graph);
-
-//Asks the user to input a file name for a graph, and returns that input to the user
-string promptFileName();
-
-//Asks the user for the node to get shortest paths from, and returns the input to the user
-string promptShortestPathsNode();
-
-const int QUIT_CHOICE = 6;
-
-int main()
-{
-    //Create menu object to use as program input later
-    TextMenu menu = TextMenu();
-
-    //Create options to put in the menu
-    string menuChoices[6] = {
-        /*1*/ "Read in a new graph",
-        /*2*/ "Print out the graph",
-        /*3*/ "Topological Sort",
-        /*4*/ "Shortest Path (from a node of your choice to all other nodes)",
-        /*5*/ "Minimum Spanning Tree",
-        /*6*/ "Exit the program"};
-
-    //Add the menu choices to the TextMenu
-    menu.setUp(6, menuChoices);
-
-    //Create graph object to use later
-    Graph graph = Graph();
-
-    //Print welcome message
-    printWelcomeMessage();
-
-    //Start the menu
-    handleMenu(menu, graph);
-
-    return 0;
-}
-
-void printWelcomeMessage()
-{
-    //Short welcome message to display to users
-    cout << "Welcome to Program 5 - Working with Graph Algorithms." << endl;
-}
-
-void handleMenu(TextMenu &menu, Graph &graph)
-{
-
-    //Read a user-provided file into the Graph class
-    readFileIntoGraph(graph);
-
-    //String value to keep the node for the shortest path
-    string node;
-    // get first menu choice from user
-    int menuChoice = menu.getChoice();
-
-    while (menuChoice != QUIT_CHOICE)
-    {
-        switch (menuChoice)
-        {
-        case 1:
-            //Read in another graph here
-            readFileIntoGraph(graph);
-            break;
-        case 2:
-            //Print out the graph that is in the file
-            graph.printGraph();
-            break;
-        case 3:
-            //Call topological sort
-            graph.computeTopologicalSort();
-            break;
-        case 4:
-            //Retrieve input from user to ask for a node
-            node = promptShortestPathsNode();
-
-            //Call shortest paths
-            graph.computeShortestPaths(node);
-            break;
-        case 5:
-            //Call minimum spanning tree
-            graph.computeMinimumSpanningTree();
-            break;
-        }
-        menuChoice = menu.getChoice();
-    }
-}
-
-void readFileIntoGraph(Graph &graph)
-{
-    //Get file name from user
-    string fileName = promptFileName();
-
-    //Attempt to read in the file
-    bool fileReadSuccessfully;
-    fileReadSuccessfully = graph.readGraph(fileName);
-
-    //If the read doesn't work, keep asking for a file until it does.
-    while (!fileReadSuccessfully)
-    {
-        //Provide error message and new prompt to the user
-        cout << "That input file does not exist, please try again with an existing input file." << endl;
-        fileName = promptFileName();
-
-        //Attempt to read the file in again
-        fileReadSuccessfully = graph.readGraph(fileName);
-    }
-}
-
-/*
-    ########## You shouldn't need to change anything below this line ##########
-*/
-
-string promptFileName()
-{
-    //String to store the file name
-    string fileName;
-
-    //Generate the prompt for the user
-    cout << "Please enter the name of a text file to retrieve your graph from: " << flush;
-
-    //Input retrieved from user
-    getline(cin, fileName);
-
-    //Return the file name to the calling method (the menu method)
-    return fileName;
-}
-
-string promptShortestPathsNode()
-{
-    //String to store the node name given by the user
-    string node;
-
-    //Generate the prompt for the user
-    cout << "Please type the name of a node to get shortest paths for: " << flush;
-
-    //Input retrieved from the user
-    getline(cin, node);
-
-    //Return the typed in selection made by the user
-    return node;
+//IT 279 F2020 - Nick Dunne and Alex Lerch
+//Short program to handle the menu interface to the Graph class
+#include "Graph.h"
+#include "TextMenu.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+//Prints a short welcome message to the user
+void printWelcomeMessage();
+
+//Executes the program with the given menu and graph
+void handleMenu(TextMenu &menu, Graph &graph);
+
+//Input the file into the graph for the user
+void readFileIntoGraph(Graph &graph);
+
+//Asks the user to input a file name for a graph, and returns that input to the user
+string promptFileName();
+
+//Asks the user for the node to get shortest paths from, and returns the input to the user
+string promptShortestPathsNode();
+
+//Converts a text graph file into a binary snapshot, with landmark tables if numLandmarks is above 0,
+//and returns the exit status for main
+int convertToSnapshot(string textFileName, string snapshotFileName, int numLandmarks);
+
+//Prints one shortest path between two nodes of a graph file, and returns the exit status for main
+int printPointToPointPath(string graphFileName, string sourceNode, string targetNode, Graph::PathQueryMode mode);
+
+//Computes the distances between every pair of vertices of a graph file and writes them to a binary matrix file,
+//with what is needed to rebuild the paths if keepPaths is true, and returns the exit status for main
+int writeAllPairsMatrix(string graphFileName, string matrixFileName, bool keepPaths);
+
+//Prints the topological levels of a graph file, and returns the exit status for main
+int printTopologicalLevels(string graphFileName);
+
+//Prints the strongly connected components of a graph file in topological order, and returns the exit status for main
+int printComponents(string graphFileName);
+
+const int QUIT_CHOICE = 6;
+
+//The number of landmarks --alt builds when the graph file has none stored with it
+const int DEFAULT_NUM_LANDMARKS = 16;
+
+int main(int argc, char *argv[])
+{
+    //Convert a text graph into a snapshot when asked on the command line:
+    //  graphRunner --convert <text graph file> <snapshot file> [--landmarks <count>]
+    //Print the shortest path between two nodes when asked on the command line:
+    //  graphRunner --path <graph file> <from node> <to node> [--bidirectional | --alt | --ch]
+    //Run the menu reading every edge as going both ways, each stored once:
+    //  graphRunner --undirected
+    bool undirected = (argc == 2 && string(argv[1]) == "--undirected");
+    if (argc == 4 && string(argv[1]) == "--convert")
+    {
+        return convertToSnapshot(argv[2], argv[3], 0);
+    }
+    else if (argc == 6 && string(argv[1]) == "--convert" && string(argv[4]) == "--landmarks" && atoi(argv[5]) > 0)
+    {
+        return convertToSnapshot(argv[2], argv[3], atoi(argv[5]));
+    }
+    else if (argc == 5 && string(argv[1]) == "--path")
+    {
+        return printPointToPointPath(argv[2], argv[3], argv[4], Graph::UNIDIRECTIONAL);
+    }
+    else if (argc == 6 && string(argv[1]) == "--path" && string(argv[5]) == "--bidirectional")
+    {
+        return printPointToPointPath(argv[2], argv[3], argv[4], Graph::BIDIRECTIONAL);
+    }
+    else if (argc == 6 && string(argv[1]) == "--path" && string(argv[5]) == "--alt")
+    {
+        return printPointToPointPath(argv[2], argv[3], argv[4], Graph::LANDMARKS);
+    }
+    else if (argc == 6 && string(argv[1]) == "--path" && string(argv[5]) == "--ch")
+    {
+        return printPointToPointPath(argv[2], argv[3], argv[4], Graph::CONTRACTION_HIERARCHY);
+    }
+    else if (argc == 4 && string(argv[1]) == "--all-pairs")
+    {
+        return writeAllPairsMatrix(argv[2], argv[3], false);
+    }
+    else if (argc == 5 && string(argv[1]) == "--all-pairs" && string(argv[4]) == "--paths")
+    {
+        return writeAllPairsMatrix(argv[2], argv[3], true);
+    }
+    else if (argc == 3 && string(argv[1]) == "--levels")
+    {
+        return printTopologicalLevels(argv[2]);
+    }
+    else if (argc == 3 && string(argv[1]) == "--components")
+    {
+        return printComponents(argv[2]);
+    }
+    else if (argc != 1 && !undirected)
+    {
+        cerr << "usage: " << argv[0] << " [--convert <text graph file> <snapshot file> [--landmarks <count>]]" << endl;
+        cerr << "       " << argv[0] << " [--path <graph file> <from node> <to node> [--bidirectional | --alt | --ch]]" << endl;
+        cerr << "       " << argv[0] << " [--all-pairs <graph file> <matrix file> [--paths]]" << endl;
+        cerr << "       " << argv[0] << " [--levels <graph file>]" << endl;
+        cerr << "       " << argv[0] << " [--components <graph file>]" << endl;
+        cerr << "       " << argv[0] << " [--undirected]" << endl;
+        return 1;
+    }
+
+    //Create menu object to use as program input later
+    TextMenu menu = TextMenu();
+
+    //Create options to put in the menu
+    string menuChoices[6] = {
+        /*1*/ "Read in a new graph",
+        /*2*/ "Print out the graph",
+        /*3*/ "Topological Sort",
+        /*4*/ "Shortest Path (from a node of your choice to all other nodes)",
+        /*5*/ "Minimum Spanning Tree",
+        /*6*/ "Exit the program"};
+
+    //Add the menu choices to the TextMenu
+    menu.setUp(6, menuChoices);
+
+    //Create graph object to use later
+    Graph graph = Graph();
+    if (undirected)
+    {
+        graph.setLoadDirection(Graph::UNDIRECTED);
+    }
+
+    //Print welcome message
+    printWelcomeMessage();
+
+    //Start the menu
+    handleMenu(menu, graph);
+
+    return 0;
+}
+
+void printWelcomeMessage()
+{
+    //Short welcome message to display to users
+    cout << "Welcome to Program 5 - Working with Graph Algorithms." << endl;
+}
+
+void handleMenu(TextMenu &menu, Graph &graph)
+{
+
+    //Read a user-provided file into the Graph class
+    readFileIntoGraph(graph);
+
+    //String value to keep the node for the shortest path
+    string node;
+    // get first menu choice from user
+    int menuChoice = menu.getChoice();
+
+    while (menuChoice != QUIT_CHOICE)
+    {
+        switch (menuChoice)
+        {
+        case 1:
+            //Read in another graph here
+            readFileIntoGraph(graph);
+            break;
+        case 2:
+            //Print out the graph that is in the file
+            graph.printGraph();
+            break;
+        case 3:
+            //Call topological sort
+            graph.computeTopologicalSort();
+            break;
+        case 4:
+            //Retrieve input from user to ask for a node
+            node = promptShortestPathsNode();
+
+            //Call shortest paths
+            graph.computeShortestPaths(node);
+            break;
+        case 5:
+            //Call minimum spanning tree
+            graph.computeMinimumSpanningTree();
+            break;
+        }
+        menuChoice = menu.getChoice();
+    }
+}
+
+void readFileIntoGraph(Graph &graph)
+{
+    //Get file name from user
+    string fileName = promptFileName();
+
+    //Attempt to read in the file
+    bool fileReadSuccessfully;
+    fileReadSuccessfully = graph.readGraph(fileName);
+
+    //If the read doesn't work, keep asking for a file until it does.
+    while (!fileReadSuccessfully)
+    {
+        //Provide error message and new prompt to the user
+        cout << "That input file does not exist or is not a valid graph file, please try again with another input file." << endl;
+        fileName = promptFileName();
+
+        //Attempt to read the file in again
+        fileReadSuccessfully = graph.readGraph(fileName);
+    }
+}
+
+int convertToSnapshot(string textFileName, string snapshotFileName, int numLandmarks)
+{
+    Graph graph;
+
+    //Read the text graph
+    if (!graph.readGraph(textFileName))
+    {
+        cerr << "Could not read a graph from " << textFileName << endl;
+        return 1;
+    }
+
+    //Build the landmark tables so they are stored with the snapshot
+    if (numLandmarks > 0 && !graph.buildLandmarks(numLandmarks))
+    {
+        cerr << "Could not build landmarks for " << textFileName << ", which needs vertices and no negative costs" << endl;
+        return 1;
+    }
+
+    //Write it back out as a snapshot, which readGraph and option 1 of the menu also accept
+    if (!graph.saveSnapshot(snapshotFileName))
+    {
+        cerr << "Could not write the snapshot " << snapshotFileName << endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int printPointToPointPath(string graphFileName, string sourceNode, string targetNode, Graph::PathQueryMode mode)
+{
+    Graph graph;
+
+    //Read the graph, which may be a text graph or a snapshot
+    if (!graph.readGraph(graphFileName))
+    {
+        cerr << "Could not read a graph from " << graphFileName << endl;
+        return 1;
+    }
+
+    //A* needs landmarks; a snapshot may already have them, otherwise build them now
+    if (mode == Graph::LANDMARKS && graph.getNumLandmarks() == 0)
+    {
+        graph.buildLandmarks(DEFAULT_NUM_LANDMARKS);
+    }
+
+    //A contraction hierarchy is not kept in snapshots, so contract the graph first
+    if (mode == Graph::CONTRACTION_HIERARCHY)
+    {
+        graph.buildContractionHierarchy();
+    }
+
+    //Find the path the way asked
+    Graph::PointToPointPath path = graph.shortestPath(sourceNode, targetNode, mode);
+    if (!path.found)
+    {
+        cout << "No path from " << sourceNode << " to " << targetNode << " found." << endl;
+        return 1;
+    }
+
+    //Print the path the same way the shortest paths menu option does
+    for (size_t i = 0; i < path.vertexNames.size(); i++)
+    {
+        cout << path.vertexNames[i] << (i + 1 < path.vertexNames.size() ? " --> " : "");
+    }
+    cout << " || Weight: " << path.totalDistance << endl;
+    cout << "Vertices settled: " << path.numSettledVertices << endl;
+    return 0;
+}
+
+int writeAllPairsMatrix(string graphFileName, string matrixFileName, bool keepPaths)
+{
+    Graph graph;
+
+    //Read the graph, which may be a text graph or a snapshot
+    if (!graph.readGraph(graphFileName))
+    {
+        cerr << "Could not read a graph from " << graphFileName << endl;
+        return 1;
+    }
+
+    //Run Floyd-Warshall over the whole graph
+    DistanceMatrix matrix;
+    if (!graph.computeAllPairsDistances(matrix, keepPaths))
+    {
+        cerr << "Could not compute the distances of " << graphFileName << ", which has a negative cycle or costs too large" << endl;
+        return 1;
+    }
+
+    //Write the matrix out in its binary form
+    if (!matrix.save(matrixFileName))
+    {
+        cerr << "Could not write the matrix " << matrixFileName << endl;
+        return 1;
+    }
+
+    cout << "Wrote the distances between " << matrix.size() << " vertices" << (matrix.usedSimdKernel() ? " using AVX2" : "") << endl;
+    return 0;
+}
+
+int printTopologicalLevels(string graphFileName)
+{
+    Graph graph;
+
+    //Read the graph, which may be a text graph or a snapshot
+    if (!graph.readGraph(graphFileName))
+    {
+        cerr << "Could not read a graph from " << graphFileName << endl;
+        return 1;
+    }
+
+    //Sort the graph level by level so the vertices of each level can be scheduled together
+    Graph::TopologicalOrder order = graph.topologicalSortByLevels();
+    graph.printTopologicalLevels(order);
+    return order.sorted ? 0 : 1;
+}
+
+int printComponents(string graphFileName)
+{
+    Graph graph;
+
+    //Read the graph, which may be a text graph or a snapshot
+    if (!graph.readGraph(graphFileName))
+    {
+        cerr << "Could not read a graph from " << graphFileName << endl;
+        return 1;
+    }
+
+    //Shrink each cycle to one component so the components can be ordered even when the graph cannot
+    graph.printCondensation(graph.condensation());
+    return 0;
+}
+
+/*
+    ########## You shouldn't need to change anything below this line ##########
+*/
+
+string promptFileName()
+{
+    //String to store the file name
+    string fileName;
+
+    //Generate the prompt for the user
+    cout << "Please enter the name of a text file to retrieve your graph from: " << flush;
+
+    //Input retrieved from user
+    getline(cin, fileName);
+
+    //Return the file name to the calling method (the menu method)
+    return fileName;
+}
+
+string promptShortestPathsNode()
+{
+    //String to store the node name given by the user
+    string node;
+
+    //Generate the prompt for the user
+    cout << "Please type the name of a node to get shortest paths for: " << flush;
+
+    //Input retrieved from the user
+    getline(cin, node);
+
+    //Return the typed in selection made by the user
+    return node;
 }
\ No newline at end of file